@@ -1,10 +1,26 @@
+#include <AssetArchive.hpp>
 #include <AssetParser.hpp>
+#include <BakeManifest.hpp>
+#include <MappedFile.hpp>
+#include <MeshAsset.hpp>
 #include <TextureAsset.hpp>
+#include <TextureCompression.hpp>
+#include <TextureMips.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
+#include <string_view>
+#include <thread>
 
-#define STB_IMAGE_IMPLEMENTATION
+// stb_image's implementation comes with tinygltf's
 #include <stb_image.h>
+#include <tiny_gltf.h>
 
 #define ASSERT(x, ...) \
 	if (!(x))            \
@@ -14,22 +30,173 @@
 	}
 
 
+static std::mutex log_mutex;
+
 template<typename... Args>
 void log(Args&&... args)
 {
+	std::scoped_lock lock(log_mutex);
+
 	(std::cout << ... << args);
 	std::cout << '\n';
 }
 
+/** Codec & level every baked blob is compressed with */
+struct CompressionSettings
+{
+	Assets::CompressionMode mode = Assets::CompressionMode::LZ4HC;
+	int level                    = 0;
+};
+
+/** Parses the optional --codec=<none|lz4|lz4hc|zstd>, --level=<n> & vertex encoding arguments */
+bool parse_bake_settings(
+  int argc,
+  char* argv[],
+  CompressionSettings& settings,
+  Assets::VertexEncoding& vertex_encoding
+)
+{
+	for (int i = 3; i < argc; ++i)
+	{
+		const std::string_view argument = argv[i];
+
+		if (argument == "--vertices=compact")
+		{
+			vertex_encoding = Assets::compact_vertex_encoding;
+		}
+		else if (argument == "--positions=float")
+		{
+			vertex_encoding.position = Assets::PositionEncoding::Float;
+		}
+		else if (argument == "--positions=half")
+		{
+			vertex_encoding.position = Assets::PositionEncoding::Half;
+		}
+		else if (argument == "--positions=unorm16")
+		{
+			vertex_encoding.position = Assets::PositionEncoding::Unorm16;
+		}
+		else if (argument == "--directions=float")
+		{
+			vertex_encoding.direction = Assets::DirectionEncoding::Float;
+		}
+		else if (argument == "--directions=oct16")
+		{
+			vertex_encoding.direction = Assets::DirectionEncoding::OctahedralSnorm16;
+		}
+		else if (argument == "--directions=oct8")
+		{
+			vertex_encoding.direction = Assets::DirectionEncoding::OctahedralSnorm8;
+		}
+		else if (argument == "--uvs=float")
+		{
+			vertex_encoding.uv = Assets::UvEncoding::Float;
+		}
+		else if (argument == "--uvs=half")
+		{
+			vertex_encoding.uv = Assets::UvEncoding::Half;
+		}
+		else if (argument.starts_with("--level="))
+		{
+			settings.level = std::atoi(argument.substr(8).data());
+		}
+		else if (argument == "--codec=none")
+		{
+			settings.mode = Assets::CompressionMode::None;
+		}
+		else if (argument == "--codec=lz4")
+		{
+			settings.mode = Assets::CompressionMode::LZ4;
+		}
+		else if (argument == "--codec=lz4hc")
+		{
+			settings.mode = Assets::CompressionMode::LZ4HC;
+		}
+		else if (argument == "--codec=zstd")
+		{
+			settings.mode = Assets::CompressionMode::ZSTD;
+		}
+		else
+		{
+			log("Unknown argument -> ", argument);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool is_normal_map(const std::filesystem::path& path)
+{
+	std::string stem = path.stem().string();
+	std::transform(stem.begin(), stem.end(), stem.begin(), ::tolower);
+
+	return stem.find("normal") != std::string::npos || stem.ends_with("_n");
+}
+
+/** Normal maps go to BC5 (tangent-space z is reconstructed in the shader),
+ * opaque color to BC1 and color with an alpha channel to BC7 */
+Assets::TextureFormat select_texture_format(
+  const std::filesystem::path& path,
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height
+)
+{
+	if (is_normal_map(path))
+		return Assets::TextureFormat::BC5;
+
+	for (size_t i = 0; i < size_t(width) * height; ++i)
+		if (pixels[i * 4 + 3] != 255u)
+			return Assets::TextureFormat::BC7;
+
+	return Assets::TextureFormat::BC1;
+}
+
+/** Block-compresses each level of a tightly packed RGBA8 mip chain in place */
+void compress_mip_chain(
+  Assets::TextureFormat format,
+  uint32_t width,
+  uint32_t height,
+  std::vector<uint8_t>& mip_chain,
+  std::vector<size_t>& mip_sizes
+)
+{
+	std::vector<uint8_t> compressed_chain;
+	size_t offset = 0ull;
+
+	for (size_t& mip_size : mip_sizes)
+	{
+		const std::vector<uint8_t> blocks = Assets::compress_level(
+		  format,
+		  mip_chain.data() + offset,
+		  width,
+		  height
+		);
+
+		offset += mip_size;
+		mip_size = blocks.size();
+		compressed_chain.insert(compressed_chain.end(), blocks.begin(), blocks.end());
+
+		width  = std::max(width / 2u, 1u);
+		height = std::max(height / 2u, 1u);
+	}
+
+	mip_chain = std::move(compressed_chain);
+}
+
 bool convert_image(
   const std::filesystem::path& input,
-  const std::filesystem::path& output
+  const Assets::MappedFile& input_file,
+  const std::filesystem::path& output,
+  const CompressionSettings& compression
 )
 {
 	int width, height, channels;
 
-	stbi_uc* pixels = stbi_load(
-	  input.string().c_str(),
+	stbi_uc* pixels = stbi_load_from_memory(
+	  input_file.data(),
+	  (int)input_file.size(),
 	  &width,
 	  &height,
 	  &channels,
@@ -39,54 +206,857 @@ bool convert_image(
 	if (!pixels)
 		return false;
 
+	const Assets::TextureFormat format = select_texture_format(
+	  input,
+	  pixels,
+	  width,
+	  height
+	);
+
+	std::vector<size_t> mip_sizes;
+	std::vector<uint8_t> mip_chain = Assets::generate_mip_chain(
+	  pixels,
+	  width,
+	  height,
+	  format != Assets::TextureFormat::BC5,
+	  mip_sizes
+	);
+
+	stbi_image_free(pixels);
+
+	compress_mip_chain(format, width, height, mip_chain, mip_sizes);
+
 	Assets::TextureInfo texInfo {
-		.size       = static_cast<size_t>(width * height * 4),
-		.format     = Assets::TextureFormat::RGBA8,
+		.size             = mip_chain.size(),
+		.compression_mode = compression.mode,
+		.format           = format,
 		.pixel_size = {
 		    static_cast<uint32_t>(width),
 		    static_cast<uint32_t>(height),
 		    0ul,
 		},
-		.original_file = input.string(),
+		.original_file     = input.string(),
+		.mip_levels        = static_cast<uint32_t>(mip_sizes.size()),
+		.mip_sizes         = mip_sizes,
+		.compression_level = compression.level,
 	};
 
-	Assets::AssetFile file = Assets::pack_texture(&texInfo, pixels);
+	Assets::AssetFile file = Assets::pack_texture(&texInfo, mip_chain.data());
 
-	stbi_image_free(pixels);
+	Assets::save_binary_file(output.string().c_str(), file);
+
+	return true;
+}
+
+/** Element @a index of a vertex attribute, the stride is the accessor's element
+ * size unless the buffer view has one */
+struct AttributeStream
+{
+	const uint8_t* data;
+	size_t stride;
+
+	void read(size_t index, float* out, size_t component_count) const
+	{
+		memcpy(out, data + index * stride, component_count * sizeof(float));
+	}
+};
+
+/** @returns A stream with null data if the attribute is missing or isn't made of floats */
+AttributeStream get_attribute_stream(
+  const tinygltf::Model& gltf_model,
+  const tinygltf::Primitive& primitive,
+  const char* name
+)
+{
+	const auto it = primitive.attributes.find(name);
+	if (it == primitive.attributes.end())
+		return {};
+
+	const tinygltf::Accessor& accessor = gltf_model.accessors[it->second];
+	if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.bufferView < 0)
+		return {};
+
+	const tinygltf::BufferView& view = gltf_model.bufferViews[accessor.bufferView];
+	const tinygltf::Buffer& buffer   = gltf_model.buffers[view.buffer];
+
+	// Falls back to the element size when the view is tightly packed, which is a vec4 for
+	// tangents even though only their xyz is read
+	const int stride = accessor.ByteStride(view);
+	if (stride <= 0)
+		return {};
+
+	return {
+		buffer.data.data() + view.byteOffset + accessor.byteOffset,
+		(size_t)stride,
+	};
+}
+
+/** Column major local transform of @a node, from its matrix or its TRS */
+void get_node_transform(const tinygltf::Node& node, float* transform)
+{
+	if (node.matrix.size() == 16u)
+	{
+		std::copy(node.matrix.begin(), node.matrix.end(), transform);
+		return;
+	}
+
+	const double t[3] = {
+		node.translation.size() == 3u ? node.translation[0] : 0.0,
+		node.translation.size() == 3u ? node.translation[1] : 0.0,
+		node.translation.size() == 3u ? node.translation[2] : 0.0,
+	};
+
+	const double s[3] = {
+		node.scale.size() == 3u ? node.scale[0] : 1.0,
+		node.scale.size() == 3u ? node.scale[1] : 1.0,
+		node.scale.size() == 3u ? node.scale[2] : 1.0,
+	};
+
+	const bool has_rotation = node.rotation.size() == 4u;
+	const double x = has_rotation ? node.rotation[0] : 0.0;
+	const double y = has_rotation ? node.rotation[1] : 0.0;
+	const double z = has_rotation ? node.rotation[2] : 0.0;
+	const double w = has_rotation ? node.rotation[3] : 1.0;
+
+	const double matrix[16] = {
+		(1.0 - 2.0 * (y * y + z * z)) * s[0],
+		(2.0 * (x * y + z * w)) * s[0],
+		(2.0 * (x * z - y * w)) * s[0],
+		0.0,
+
+		(2.0 * (x * y - z * w)) * s[1],
+		(1.0 - 2.0 * (x * x + z * z)) * s[1],
+		(2.0 * (y * z + x * w)) * s[1],
+		0.0,
+
+		(2.0 * (x * z + y * w)) * s[2],
+		(2.0 * (y * z - x * w)) * s[2],
+		(1.0 - 2.0 * (x * x + y * y)) * s[2],
+		0.0,
+
+		t[0],
+		t[1],
+		t[2],
+		1.0,
+	};
+
+	std::copy(matrix, matrix + 16, transform);
+}
+
+/** Appends a triangle list primitive's vertices & indices, laid out the way
+ * BindlessVk's GltfLoader lays them out at runtime */
+bool bake_primitive(
+  const tinygltf::Model& gltf_model,
+  const tinygltf::Primitive& primitive,
+  std::vector<Assets::MeshVertex>& vertices,
+  std::vector<uint32_t>& indices,
+  Assets::MeshPrimitive& out_primitive
+)
+{
+	if (primitive.mode != -1 && primitive.mode != TINYGLTF_MODE_TRIANGLES)
+		return false;
+
+	const auto position_it = primitive.attributes.find("POSITION");
+	if (position_it == primitive.attributes.end())
+		return false;
+
+	const size_t vertex_count = gltf_model.accessors[position_it->second].count;
+	const uint32_t first_vertex = vertices.size();
+
+	const AttributeStream positions = get_attribute_stream(gltf_model, primitive, "POSITION");
+	const AttributeStream normals   = get_attribute_stream(gltf_model, primitive, "NORMAL");
+	const AttributeStream tangents  = get_attribute_stream(gltf_model, primitive, "TANGENT");
+	const AttributeStream uvs       = get_attribute_stream(gltf_model, primitive, "TEXCOORD_0");
+
+	if (!positions.data)
+		return false;
+
+	for (size_t v = 0; v < vertex_count; ++v)
+	{
+		Assets::MeshVertex vertex = {};
+		positions.read(v, vertex.position, 3u);
+
+		if (normals.data)
+			normals.read(v, vertex.normal, 3u);
+
+		if (uvs.data)
+			uvs.read(v, vertex.uv, 2u);
+
+		if (tangents.data)
+		{
+			tangents.read(v, vertex.tangent, 3u);
+
+			const float* t        = vertex.tangent;
+			const float magnitude = std::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+			if (magnitude > 0.0f)
+				for (float& component : vertex.tangent)
+					component /= magnitude;
+		}
+
+		vertices.push_back(vertex);
+	}
+
+	out_primitive.first_index    = indices.size();
+	out_primitive.material_index = primitive.material;
+
+	// Non-indexed primitives get sequential indices
+	if (primitive.indices < 0)
+	{
+		for (uint32_t v = 0; v < vertex_count; ++v)
+			indices.push_back(first_vertex + v);
+
+		out_primitive.index_count = vertex_count;
+		return true;
+	}
+
+	const tinygltf::Accessor& accessor = gltf_model.accessors[primitive.indices];
+	const tinygltf::BufferView& view   = gltf_model.bufferViews[accessor.bufferView];
+	const uint8_t* data                = gltf_model.buffers[view.buffer].data.data() + view.byteOffset
+	                      + accessor.byteOffset;
+
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		uint32_t index;
+		switch (accessor.componentType)
+		{
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: memcpy(&index, data + i * 4u, 4u); break;
+
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+		{
+			uint16_t short_index;
+			memcpy(&short_index, data + i * 2u, 2u);
+			index = short_index;
+			break;
+		}
+
+		case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: index = data[i]; break;
+
+		default: return false;
+		}
+
+		indices.push_back(first_vertex + index);
+	}
+
+	out_primitive.index_count = accessor.count;
+	return true;
+}
+
+/** Bakes a node & its subtree, parents are baked before their children */
+bool bake_node(
+  const tinygltf::Model& gltf_model,
+  int node_index,
+  int32_t parent_index,
+  Assets::MeshInfo& info,
+  std::vector<Assets::MeshVertex>& vertices,
+  std::vector<uint32_t>& indices
+)
+{
+	const tinygltf::Node& gltf_node = gltf_model.nodes[node_index];
+	const int32_t baked_index       = info.nodes.size();
+
+	Assets::MeshNode node = {};
+	node.parent           = parent_index;
+	get_node_transform(gltf_node, node.transform);
+
+	if (gltf_node.mesh >= 0)
+	{
+		for (const tinygltf::Primitive& gltf_primitive : gltf_model.meshes[gltf_node.mesh].primitives)
+		{
+			Assets::MeshPrimitive primitive;
+			if (!bake_primitive(gltf_model, gltf_primitive, vertices, indices, primitive))
+				return false;
+
+			node.primitives.push_back(primitive);
+		}
+	}
+
+	info.nodes.push_back(std::move(node));
+
+	for (const int child_index : gltf_node.children)
+		if (!bake_node(gltf_model, child_index, baked_index, info, vertices, indices))
+			return false;
+
+	return true;
+}
+
+/** Images aren't decoded, baked meshes only reference their baked textures */
+bool skip_image_loading(
+  tinygltf::Image*,
+  const int,
+  std::string*,
+  std::string*,
+  int,
+  int,
+  const unsigned char*,
+  int,
+  void*
+)
+{
+	return true;
+}
+
+bool load_gltf(
+  const std::filesystem::path& input,
+  const Assets::MappedFile& input_file,
+  tinygltf::Model& gltf_model
+)
+{
+	tinygltf::TinyGLTF gltf_context;
+	std::string err, warn;
+
+	gltf_context.SetImageLoader(&skip_image_loading, nullptr);
+
+	const bool is_loaded = input.extension() == ".glb"
+	                         ? gltf_context.LoadBinaryFromMemory(
+	                             &gltf_model,
+	                             &err,
+	                             &warn,
+	                             input_file.data(),
+	                             input_file.size(),
+	                             input.parent_path().string()
+	                           )
+	                         : gltf_context.LoadASCIIFromString(
+	                             &gltf_model,
+	                             &err,
+	                             &warn,
+	                             (const char*)input_file.data(),
+	                             input_file.size(),
+	                             input.parent_path().string()
+	                           );
+
+	if (!is_loaded)
+		log("Failed to load gltf -> ", input, ": ", err);
+
+	return is_loaded;
+}
+
+/** Encodes the baked vertices, positions first & the rest of the attributes
+ * after them, & logs how far the encoding moved them, so lossy encodings can
+ * be checked against the mesh's scale & texel density */
+std::vector<uint8_t> encode_vertices(
+  const std::filesystem::path& input,
+  const Assets::MeshInfo& info,
+  const std::vector<Assets::MeshVertex>& vertices
+)
+{
+	const Assets::VertexLayout layout = Assets::get_vertex_layout(info.vertex_encoding);
+	const uint32_t stride             = layout.position_stride + layout.attribute_stride;
+	const size_t positions_size       = vertices.size() * layout.position_stride;
+
+	std::vector<uint8_t> encoded_vertices(vertices.size() * stride);
+	Assets::encode_vertices(
+	  info.vertex_encoding,
+	  info.bounds,
+	  vertices.data(),
+	  vertices.size(),
+	  encoded_vertices.data(),
+	  encoded_vertices.data() + positions_size
+	);
+
+	if (info.vertex_encoding == Assets::VertexEncoding {})
+		return encoded_vertices;
+
+	const Assets::VertexEncodingError error = Assets::measure_encoding_error(
+	  info.vertex_encoding,
+	  info.bounds,
+	  vertices.data(),
+	  vertices.size(),
+	  encoded_vertices.data(),
+	  encoded_vertices.data() + positions_size
+	);
+
+	log(
+	  "Encoded vertices of ",
+	  input,
+	  " -> ",
+	  stride,
+	  " bytes per vertex (",
+	  sizeof(Assets::MeshVertex),
+	  " at full precision), max error -> position: ",
+	  error.position,
+	  ", normal: ",
+	  error.normal,
+	  " degrees, tangent: ",
+	  error.tangent,
+	  " degrees, uv: ",
+	  error.uv
+	);
+
+	return encoded_vertices;
+}
+
+bool convert_mesh(
+  const std::filesystem::path& input,
+  const tinygltf::Model& gltf_model,
+  const std::filesystem::path& output,
+  const CompressionSettings& compression,
+  const Assets::VertexEncoding& vertex_encoding
+)
+{
+	Assets::MeshInfo info {
+		.vertex_encoding   = vertex_encoding,
+		.compression_mode  = compression.mode,
+		.original_file     = input.string(),
+		.compression_level = compression.level,
+	};
+
+	// Textures are referenced by their baked paths, gltf textures map 1:1 to them
+	for (const tinygltf::Texture& texture : gltf_model.textures)
+	{
+		if (texture.source < 0 || gltf_model.images[texture.source].uri.empty())
+		{
+			log("Embedded images aren't supported -> ", input);
+			return false;
+		}
+
+		std::filesystem::path texture_path = gltf_model.images[texture.source].uri;
+		texture_path.replace_extension(".asset_texture");
+		info.textures.push_back(texture_path.generic_string());
+	}
+
+	for (const tinygltf::Material& material : gltf_model.materials)
+	{
+		info.materials.push_back({
+		  material.pbrMetallicRoughness.baseColorTexture.index,
+		  material.normalTexture.index,
+		  material.pbrMetallicRoughness.metallicRoughnessTexture.index,
+		});
+	}
+
+	std::vector<Assets::MeshVertex> vertices;
+	std::vector<uint32_t> indices;
+
+	const int scene_index = std::max(gltf_model.defaultScene, 0);
+	if (gltf_model.scenes.size() <= scene_index)
+		return false;
+
+	for (const int node_index : gltf_model.scenes[scene_index].nodes)
+		if (!bake_node(gltf_model, node_index, -1, info, vertices, indices))
+			return false;
+
+	info.vertex_count = vertices.size();
+	info.index_count  = indices.size();
+
+	info.bounds = {
+		{ INFINITY, INFINITY, INFINITY },
+		{ -INFINITY, -INFINITY, -INFINITY },
+	};
+
+	for (const Assets::MeshVertex& vertex : vertices)
+	{
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			info.bounds.min[i] = std::min(info.bounds.min[i], vertex.position[i]);
+			info.bounds.max[i] = std::max(info.bounds.max[i], vertex.position[i]);
+		}
+	}
+
+	if (vertices.empty())
+		info.bounds = {};
 
+	// Most meshes have few enough vertices for 16-bit indices, which halves their size. 0xffff
+	// is left unused so it never reads as a primitive restart
+	std::vector<uint16_t> short_indices;
+	if (vertices.size() <= UINT16_MAX)
+	{
+		info.index_size = sizeof(uint16_t);
+		short_indices.assign(indices.begin(), indices.end());
+	}
+	else
+		info.index_size = sizeof(uint32_t);
+
+	// Positions may be quantized against the bounds, so they're encoded last
+	const std::vector<uint8_t> encoded_vertices = encode_vertices(input, info, vertices);
+
+	Assets::AssetFile file = Assets::pack_mesh(
+	  &info,
+	  encoded_vertices.data(),
+	  info.index_size == sizeof(uint16_t) ? (const void*)short_indices.data()
+	                                      : (const void*)indices.data()
+	);
 	Assets::save_binary_file(output.string().c_str(), file);
 
 	return true;
 }
 
+/** Hashes everything besides the input that affects the output, bump
+ * bake_version when the baking itself changes */
+uint64_t hash_settings(
+  const CompressionSettings& compression,
+  const Assets::VertexEncoding& vertex_encoding
+)
+{
+	constexpr uint32_t bake_version = 4u;
+
+	const uint32_t settings[] = {
+		bake_version,
+		(uint32_t)compression.mode,
+		(uint32_t)compression.level,
+		(uint32_t)vertex_encoding.position,
+		(uint32_t)vertex_encoding.direction,
+		(uint32_t)vertex_encoding.uv,
+	};
+
+	return Assets::hash_content(settings, sizeof(settings));
+}
+
+struct BakeJob
+{
+	enum class Type
+	{
+		Texture,
+		Mesh,
+	} type;
+
+	std::filesystem::path input;
+	std::string key; // Input path relative to the input directory
+
+	const Assets::BakeRecord* previous_record;
+	Assets::BakeRecord record;
+
+	enum class Result
+	{
+		Skipped,
+		Baked,
+		Failed,
+	} result;
+};
+
+/** Fills the job's record, except for the input hash
+ *
+ * @returns true if the previous bake's output is still there & was baked with
+ * the same settings
+ */
+bool prepare_record(
+  BakeJob& job,
+  const std::filesystem::path& output,
+  const std::filesystem::path& output_directory,
+  uint64_t settings_hash
+)
+{
+	Assets::BakeRecord& record = job.record;
+	record.input_size          = std::filesystem::file_size(job.input);
+	record.input_write_time    = static_cast<int64_t>(
+	  std::filesystem::last_write_time(job.input).time_since_epoch().count()
+	);
+	record.settings_hash       = settings_hash;
+	record.output              = output.generic_string();
+
+	const Assets::BakeRecord* previous = job.previous_record;
+	return previous && previous->output == record.output
+	       && previous->settings_hash == settings_hash
+	       && std::filesystem::exists(output_directory / output);
+}
+
+void log_bake_time(const BakeJob& job, std::chrono::steady_clock::time_point start_time)
+{
+	const auto duration = std::chrono::duration<double, std::milli>(
+	  std::chrono::steady_clock::now() - start_time
+	);
+
+	log("Baked ", job.key, " in ", duration.count(), "ms");
+}
+
+void bake_texture(
+  BakeJob& job,
+  const std::filesystem::path& output_directory,
+  const CompressionSettings& compression,
+  uint64_t settings_hash
+)
+{
+	const auto start_time = std::chrono::steady_clock::now();
+
+	std::filesystem::path output = job.key;
+	output.replace_extension(".asset_texture");
+
+	Assets::BakeRecord& record         = job.record;
+	const Assets::BakeRecord* previous = job.previous_record;
+	const bool is_output_present = prepare_record(job, output, output_directory, settings_hash);
+
+	// Untouched since the last bake, not even read
+	if (is_output_present && previous->input_size == record.input_size
+	    && previous->input_write_time == record.input_write_time)
+	{
+		record.input_hash = previous->input_hash;
+		job.result        = BakeJob::Result::Skipped;
+		return;
+	}
+
+	Assets::MappedFile input_file;
+	if (!input_file.open(job.input.string().c_str()))
+	{
+		log("Failed to read texture -> ", job.input);
+		job.result = BakeJob::Result::Failed;
+		return;
+	}
+
+	// Touched but with the same content (eg. checked out again)
+	record.input_hash = Assets::hash_content(input_file.data(), input_file.size());
+	if (is_output_present && previous->input_hash == record.input_hash)
+	{
+		job.result = BakeJob::Result::Skipped;
+		return;
+	}
+
+	std::filesystem::create_directories((output_directory / output).parent_path());
+	if (!convert_image(job.input, input_file, output_directory / output, compression))
+	{
+		log("Failed to bake texture -> ", job.input);
+		job.result = BakeJob::Result::Failed;
+		return;
+	}
+
+	log_bake_time(job, start_time);
+	job.result = BakeJob::Result::Baked;
+}
+
+/** Meshes depend on their external buffers too, so they're always loaded & their
+ * hash covers the buffers. Parsing is cheap next to the texture bakes anyway */
+void bake_mesh(
+  BakeJob& job,
+  const std::filesystem::path& output_directory,
+  const CompressionSettings& compression,
+  const Assets::VertexEncoding& vertex_encoding,
+  uint64_t settings_hash
+)
+{
+	const auto start_time = std::chrono::steady_clock::now();
+
+	std::filesystem::path output = job.key;
+	output.replace_extension(".asset_mesh");
+
+	Assets::BakeRecord& record         = job.record;
+	const Assets::BakeRecord* previous = job.previous_record;
+	const bool is_output_present = prepare_record(job, output, output_directory, settings_hash);
+
+	Assets::MappedFile input_file;
+	tinygltf::Model gltf_model;
+	if (!input_file.open(job.input.string().c_str())
+	    || !load_gltf(job.input, input_file, gltf_model))
+	{
+		log("Failed to read mesh -> ", job.input);
+		job.result = BakeJob::Result::Failed;
+		return;
+	}
+
+	record.input_hash = Assets::hash_content(input_file.data(), input_file.size());
+	for (const tinygltf::Buffer& buffer : gltf_model.buffers)
+	{
+		const uint64_t buffer_hash = Assets::hash_content(buffer.data.data(), buffer.data.size());
+		record.input_hash = (record.input_hash ^ buffer_hash) * 0x100000001b3ull;
+	}
+
+	if (is_output_present && previous->input_hash == record.input_hash)
+	{
+		job.result = BakeJob::Result::Skipped;
+		return;
+	}
+
+	std::filesystem::create_directories((output_directory / output).parent_path());
+	if (!convert_mesh(
+	      job.input,
+	      gltf_model,
+	      output_directory / output,
+	      compression,
+	      vertex_encoding
+	    ))
+	{
+		log("Failed to bake mesh -> ", job.input);
+		job.result = BakeJob::Result::Failed;
+		return;
+	}
+
+	log_bake_time(job, start_time);
+	job.result = BakeJob::Result::Baked;
+}
+
+/** Packs every baked asset into a single archive, named by their path relative to
+ * the output directory. Blobs are streamed from their mapped files */
+bool write_asset_archive(
+  const std::filesystem::path& archive_path,
+  const std::filesystem::path& output_directory,
+  const Assets::BakeManifest& manifest
+)
+{
+	// Sorted so unchanged assets produce the exact same archive
+	std::vector<std::string> outputs;
+	outputs.reserve(manifest.records.size());
+	for (const auto& [key, record] : manifest.records)
+		outputs.push_back(record.output);
+
+	std::sort(outputs.begin(), outputs.end());
+
+	std::vector<Assets::MappedAssetFile> files(outputs.size());
+	std::vector<Assets::AssetArchiveSource> sources;
+	sources.reserve(outputs.size());
+
+	for (size_t i = 0; i < outputs.size(); ++i)
+	{
+		Assets::MappedAssetFile& file = files[i];
+		if (!Assets::map_binary_file((output_directory / outputs[i]).string().c_str(), file))
+		{
+			log("Failed to map baked asset -> ", outputs[i]);
+			return false;
+		}
+
+		Assets::AssetArchiveSource& source = sources.emplace_back();
+		source.name                        = outputs[i];
+		source.asset                       = file;
+
+		if (file.type == Assets::AssetFile::Type::Mesh)
+		{
+			const Assets::MeshInfo info = Assets::read_mesh_info(file.json);
+			source.compression_mode     = info.compression_mode;
+			source.uncompressed_size    = Assets::get_vertices_size(&info)
+			                           + Assets::get_indices_size(&info);
+		}
+		else
+		{
+			const Assets::TextureInfo info = Assets::read_texture_info(file.json);
+			source.compression_mode        = info.compression_mode;
+			source.uncompressed_size       = info.size;
+		}
+	}
+
+	return Assets::save_asset_archive(archive_path.string().c_str(), sources);
+}
+
 int main(int argc, char* argv[])
 {
 	std::ios_base::sync_with_stdio(false);
 
 	ASSERT(
-	  argc == 3,
-	  "Argc MUST be 3, 1: execution-path(implicit), 2: input-directory, 3: output-directory"
+	  argc >= 3,
+	  "Argc MUST be at least 3, 1: execution-path(implicit), 2: input-directory, 3: output-directory, "
+	  "[--codec=<none|lz4|lz4hc|zstd>] [--level=<n>] [--vertices=compact] "
+	  "[--positions=<float|half|unorm16>] [--directions=<float|oct16|oct8>] [--uvs=<float|half>]"
 	);
 
-	for (auto& p : std::filesystem::directory_iterator(argv[1]))
+	CompressionSettings compression;
+	Assets::VertexEncoding vertex_encoding;
+	ASSERT(
+	  parse_bake_settings(argc, argv, compression, vertex_encoding),
+	  "Invalid arguments"
+	);
+	ASSERT(
+	  Assets::is_compression_supported(compression.mode),
+	  "Requested codec isn't supported by this build (zstd wasn't found)"
+	);
+
+	const auto start_time = std::chrono::steady_clock::now();
+
+	const std::filesystem::path input_directory  = argv[1];
+	const std::filesystem::path output_directory = argv[2];
+	std::filesystem::create_directories(output_directory);
+
+	const std::string manifest_path = (output_directory / "bake_manifest.json").string();
+
+	Assets::BakeManifest manifest;
+	if (!Assets::load_bake_manifest(manifest_path.c_str(), manifest))
+		log("No bake manifest found, baking everything");
+
+	std::vector<BakeJob> jobs;
+	for (auto& p : std::filesystem::recursive_directory_iterator(input_directory))
 	{
-		if (p.path().extension() == ".png")
+		if (!p.is_regular_file())
+			continue;
+
+		const std::filesystem::path extension = p.path().extension();
+		const bool is_texture = extension == ".png" || extension == ".jpg" || extension == ".jpeg";
+		const bool is_mesh    = extension == ".gltf" || extension == ".glb";
+
+		if (is_texture || is_mesh)
 		{
-			log("Found a texture: ", p);
+			const std::string key = p.path().lexically_relative(input_directory).generic_string();
+			const auto record     = manifest.records.find(key);
 
-			auto newp = p.path();
-			newp.replace_extension(".asset_texture");
-			convert_image(p.path(), newp);
+			jobs.push_back({
+			  .type            = is_mesh ? BakeJob::Type::Mesh : BakeJob::Type::Texture,
+			  .input           = p.path(),
+			  .key             = key,
+			  .previous_record = record != manifest.records.end() ? &record->second : nullptr,
+			});
 		}
-		else if (p.path().extension() == ".obj")
+		else if (extension == ".obj")
 		{
 			log("Found a mesh -> ", p, " (unsupported)");
 		}
-		else
-		{
-			log("Unknown -> ", p);
-		}
 	}
 
-	return 0;
+	// Mip generation dominates baking time, so assets are baked in parallel
+	const uint64_t settings_hash = hash_settings(compression, vertex_encoding);
+	std::atomic<size_t> next_job = 0ull;
+	std::vector<std::thread> workers;
+
+	const uint32_t worker_count = std::max(std::thread::hardware_concurrency(), 1u);
+	for (uint32_t i = 0; i < worker_count; ++i)
+	{
+		workers.emplace_back([&]() {
+			for (size_t j = next_job++; j < jobs.size(); j = next_job++)
+			{
+				if (jobs[j].type == BakeJob::Type::Mesh)
+					bake_mesh(
+					  jobs[j],
+					  output_directory,
+					  compression,
+					  vertex_encoding,
+					  settings_hash
+					);
+				else
+					bake_texture(jobs[j], output_directory, compression, settings_hash);
+			}
+		});
+	}
+
+	for (auto& worker : workers)
+		worker.join();
+
+	// Inputs that are gone or failed to bake drop out of the manifest
+	Assets::BakeManifest baked_manifest;
+	size_t counts[3] = {};
+
+	for (const BakeJob& job : jobs)
+	{
+		++counts[(size_t)job.result];
+
+		if (job.result != BakeJob::Result::Failed)
+			baked_manifest.records[job.key] = job.record;
+	}
+
+	ASSERT(
+	  Assets::save_bake_manifest(manifest_path.c_str(), baked_manifest),
+	  "Failed to save bake manifest -> ",
+	  manifest_path
+	);
+
+	// Only repacked when an asset changed, dropped out or the archive is gone
+	const std::filesystem::path archive_path = output_directory / "assets.asset_archive";
+	if (counts[(size_t)BakeJob::Result::Baked]
+	    || baked_manifest.records.size() != manifest.records.size()
+	    || !std::filesystem::exists(archive_path))
+	{
+		ASSERT(
+		  write_asset_archive(archive_path, output_directory, baked_manifest),
+		  "Failed to write asset archive -> ",
+		  archive_path
+		);
+	}
+
+	const auto duration = std::chrono::duration<double, std::milli>(
+	  std::chrono::steady_clock::now() - start_time
+	);
+
+	log(
+	  "Baked ",
+	  counts[(size_t)BakeJob::Result::Baked],
+	  ", skipped ",
+	  counts[(size_t)BakeJob::Result::Skipped],
+	  ", failed ",
+	  counts[(size_t)BakeJob::Result::Failed],
+	  " assets in ",
+	  duration.count(),
+	  "ms"
+	);
+
+	return counts[(size_t)BakeJob::Result::Failed] ? 1 : 0;
 }
@@ -0,0 +1,218 @@
+#include "AssetArchive.hpp"
+
+#include <fstream>
+
+namespace Assets {
+
+namespace {
+
+bool is_in_range(size_t file_size, uint64_t offset, uint64_t size)
+{
+	return offset <= file_size && size <= file_size - offset;
+}
+
+uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t get_slot_count(size_t entry_count)
+{
+	uint32_t slot_count = 2u;
+	while (slot_count < entry_count * 2)
+		slot_count <<= 1;
+
+	return slot_count;
+}
+
+} // namespace
+
+bool save_asset_archive(const char* path, const std::vector<AssetArchiveSource>& sources)
+{
+	const AssetArchiveHeader header {
+		.magic       = asset_archive_magic,
+		.version     = asset_archive_version,
+		.entry_count = static_cast<uint32_t>(sources.size()),
+		.slot_count  = get_slot_count(sources.size()),
+	};
+
+	// Linear probing, the load factor is at most 0.5 so probe sequences stay short
+	std::vector<uint32_t> slots(header.slot_count, asset_archive_empty_slot);
+	std::vector<AssetArchiveEntry> entries(sources.size());
+
+	const uint64_t slots_offset   = sizeof(AssetArchiveHeader);
+	const uint64_t entries_offset = slots_offset + slots.size() * sizeof(uint32_t);
+	uint64_t offset = entries_offset + entries.size() * sizeof(AssetArchiveEntry);
+
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const AssetArchiveSource& source = sources[i];
+		AssetArchiveEntry& entry         = entries[i];
+
+		entry.name_hash = hash_content(source.name.data(), source.name.size());
+
+		uint32_t slot = entry.name_hash & (header.slot_count - 1);
+		while (slots[slot] != asset_archive_empty_slot)
+		{
+			if (sources[slots[slot]].name == source.name)
+				return false;
+
+			slot = (slot + 1) & (header.slot_count - 1);
+		}
+
+		slots[slot] = i;
+
+		entry.name_offset = offset;
+		entry.name_size   = source.name.size();
+		offset += entry.name_size;
+	}
+
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		entries[i].json_offset = offset;
+		entries[i].json_size   = sources[i].asset.json.size();
+		offset += entries[i].json_size;
+	}
+
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const AssetArchiveSource& source = sources[i];
+		AssetArchiveEntry& entry         = entries[i];
+
+		offset = align_up(offset, asset_archive_alignment);
+
+		entry.blob_offset       = offset;
+		entry.blob_size         = source.asset.blob_size;
+		entry.uncompressed_size = source.uncompressed_size;
+		entry.type              = (uint32_t)source.asset.type;
+		entry.version           = source.asset.version;
+		entry.compression_mode  = (uint32_t)source.compression_mode;
+		entry._0                = 0u;
+
+		offset += entry.blob_size;
+	}
+
+	std::ofstream outstream(path, std::ios::binary | std::ios::out);
+	if (!outstream.is_open())
+		return false;
+
+	outstream.write((const char*)&header, sizeof(header));
+	outstream.write((const char*)slots.data(), slots.size() * sizeof(uint32_t));
+	outstream.write((const char*)entries.data(), entries.size() * sizeof(AssetArchiveEntry));
+
+	for (const AssetArchiveSource& source : sources)
+		outstream.write(source.name.data(), source.name.size());
+
+	for (const AssetArchiveSource& source : sources)
+		outstream.write(source.asset.json.data(), source.asset.json.size());
+
+	// Blobs are streamed straight from their views, the archive is never held in memory
+	const char padding[asset_archive_alignment] = {};
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		const uint64_t position = outstream.tellp();
+		outstream.write(padding, entries[i].blob_offset - position);
+
+		outstream.write((const char*)sources[i].asset.blob, sources[i].asset.blob_size);
+	}
+
+	outstream.close();
+	return !outstream.fail();
+}
+
+bool AssetArchive::open(const char* path)
+{
+	if (!file.open(path))
+		return false;
+
+	if (!validate())
+	{
+		file.close();
+		return false;
+	}
+
+	return true;
+}
+
+const AssetArchiveEntry* AssetArchive::find(std::string_view name) const
+{
+	const uint64_t name_hash = hash_content(name.data(), name.size());
+
+	const uint32_t mask              = get_header()->slot_count - 1;
+	const uint32_t* slots            = get_slots();
+	const AssetArchiveEntry* entries = get_entries();
+
+	uint32_t slot = name_hash & mask;
+	while (slots[slot] != asset_archive_empty_slot)
+	{
+		const AssetArchiveEntry* entry = &entries[slots[slot]];
+		if (entry->name_hash == name_hash && get_name(entry) == name)
+			return entry;
+
+		slot = (slot + 1) & mask;
+	}
+
+	return nullptr;
+}
+
+bool AssetArchive::validate() const
+{
+	const size_t file_size = file.size();
+
+	if (file_size < sizeof(AssetArchiveHeader))
+		return false;
+
+	const AssetArchiveHeader* header = get_header();
+	if (header->magic != asset_archive_magic)
+		return false;
+
+	if (header->version != asset_archive_version)
+		return false;
+
+	if (
+	  header->slot_count < 2 || header->slot_count & (header->slot_count - 1)
+	  || header->slot_count <= header->entry_count
+	)
+		return false;
+
+	const uint64_t slots_size   = uint64_t(header->slot_count) * sizeof(uint32_t);
+	const uint64_t entries_size = uint64_t(header->entry_count)
+	                              * sizeof(AssetArchiveEntry);
+
+	if (!is_in_range(file_size, sizeof(AssetArchiveHeader), slots_size + entries_size))
+		return false;
+
+	// Every entry occupies exactly one slot, which leaves the rest empty to end the probes
+	const uint32_t* slots    = get_slots();
+	uint32_t used_slot_count = 0u;
+	for (uint32_t i = 0; i < header->slot_count; ++i)
+	{
+		if (slots[i] == asset_archive_empty_slot)
+			continue;
+
+		if (slots[i] >= header->entry_count)
+			return false;
+
+		++used_slot_count;
+	}
+
+	if (used_slot_count != header->entry_count)
+		return false;
+
+	const AssetArchiveEntry* entries = get_entries();
+	for (uint32_t i = 0; i < header->entry_count; ++i)
+	{
+		const AssetArchiveEntry& entry = entries[i];
+
+		if (
+		  !is_in_range(file_size, entry.name_offset, entry.name_size)
+		  || !is_in_range(file_size, entry.json_offset, entry.json_size)
+		  || !is_in_range(file_size, entry.blob_offset, entry.blob_size)
+		)
+			return false;
+	}
+
+	return true;
+}
+
+} // namespace Assets
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "AssetParser.hpp"
+#include "MappedFile.hpp"
+
+#include <string_view>
+
+namespace Assets {
+
+/** "BVAA" */
+constexpr uint32_t asset_archive_magic   = 0x41415642u;
+constexpr uint32_t asset_archive_version = 1u;
+
+/** Blobs start on page boundaries, so they can be mapped or read unbuffered on their own */
+constexpr uint64_t asset_archive_alignment = 4096u;
+
+/** Marks an empty slot of the table of contents */
+constexpr uint32_t asset_archive_empty_slot = 0xffffffffu;
+
+struct AssetArchiveHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t entry_count;
+
+	/** Size of the slot table, a power of two at least twice the entry count */
+	uint32_t slot_count;
+};
+
+/** Fixed size record of an asset, offsets are relative to the start of the archive */
+struct AssetArchiveEntry
+{
+	uint64_t name_hash;
+	uint64_t name_offset;
+
+	uint64_t json_offset;
+	uint64_t blob_offset;
+	uint64_t blob_size;
+
+	/** Size of the blob once unpacked, equal to blob_size for uncompressed assets */
+	uint64_t uncompressed_size;
+
+	uint32_t name_size;
+	uint32_t json_size;
+
+	uint32_t type;
+	uint32_t version;
+	uint32_t compression_mode;
+	uint32_t _0;
+};
+
+/** Input of save_asset_archive, the views have to outlive the call */
+struct AssetArchiveSource
+{
+	std::string name;
+	AssetView asset;
+
+	CompressionMode compression_mode;
+	uint64_t uncompressed_size;
+};
+
+/** Writes @a sources into a single archive, laid out as:
+ * header | slot table | entries | names | jsons | aligned blobs
+ *
+ * @returns false if the file can't be written or two sources share a name
+ */
+bool save_asset_archive(const char* path, const std::vector<AssetArchiveSource>& sources);
+
+/** Memory mapped asset archive, every accessor points into the mapping
+ *
+ * The table of contents is an open addressed hash table of entry indices keyed by
+ * name_hash, looking an asset up is a single probe unless the hashes collide
+ */
+class AssetArchive
+{
+public:
+	bool open(const char* path);
+
+	void close()
+	{
+		file.close();
+	}
+
+	bool is_open() const
+	{
+		return file.is_open();
+	}
+
+	/** Returns nullptr if not found */
+	const AssetArchiveEntry* find(std::string_view name) const;
+
+	uint32_t get_entry_count() const
+	{
+		return get_header()->entry_count;
+	}
+
+	const AssetArchiveEntry* get_entries() const
+	{
+		return (const AssetArchiveEntry*)(file.data() + get_entries_offset());
+	}
+
+	std::string_view get_name(const AssetArchiveEntry* entry) const
+	{
+		return { (const char*)file.data() + entry->name_offset, entry->name_size };
+	}
+
+	/** The view is valid for as long as the archive is open */
+	AssetView get_asset(const AssetArchiveEntry* entry) const
+	{
+		return {
+			.version   = entry->version,
+			.type      = (AssetFile::Type)entry->type,
+			.json      = { (const char*)file.data() + entry->json_offset, entry->json_size },
+			.blob      = file.data() + entry->blob_offset,
+			.blob_size = entry->blob_size,
+		};
+	}
+
+private:
+	const AssetArchiveHeader* get_header() const
+	{
+		return (const AssetArchiveHeader*)file.data();
+	}
+
+	const uint32_t* get_slots() const
+	{
+		return (const uint32_t*)(file.data() + sizeof(AssetArchiveHeader));
+	}
+
+	size_t get_entries_offset() const
+	{
+		return sizeof(AssetArchiveHeader) + get_header()->slot_count * sizeof(uint32_t);
+	}
+
+	bool validate() const;
+
+private:
+	MappedFile file = {};
+};
+
+} // namespace Assets
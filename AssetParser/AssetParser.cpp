@@ -1,5 +1,6 @@
 #include "AssetParser.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <istream>
 #include <ostream>
@@ -54,4 +55,56 @@ bool load_binary_file(const char* path, AssetFile& out_file)
 	return true;
 }
 
+bool view_binary_file(const uint8_t* data, size_t size, AssetView& out_view)
+{
+	// version, type, json size, blob size
+	const size_t header_size = 4 * sizeof(uint32_t);
+	if (size < header_size)
+		return false;
+
+	uint32_t json_size;
+	uint32_t blob_size;
+	memcpy(&out_view.version, data, sizeof(uint32_t));
+	memcpy(&out_view.type, data + 4, sizeof(AssetFile::Type));
+	memcpy(&json_size, data + 8, sizeof(uint32_t));
+	memcpy(&blob_size, data + 12, sizeof(uint32_t));
+
+	if (size < header_size + json_size + blob_size)
+		return false;
+
+	out_view.json      = { (const char*)data + header_size, json_size };
+	out_view.blob      = data + header_size + json_size;
+	out_view.blob_size = blob_size;
+
+	return true;
+}
+
+bool map_binary_file(const char* path, MappedAssetFile& out_file)
+{
+	if (!out_file.file.open(path))
+		return false;
+
+	if (!view_binary_file(out_file.file.data(), out_file.file.size(), out_file))
+	{
+		out_file.file.close();
+		return false;
+	}
+
+	return true;
+}
+
+uint64_t hash_content(const void* data, size_t size)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
 } // namespace Assets
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "MappedFile.hpp"
+
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Assets {
@@ -21,14 +24,45 @@ struct AssetFile
 	std::vector<uint8_t> blob;
 };
 
+/** An asset's header, json & blob viewed in place, eg. inside a mapped file or archive */
+struct AssetView
+{
+	uint32_t version;
+	AssetFile::Type type;
+
+	std::string_view json;
+
+	const uint8_t* blob;
+	size_t blob_size;
+};
+
+/** An AssetFile whose json & blob are views into a memory mapping of the file,
+ * nothing is copied until the blob is unpacked into its destination */
+struct MappedAssetFile: AssetView
+{
+	/** Keeps the views alive, they're invalidated once it's closed */
+	MappedFile file;
+};
+
 enum class CompressionMode : uint32_t
 {
 	None,
 	LZ4,
 	LZ4HC,
+	ZSTD,
 };
 
 bool save_binary_file(const char* path, const AssetFile& in_file);
 bool load_binary_file(const char* path, AssetFile& out_file);
 
+/** Views an asset file written by save_binary_file that's already in memory, fails on
+ * truncated files */
+bool view_binary_file(const uint8_t* data, size_t size, AssetView& out_view);
+
+/** Maps an asset file written by save_binary_file, fails on truncated files */
+bool map_binary_file(const char* path, MappedAssetFile& out_file);
+
+/** 64-bit FNV-1a hash of @a size bytes, stable across runs and platforms */
+uint64_t hash_content(const void* data, size_t size);
+
 } // namespace Assets
@@ -0,0 +1,59 @@
+#include "BakeManifest.hpp"
+
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace Assets {
+
+using namespace nlohmann;
+
+bool load_bake_manifest(const char* path, BakeManifest& out_manifest)
+{
+	out_manifest.records.clear();
+
+	std::ifstream instream(path);
+	if (!instream.is_open())
+		return false;
+
+	const json manifest = json::parse(instream, nullptr, false);
+	if (manifest.is_discarded() || !manifest.contains("records"))
+		return false;
+
+	// Missing fields never match, the asset just gets baked again
+	for (const auto& [input, record] : manifest["records"].items())
+	{
+		out_manifest.records[input] = BakeRecord {
+			.input_size       = record.value("inputSize", uint64_t {}),
+			.input_write_time = record.value("inputWriteTime", int64_t {}),
+			.input_hash       = record.value("inputHash", uint64_t {}),
+			.settings_hash    = record.value("settingsHash", uint64_t {}),
+			.output           = record.value("output", std::string {}),
+		};
+	}
+
+	return true;
+}
+
+bool save_bake_manifest(const char* path, const BakeManifest& manifest)
+{
+	json records = json::object();
+	for (const auto& [input, record] : manifest.records)
+	{
+		records[input] = {
+			{ "inputSize", record.input_size },
+			{ "inputWriteTime", record.input_write_time },
+			{ "inputHash", record.input_hash },
+			{ "settingsHash", record.settings_hash },
+			{ "output", record.output },
+		};
+	}
+
+	std::ofstream outstream(path);
+	if (!outstream.is_open())
+		return false;
+
+	outstream << json { { "records", records } }.dump(1, '\t');
+	return outstream.good();
+}
+
+} // namespace Assets
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+
+namespace Assets {
+
+/** What an output was baked from, an output is up to date while its input's
+ * content & the bake settings hash the same */
+struct BakeRecord
+{
+	/** Cheap change check, the content is only hashed again if these differ */
+	uint64_t input_size;
+	int64_t input_write_time;
+
+	uint64_t input_hash;
+	uint64_t settings_hash;
+
+	/** Output path, relative to the output directory */
+	std::string output;
+};
+
+/** Records of the last bake, keyed by the input path relative to the input
+ * directory */
+struct BakeManifest
+{
+	std::unordered_map<std::string, BakeRecord> records;
+};
+
+/** @returns false if the manifest doesn't exist or is malformed, @a out_manifest
+ * is left empty (everything gets baked) */
+bool load_bake_manifest(const char* path, BakeManifest& out_manifest);
+
+bool save_bake_manifest(const char* path, const BakeManifest& manifest);
+
+} // namespace Assets
@@ -0,0 +1,380 @@
+#include "ChunkedBlob.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <lz4.h>
+#include <lz4hc.h>
+#include <thread>
+
+#ifdef ASSET_PARSER_ZSTD
+	#include <zstd.h>
+#endif
+
+namespace Assets {
+
+namespace {
+
+/** Below this many chunks per worker, spawning the thread costs more than it saves */
+constexpr size_t min_chunks_per_worker = 4;
+
+uint32_t get_worker_count(uint32_t thread_count, size_t chunk_count)
+{
+	if (!thread_count)
+		thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+	const size_t useful_workers = std::max<size_t>(chunk_count / min_chunks_per_worker, 1);
+	return (uint32_t)std::min<size_t>(thread_count, useful_workers);
+}
+
+/** Calls @a function for every index in [@a begin, @a end), the calling thread
+ * works alongside the spawned ones */
+template<typename Function>
+void parallel_for(size_t begin, size_t end, uint32_t thread_count, Function&& function)
+{
+	const uint32_t worker_count = get_worker_count(thread_count, end - begin);
+
+	std::atomic<size_t> next_index = begin;
+	const auto work = [&]() {
+		for (size_t i = next_index++; i < end; i = next_index++)
+			function(i);
+	};
+
+	std::vector<std::thread> workers;
+	for (uint32_t i = 1; i < worker_count; ++i)
+		workers.emplace_back(work);
+
+	work();
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+size_t get_compress_bound(CompressionMode mode, size_t size)
+{
+#ifdef ASSET_PARSER_ZSTD
+	if (mode == CompressionMode::ZSTD)
+		return ZSTD_compressBound(size);
+#endif
+
+	return LZ4_compressBound(size);
+}
+
+/** @returns The compressed size, 0 on failure */
+size_t compress_block(
+  CompressionMode mode,
+  int level,
+  const char* source,
+  size_t source_size,
+  char* destination,
+  size_t capacity
+)
+{
+	switch (mode)
+	{
+	case CompressionMode::LZ4:
+		return LZ4_compress_fast(source, destination, source_size, capacity, std::max(level, 1));
+
+	case CompressionMode::LZ4HC:
+		return LZ4_compress_HC(
+		  source,
+		  destination,
+		  source_size,
+		  capacity,
+		  level ? level : LZ4HC_CLEVEL_DEFAULT
+		);
+
+#ifdef ASSET_PARSER_ZSTD
+	case CompressionMode::ZSTD:
+	{
+		const size_t compressed_size = ZSTD_compress(
+		  destination,
+		  capacity,
+		  source,
+		  source_size,
+		  level ? level : ZSTD_CLEVEL_DEFAULT
+		);
+
+		return ZSTD_isError(compressed_size) ? 0 : compressed_size;
+	}
+#endif
+
+	default: return 0;
+	}
+}
+
+/** Decompresses the first @a prefix_size bytes of a block into @a destination,
+ * which has to hold @a block_size bytes (the whole block for zstd) */
+bool decompress_block(
+  CompressionMode mode,
+  const char* source,
+  size_t source_size,
+  char* destination,
+  size_t prefix_size,
+  size_t block_size
+)
+{
+	switch (mode)
+	{
+	case CompressionMode::LZ4:
+	case CompressionMode::LZ4HC:
+	{
+		const int decompressed_size = prefix_size == block_size
+		                                ? LZ4_decompress_safe(
+		                                    source,
+		                                    destination,
+		                                    source_size,
+		                                    block_size
+		                                  )
+		                                : LZ4_decompress_safe_partial(
+		                                    source,
+		                                    destination,
+		                                    source_size,
+		                                    prefix_size,
+		                                    block_size
+		                                  );
+
+		return decompressed_size >= (int)prefix_size;
+	}
+
+#ifdef ASSET_PARSER_ZSTD
+	case CompressionMode::ZSTD:
+	{
+		const size_t decompressed_size = ZSTD_decompress(
+		  destination,
+		  block_size,
+		  source,
+		  source_size
+		);
+
+		return !ZSTD_isError(decompressed_size) && decompressed_size == block_size;
+	}
+#endif
+
+	default: return false;
+	}
+}
+
+} // namespace
+
+bool is_compression_supported(CompressionMode mode)
+{
+	switch (mode)
+	{
+	case CompressionMode::None:
+	case CompressionMode::LZ4:
+	case CompressionMode::LZ4HC: return true;
+
+#ifdef ASSET_PARSER_ZSTD
+	case CompressionMode::ZSTD: return true;
+#endif
+
+	default: return false;
+	}
+}
+
+std::vector<uint8_t> compress_chunked(
+  const void* data,
+  size_t size,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  int level,
+  std::vector<BlobChunk>& chunks,
+  uint32_t thread_count
+)
+{
+	const char* bytes = (const char*)data;
+
+	chunks.clear();
+	if (mode == CompressionMode::None || !is_compression_supported(mode))
+		return {};
+
+	// Chunks are compressed into their own buffers, then packed in order
+	const size_t chunk_count = (size + chunk_size - 1) / chunk_size;
+	std::vector<std::vector<uint8_t>> blocks(chunk_count);
+	std::atomic<bool> is_valid = true;
+
+	parallel_for(0, chunk_count, thread_count, [&](size_t i) {
+		const size_t offset            = i * chunk_size;
+		const size_t uncompressed_size = std::min<size_t>(chunk_size, size - offset);
+
+		std::vector<uint8_t>& block = blocks[i];
+		block.resize(get_compress_bound(mode, uncompressed_size));
+
+		const size_t compressed_size = compress_block(
+		  mode,
+		  level,
+		  bytes + offset,
+		  uncompressed_size,
+		  (char*)block.data(),
+		  block.size()
+		);
+
+		if (!compressed_size)
+			is_valid = false;
+
+		block.resize(compressed_size);
+	});
+
+	if (!is_valid)
+		return {};
+
+	std::vector<uint8_t> blob;
+	chunks.reserve(chunk_count);
+
+	for (const std::vector<uint8_t>& block : blocks)
+	{
+		chunks.push_back({
+		  (uint32_t)blob.size(),
+		  (uint32_t)block.size(),
+		});
+
+		blob.insert(blob.end(), block.begin(), block.end());
+	}
+
+	return blob;
+}
+
+bool decompress_chunk(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  size_t decompressed_size,
+  size_t index,
+  void* destination
+)
+{
+	const size_t chunk_begin = index * chunk_size;
+	if (index >= chunks.size() || chunk_begin >= decompressed_size)
+		return false;
+
+	const BlobChunk& chunk = chunks[index];
+	if ((size_t)chunk.offset + chunk.size > blob_size)
+		return false;
+
+	const size_t chunk_length = std::min<size_t>(chunk_size, decompressed_size - chunk_begin);
+
+	return decompress_block(
+	  mode,
+	  (const char*)blob + chunk.offset,
+	  chunk.size,
+	  (char*)destination,
+	  chunk_length,
+	  chunk_length
+	);
+}
+
+bool decompress_chunked(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  void* destination,
+  size_t destination_size,
+  uint32_t thread_count
+)
+{
+	if (chunks.size() != (destination_size + chunk_size - 1) / chunk_size)
+		return false;
+
+	return decompress_chunked_range(
+	  blob,
+	  blob_size,
+	  chunks,
+	  chunk_size,
+	  mode,
+	  destination_size,
+	  0,
+	  destination_size,
+	  destination,
+	  thread_count
+	);
+}
+
+bool decompress_chunked_range(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  size_t decompressed_size,
+  size_t offset,
+  size_t size,
+  void* destination,
+  uint32_t thread_count
+)
+{
+	const size_t first_chunk = offset / chunk_size;
+	const size_t end_chunk   = (offset + size + chunk_size - 1) / chunk_size;
+
+	if (offset + size > decompressed_size || end_chunk > chunks.size())
+		return false;
+
+	char* bytes = (char*)destination;
+	std::atomic<bool> is_valid = true;
+
+	parallel_for(first_chunk, end_chunk, thread_count, [&](size_t i) {
+		const size_t chunk_begin  = i * chunk_size;
+		const size_t chunk_length = std::min<size_t>(
+		  chunk_size,
+		  decompressed_size - chunk_begin
+		);
+
+		const size_t copy_begin = std::max(chunk_begin, offset);
+		const size_t copy_end   = std::min(chunk_begin + chunk_length, offset + size);
+
+		// Fully covered chunks are decompressed in place
+		if (copy_begin == chunk_begin && copy_end == chunk_begin + chunk_length)
+		{
+			if (!decompress_chunk(
+			      blob,
+			      blob_size,
+			      chunks,
+			      chunk_size,
+			      mode,
+			      decompressed_size,
+			      i,
+			      bytes + (chunk_begin - offset)
+			    ))
+				is_valid = false;
+
+			return;
+		}
+
+		// Only the edges of the range are partially covered, where the prefix up to
+		// the end of the range is decoded (the whole chunk for zstd)
+		const BlobChunk& chunk = chunks[i];
+		if ((size_t)chunk.offset + chunk.size > blob_size)
+		{
+			is_valid = false;
+			return;
+		}
+
+		std::vector<char> scratch(chunk_length);
+		if (!decompress_block(
+		      mode,
+		      (const char*)blob + chunk.offset,
+		      chunk.size,
+		      scratch.data(),
+		      copy_end - chunk_begin,
+		      chunk_length
+		    ))
+		{
+			is_valid = false;
+			return;
+		}
+
+		memcpy(
+		  bytes + (copy_begin - offset),
+		  scratch.data() + (copy_begin - chunk_begin),
+		  copy_end - copy_begin
+		);
+	});
+
+	return is_valid;
+}
+
+} // namespace Assets
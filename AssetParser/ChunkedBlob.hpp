@@ -0,0 +1,105 @@
+#pragma once
+
+#include "AssetParser.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Assets {
+
+/** Uncompressed size of a chunk, every chunk but the last one decompresses to
+ * exactly this many bytes. A multiple of 4, so chunks never share a 32-bit word
+ * of the decompressed blob (the gpu decompressor relies on it)
+ */
+constexpr uint32_t default_chunk_size = 64u * 1024u;
+
+/** An independently compressed block of a chunked blob
+ *
+ * Chunk i decompresses to [i * chunk_size, (i + 1) * chunk_size) of the blob,
+ * so chunks can be decompressed in any order & in parallel
+ */
+struct BlobChunk
+{
+	uint32_t offset; // Offset of the compressed block in the packed blob
+	uint32_t size;   // Size of the compressed block
+};
+
+/** Checks if @a mode was compiled in, zstd is optional */
+bool is_compression_supported(CompressionMode mode);
+
+/** Compresses @a size bytes of @a data into independent blocks, in parallel
+ *
+ * @param mode LZ4, LZ4HC or ZSTD. LZ4HC blocks are plain LZ4 blocks, they
+ * decompress (and gpu decompress) exactly like LZ4 ones
+ * @param level Acceleration for LZ4, compression level for LZ4HC & ZSTD. 0
+ * picks the codec's default
+ * @param thread_count Worker threads, 0 uses every hardware thread
+ *
+ * @returns Tightly packed compressed blocks, described by @a chunks
+ */
+std::vector<uint8_t> compress_chunked(
+  const void* data,
+  size_t size,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  int level,
+  std::vector<BlobChunk>& chunks,
+  uint32_t thread_count = 0u
+);
+
+/** Decompresses chunk @a index of @a blob into @a destination, which has to
+ * hold min(chunk_size, decompressed_size - index * chunk_size) bytes
+ *
+ * @returns false if the chunk is malformed or out of bounds
+ */
+bool decompress_chunk(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  size_t decompressed_size,
+  size_t index,
+  void* destination
+);
+
+/** Decompresses every chunk of @a blob into @a destination in parallel, the
+ * cpu reference for the gpu decompressor
+ *
+ * @returns false if a chunk is malformed or doesn't decompress to its size
+ */
+bool decompress_chunked(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  void* destination,
+  size_t destination_size,
+  uint32_t thread_count = 0u
+);
+
+/** Decompresses [@a offset, @a offset + @a size) of the blob into
+ * @a destination, only touching the chunks overlapping the range
+ *
+ * Fully covered chunks are decompressed in place & in parallel, the partially
+ * covered ones at the edges go through a chunk-sized scratch buffer. So large
+ * blobs can be unpacked piece by piece with flat memory usage
+ *
+ * @returns false if a chunk is malformed or the range is out of bounds
+ */
+bool decompress_chunked_range(
+  const void* blob,
+  size_t blob_size,
+  const std::vector<BlobChunk>& chunks,
+  uint32_t chunk_size,
+  CompressionMode mode,
+  size_t decompressed_size,
+  size_t offset,
+  size_t size,
+  void* destination,
+  uint32_t thread_count = 0u
+);
+
+} // namespace Assets
@@ -0,0 +1,110 @@
+#include "MappedFile.hpp"
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define ASSETS_HAS_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace Assets {
+
+MappedFile::MappedFile(MappedFile&& other)
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+	if (this == &other)
+		return *this;
+
+	close();
+
+	mapped_data     = std::exchange(other.mapped_data, nullptr);
+	mapped_size     = std::exchange(other.mapped_size, 0);
+	fallback_buffer = std::move(other.fallback_buffer);
+
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const char* path)
+{
+	close();
+
+#ifdef ASSETS_HAS_MMAP
+	const int fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* mapping = mmap(
+	  nullptr,
+	  static_cast<size_t>(file_stat.st_size),
+	  PROT_READ,
+	  MAP_PRIVATE,
+	  fd,
+	  0
+	);
+
+	// the mapping keeps the file referenced
+	::close(fd);
+
+	if (mapping == MAP_FAILED)
+		return false;
+
+	mapped_data = static_cast<const uint8_t*>(mapping);
+	mapped_size = static_cast<size_t>(file_stat.st_size);
+
+	return true;
+#else
+	std::ifstream instream(path, std::ios::binary | std::ios::ate);
+	if (!instream.is_open())
+		return false;
+
+	fallback_buffer.resize(static_cast<size_t>(instream.tellg()));
+	instream.seekg(0ull);
+	instream.read((char*)fallback_buffer.data(), fallback_buffer.size());
+
+	if (fallback_buffer.empty())
+		return false;
+
+	mapped_data = fallback_buffer.data();
+	mapped_size = fallback_buffer.size();
+
+	return true;
+#endif
+}
+
+void MappedFile::close()
+{
+	if (!mapped_data)
+		return;
+
+#ifdef ASSETS_HAS_MMAP
+	munmap(const_cast<uint8_t*>(mapped_data), mapped_size);
+#else
+	fallback_buffer.clear();
+	fallback_buffer.shrink_to_fit();
+#endif
+
+	mapped_data = nullptr;
+	mapped_size = 0;
+}
+
+} // namespace Assets
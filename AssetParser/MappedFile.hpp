@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Assets {
+
+/** Read-only memory mapping of a whole file, falls back to reading the file
+ * into memory on platforms without mmap */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+
+	MappedFile(MappedFile&& other);
+	MappedFile& operator=(MappedFile&& other);
+
+	MappedFile(const MappedFile&)            = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile();
+
+	bool open(const char* path);
+	void close();
+
+	bool is_open() const
+	{
+		return mapped_data != nullptr;
+	}
+
+	const uint8_t* data() const
+	{
+		return mapped_data;
+	}
+
+	size_t size() const
+	{
+		return mapped_size;
+	}
+
+private:
+	const uint8_t* mapped_data = nullptr;
+	size_t mapped_size         = 0;
+
+	std::vector<uint8_t> fallback_buffer = {};
+};
+
+} // namespace Assets
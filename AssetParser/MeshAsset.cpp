@@ -0,0 +1,296 @@
+#include "MeshAsset.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <nlohmann/json.hpp>
+
+namespace Assets {
+
+using namespace nlohmann;
+
+namespace {
+
+bool unpack_range(
+  const MeshInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  size_t offset,
+  size_t size,
+  void* destination
+)
+{
+	if (info->compression_mode == CompressionMode::None)
+	{
+		if (offset + size > source_size)
+			return false;
+
+		memcpy(destination, (const uint8_t*)source_buffer + offset, size);
+		return true;
+	}
+
+	return decompress_chunked_range(
+	  source_buffer,
+	  source_size,
+	  info->chunks,
+	  info->chunk_size,
+	  info->compression_mode,
+	  get_vertices_size(info) + get_indices_size(info),
+	  offset,
+	  size,
+	  destination
+	);
+}
+
+} // namespace
+
+MeshInfo read_mesh_info(AssetFile* file)
+{
+	return read_mesh_info(std::string_view { file->json });
+}
+
+MeshInfo read_mesh_info(std::string_view json_view)
+{
+	json mesh_meta_data = json::parse(json_view);
+
+	MeshInfo info {
+		.vertex_count     = mesh_meta_data["vertexCount"],
+		.index_count      = mesh_meta_data["indexCount"],
+		.compression_mode = mesh_meta_data["compression"],
+		.original_file    = mesh_meta_data["originalFile"],
+		.textures         = mesh_meta_data["textures"],
+	};
+
+	for (const json& node : mesh_meta_data["nodes"])
+	{
+		MeshNode& mesh_node = info.nodes.emplace_back();
+		mesh_node.parent    = node["parent"];
+
+		const std::vector<float> transform = node["transform"];
+		std::copy_n(transform.begin(), 16, mesh_node.transform);
+
+		// Primitives are stored flattened as [first index, index count, material, ...]
+		const std::vector<int64_t> primitives = node["primitives"];
+		for (size_t i = 0; i + 2 < primitives.size(); i += 3)
+		{
+			mesh_node.primitives.push_back({
+			  (uint32_t)primitives[i],
+			  (uint32_t)primitives[i + 1],
+			  (int32_t)primitives[i + 2],
+			});
+		}
+	}
+
+	for (const json& material : mesh_meta_data["materials"])
+	{
+		info.materials.push_back({
+		  material["albedo"],
+		  material["normal"],
+		  material["metallicRoughness"],
+		});
+	}
+
+	const std::vector<float> bounds = mesh_meta_data["bounds"];
+	std::copy_n(bounds.begin(), 3, info.bounds.min);
+	std::copy_n(bounds.begin() + 3, 3, info.bounds.max);
+
+	info.chunk_size = mesh_meta_data.value("chunkSize", 0u);
+	const std::vector<uint32_t> chunks = mesh_meta_data.value(
+	  "chunks",
+	  std::vector<uint32_t> {}
+	);
+
+	for (size_t i = 0; i + 1 < chunks.size(); i += 2)
+		info.chunks.push_back({ chunks[i], chunks[i + 1] });
+
+	info.compression_level = mesh_meta_data.value("compressionLevel", 0);
+
+	// Meshes baked before 16-bit indices have 32-bit ones
+	info.index_size = mesh_meta_data.value("indexSize", 4u);
+
+	// Stored as [position, direction, uv], meshes baked before encodings are full precision
+	const std::vector<uint32_t> vertex_encoding = mesh_meta_data.value(
+	  "vertexEncoding",
+	  std::vector<uint32_t> { 0u, 0u, 0u }
+	);
+
+	if (vertex_encoding.size() == 3u)
+	{
+		info.vertex_encoding = {
+			(PositionEncoding)vertex_encoding[0],
+			(DirectionEncoding)vertex_encoding[1],
+			(UvEncoding)vertex_encoding[2],
+		};
+	}
+
+	info.split_vertex_streams = mesh_meta_data.value("splitVertexStreams", false);
+
+	return info;
+}
+
+size_t get_vertices_size(const MeshInfo* info)
+{
+	const VertexLayout layout = get_vertex_layout(info->vertex_encoding);
+	return info->vertex_count * (layout.position_stride + layout.attribute_stride);
+}
+
+size_t get_positions_size(const MeshInfo* info)
+{
+	return info->vertex_count * get_vertex_layout(info->vertex_encoding).position_stride;
+}
+
+size_t get_indices_size(const MeshInfo* info)
+{
+	return info->index_count * info->index_size;
+}
+
+bool unpack_mesh_vertices(
+  const MeshInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  void* destination
+)
+{
+	return unpack_range(
+	  info,
+	  source_buffer,
+	  source_size,
+	  0,
+	  get_vertices_size(info),
+	  destination
+	);
+}
+
+bool unpack_mesh_indices(
+  const MeshInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  void* destination
+)
+{
+	return unpack_range(
+	  info,
+	  source_buffer,
+	  source_size,
+	  get_vertices_size(info),
+	  get_indices_size(info),
+	  destination
+	);
+}
+
+AssetFile pack_mesh(
+  MeshInfo* info,
+  const void* vertices,
+  const void* indices
+)
+{
+	if (!is_compression_supported(info->compression_mode))
+	{
+		info->compression_mode  = CompressionMode::LZ4;
+		info->compression_level = 0;
+	}
+
+	info->split_vertex_streams = true;
+
+	json nodes = json::array();
+	for (const MeshNode& node : info->nodes)
+	{
+		std::vector<int64_t> primitives;
+		for (const MeshPrimitive& primitive : node.primitives)
+		{
+			primitives.push_back(primitive.first_index);
+			primitives.push_back(primitive.index_count);
+			primitives.push_back(primitive.material_index);
+		}
+
+		nodes.push_back({
+		  { "parent", node.parent },
+		  { "transform", std::vector<float>(node.transform, node.transform + 16) },
+		  { "primitives", primitives },
+		});
+	}
+
+	json materials = json::array();
+	for (const MeshMaterial& material : info->materials)
+	{
+		materials.push_back({
+		  { "albedo", material.albedo_texture },
+		  { "normal", material.normal_texture },
+		  { "metallicRoughness", material.metallic_roughness_texture },
+		});
+	}
+
+	json metadata;
+	metadata["vertexCount"]      = info->vertex_count;
+	metadata["indexCount"]       = info->index_count;
+	metadata["indexSize"]        = info->index_size;
+	metadata["vertexEncoding"]   = {
+		(uint32_t)info->vertex_encoding.position,
+		(uint32_t)info->vertex_encoding.direction,
+		(uint32_t)info->vertex_encoding.uv,
+	};
+	metadata["originalFile"]     = info->original_file;
+	metadata["compression"]      = info->compression_mode;
+	metadata["compressionLevel"] = info->compression_level;
+	metadata["nodes"]            = nodes;
+	metadata["materials"]        = materials;
+	metadata["textures"]         = info->textures;
+	metadata["bounds"]           = {
+		info->bounds.min[0],
+		info->bounds.min[1],
+		info->bounds.min[2],
+		info->bounds.max[0],
+		info->bounds.max[1],
+		info->bounds.max[2],
+	};
+
+	AssetFile file;
+	file.type    = AssetFile::Type::Mesh;
+	file.version = 1u;
+
+	// Both streams are packed back to back, so they're compressed as a single blob
+	const size_t vertices_size = get_vertices_size(info);
+	const size_t indices_size  = get_indices_size(info);
+
+	std::vector<uint8_t> streams(vertices_size + indices_size);
+	memcpy(streams.data(), vertices, vertices_size);
+	memcpy(streams.data() + vertices_size, indices, indices_size);
+
+	if (info->compression_mode == CompressionMode::None)
+	{
+		file.blob = std::move(streams);
+
+		info->chunk_size = 0u;
+		info->chunks.clear();
+	}
+	else
+	{
+		info->chunk_size = default_chunk_size;
+		file.blob        = compress_chunked(
+		  streams.data(),
+		  streams.size(),
+		  info->chunk_size,
+		  info->compression_mode,
+		  info->compression_level,
+		  info->chunks
+		);
+	}
+
+	std::vector<uint32_t> chunks;
+	chunks.reserve(info->chunks.size() * 2);
+	for (const BlobChunk& chunk : info->chunks)
+	{
+		chunks.push_back(chunk.offset);
+		chunks.push_back(chunk.size);
+	}
+
+	metadata["chunkSize"] = info->chunk_size;
+	metadata["chunks"]    = chunks;
+
+	metadata["splitVertexStreams"] = info->split_vertex_streams;
+
+	file.json = metadata.dump();
+
+	return file;
+}
+
+} // namespace Assets
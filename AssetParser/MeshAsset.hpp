@@ -0,0 +1,121 @@
+#pragma once
+
+#include "AssetParser.hpp"
+#include "ChunkedBlob.hpp"
+#include "VertexEncoding.hpp"
+
+#include <string_view>
+
+namespace Assets {
+
+/** Range of the index stream drawn with a single material */
+struct MeshPrimitive
+{
+	uint32_t first_index;
+	uint32_t index_count;
+	int32_t material_index;
+};
+
+struct MeshNode
+{
+	/** Index of the parent node, -1 for root nodes. Parents precede their children */
+	int32_t parent;
+
+	/** Column major local transform */
+	float transform[16];
+
+	std::vector<MeshPrimitive> primitives;
+};
+
+/** Indices into MeshInfo::textures, -1 if the material doesn't have the texture */
+struct MeshMaterial
+{
+	int32_t albedo_texture;
+	int32_t normal_texture;
+	int32_t metallic_roughness_texture;
+};
+
+struct MeshInfo
+{
+	uint64_t vertex_count;
+	uint64_t index_count;
+
+	/** 2 when every vertex is addressable with 16 bits, 4 otherwise */
+	uint32_t index_size = 4u;
+
+	/** Vertices are stored encoded, ready to be copied into the vertex buffers */
+	VertexEncoding vertex_encoding = {};
+
+	/** Every position precedes the rest of the attributes in the vertex stream,
+	 * false for meshes baked with interleaved vertices */
+	bool split_vertex_streams = false;
+
+	CompressionMode compression_mode;
+	std::string original_file;
+
+	std::vector<MeshNode> nodes;
+	std::vector<MeshMaterial> materials;
+
+	/** Baked texture paths, relative to the mesh asset */
+	std::vector<std::string> textures;
+
+	/** Bounds of every vertex, in model space */
+	MeshBounds bounds;
+
+	/** Chunk table of the blob, empty if it's uncompressed */
+	uint32_t chunk_size = 0u;
+	std::vector<BlobChunk> chunks;
+	int compression_level = 0;
+};
+
+MeshInfo read_mesh_info(AssetFile* file);
+MeshInfo read_mesh_info(std::string_view json);
+
+/** Size of the vertex stream, which starts the blob */
+size_t get_vertices_size(const MeshInfo* info);
+
+/** Size of the positions, which start the vertex stream & are followed by the
+ * rest of the attributes */
+size_t get_positions_size(const MeshInfo* info);
+
+/** Size of the index stream, which follows the vertex stream */
+size_t get_indices_size(const MeshInfo* info);
+
+/** Unpacks the vertex stream into @a destination, which has to hold
+ * get_vertices_size bytes
+ *
+ * @returns false if the blob is malformed or uses a codec that isn't compiled in
+ */
+bool unpack_mesh_vertices(
+  const MeshInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  void* destination
+);
+
+/** Unpacks the index stream into @a destination, which has to hold
+ * get_indices_size bytes. Indices are relative to the mesh's first vertex
+ *
+ * @returns false if the blob is malformed or uses a codec that isn't compiled in
+ */
+bool unpack_mesh_indices(
+  const MeshInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  void* destination
+);
+
+/** Packs the vertex & index streams with @a info's compression mode & level,
+ * @a vertices are encoded with @a info's vertex encoding, positions first, &
+ * @a indices are @a info's index size each
+ *
+ * @note Falls back to LZ4 if the requested codec isn't compiled in, @a info is
+ * updated to what the blob actually holds
+ */
+AssetFile pack_mesh(
+  MeshInfo* info,
+  const void* vertices,
+  const void* indices
+);
+
+} // namespace Assets
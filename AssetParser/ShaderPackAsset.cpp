@@ -0,0 +1,303 @@
+#include "ShaderPackAsset.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Assets {
+
+namespace {
+
+template<typename T>
+uint32_t append_pod(std::vector<uint8_t>& blob, const T* values, size_t count)
+{
+	const uint32_t offset = blob.size();
+	blob.resize(blob.size() + sizeof(T) * count);
+
+	if (count)
+		memcpy(blob.data() + offset, values, sizeof(T) * count);
+
+	return offset;
+}
+
+bool is_in_range(size_t file_size, uint64_t offset, uint64_t size)
+{
+	return offset <= file_size && size <= file_size - offset;
+}
+
+} // namespace
+
+bool save_shader_pack(const char* path, std::vector<ShaderInfo> shaders)
+{
+	std::sort(
+	  shaders.begin(),
+	  shaders.end(),
+	  [](const ShaderInfo& lhs, const ShaderInfo& rhs) {
+		  return hash_content(lhs.name.data(), lhs.name.size())
+		         < hash_content(rhs.name.data(), rhs.name.size());
+	  }
+	);
+
+	ShaderPackHeader header {
+		.magic                = shader_pack_magic,
+		.version              = shader_pack_version,
+		.shader_count         = static_cast<uint32_t>(shaders.size()),
+		.content_index_offset = 0u,
+	};
+
+	// header, entries and the content index first, they're patched once the
+	// offsets are known
+	std::vector<uint8_t> blob;
+	const uint32_t header_offset = append_pod(blob, &header, 1u);
+
+	std::vector<ShaderPackEntry> entries(shaders.size());
+	const uint32_t entries_offset = append_pod(
+	  blob,
+	  entries.data(),
+	  entries.size()
+	);
+
+	std::vector<ShaderPackContentIndex> content_index(shaders.size());
+	header.content_index_offset = append_pod(
+	  blob,
+	  content_index.data(),
+	  content_index.size()
+	);
+
+	std::vector<ShaderPackSpecializationConstant> specialization_constants;
+	std::vector<char> names;
+
+	for (size_t i = 0; i < shaders.size(); ++i)
+	{
+		const ShaderInfo& shader = shaders[i];
+		ShaderPackEntry& entry   = entries[i];
+
+		entry.name_hash    = hash_content(shader.name.data(), shader.name.size());
+		entry.content_hash = hash_content(
+		  shader.code.data(),
+		  shader.code.size() * sizeof(uint32_t)
+		);
+
+		content_index[i] = {
+			.content_hash = entry.content_hash,
+			.entry_index  = static_cast<uint32_t>(i),
+			._0           = 0u,
+		};
+
+		entry.name_offset = names.size();
+		entry.name_size   = shader.name.size();
+		names.insert(names.end(), shader.name.begin(), shader.name.end());
+
+		entry.stage                = shader.stage;
+		entry.push_constant_offset = shader.push_constant_offset;
+		entry.push_constant_size   = shader.push_constant_size;
+
+		entry.binding_count   = shader.bindings.size();
+		entry.bindings_offset = append_pod(
+		  blob,
+		  shader.bindings.data(),
+		  shader.bindings.size()
+		);
+
+		// name offsets are relative to the names table until it's placed
+		specialization_constants.clear();
+		for (const auto& specialization_constant : shader.specialization_constants)
+		{
+			specialization_constants.push_back({
+			  .constant_id = specialization_constant.constant_id,
+			  .name_offset = static_cast<uint32_t>(names.size()),
+			  .name_size = static_cast<uint32_t>(specialization_constant.name.size()),
+			  ._0        = 0u,
+			});
+
+			names.insert(
+			  names.end(),
+			  specialization_constant.name.begin(),
+			  specialization_constant.name.end()
+			);
+		}
+
+		entry.specialization_constant_count   = specialization_constants.size();
+		entry.specialization_constants_offset = append_pod(
+		  blob,
+		  specialization_constants.data(),
+		  specialization_constants.size()
+		);
+
+		entry.code_size   = shader.code.size() * sizeof(uint32_t);
+		entry.code_offset = append_pod(
+		  blob,
+		  shader.code.data(),
+		  shader.code.size()
+		);
+	}
+
+	const uint32_t names_offset = append_pod(blob, names.data(), names.size());
+
+	for (ShaderPackEntry& entry : entries)
+	{
+		entry.name_offset += names_offset;
+
+		auto* entry_specialization_constants =
+		  (ShaderPackSpecializationConstant*)(blob.data()
+		                                      + entry.specialization_constants_offset);
+
+		for (uint32_t i = 0; i < entry.specialization_constant_count; ++i)
+			entry_specialization_constants[i].name_offset += names_offset;
+	}
+
+	std::sort(
+	  content_index.begin(),
+	  content_index.end(),
+	  [](const ShaderPackContentIndex& lhs, const ShaderPackContentIndex& rhs) {
+		  return lhs.content_hash < rhs.content_hash;
+	  }
+	);
+
+	memcpy(blob.data() + header_offset, &header, sizeof(ShaderPackHeader));
+
+	memcpy(
+	  blob.data() + entries_offset,
+	  entries.data(),
+	  entries.size() * sizeof(ShaderPackEntry)
+	);
+
+	memcpy(
+	  blob.data() + header.content_index_offset,
+	  content_index.data(),
+	  content_index.size() * sizeof(ShaderPackContentIndex)
+	);
+
+	std::ofstream outstream(path, std::ios::binary | std::ios::out);
+	if (!outstream.is_open())
+		return false;
+
+	outstream.write((const char*)blob.data(), blob.size());
+	outstream.close();
+
+	return true;
+}
+
+bool ShaderPack::open(const char* path)
+{
+	if (!file.open(path))
+		return false;
+
+	if (!validate())
+	{
+		file.close();
+		return false;
+	}
+
+	return true;
+}
+
+const ShaderPackEntry* ShaderPack::find(std::string_view name) const
+{
+	const uint64_t name_hash = hash_content(name.data(), name.size());
+
+	const ShaderPackEntry* begin = get_entries();
+	const ShaderPackEntry* end   = begin + get_shader_count();
+
+	const ShaderPackEntry* entry = std::lower_bound(
+	  begin,
+	  end,
+	  name_hash,
+	  [](const ShaderPackEntry& entry, uint64_t hash) {
+		  return entry.name_hash < hash;
+	  }
+	);
+
+	if (entry == end || entry->name_hash != name_hash || get_name(entry) != name)
+		return nullptr;
+
+	return entry;
+}
+
+const ShaderPackEntry* ShaderPack::find_by_content_hash(uint64_t hash) const
+{
+	const ShaderPackContentIndex* begin = get_content_index();
+	const ShaderPackContentIndex* end   = begin + get_shader_count();
+
+	const ShaderPackContentIndex* index = std::lower_bound(
+	  begin,
+	  end,
+	  hash,
+	  [](const ShaderPackContentIndex& index, uint64_t hash) {
+		  return index.content_hash < hash;
+	  }
+	);
+
+	if (index == end || index->content_hash != hash)
+		return nullptr;
+
+	return &get_entries()[index->entry_index];
+}
+
+bool ShaderPack::validate() const
+{
+	const size_t file_size = file.size();
+
+	if (file_size < sizeof(ShaderPackHeader))
+		return false;
+
+	const ShaderPackHeader* header = get_header();
+	if (header->magic != shader_pack_magic)
+		return false;
+
+	if (header->version != shader_pack_version)
+		return false;
+
+	const uint64_t entries_size = uint64_t(header->shader_count)
+	                              * sizeof(ShaderPackEntry);
+
+	if (!is_in_range(file_size, sizeof(ShaderPackHeader), entries_size))
+		return false;
+
+	const uint64_t content_index_size = uint64_t(header->shader_count)
+	                                    * sizeof(ShaderPackContentIndex);
+
+	if (
+	  !is_in_range(file_size, header->content_index_offset, content_index_size)
+	  || header->content_index_offset % alignof(ShaderPackContentIndex)
+	)
+		return false;
+
+	const ShaderPackContentIndex* content_index = get_content_index();
+	for (uint32_t i = 0; i < header->shader_count; ++i)
+		if (content_index[i].entry_index >= header->shader_count)
+			return false;
+
+	const ShaderPackEntry* entries = get_entries();
+	for (uint32_t i = 0; i < header->shader_count; ++i)
+	{
+		const ShaderPackEntry& entry = entries[i];
+
+		const uint64_t bindings_size = uint64_t(entry.binding_count)
+		                               * sizeof(ShaderPackBinding);
+
+		const uint64_t specialization_constants_size =
+		  uint64_t(entry.specialization_constant_count)
+		  * sizeof(ShaderPackSpecializationConstant);
+
+		if (
+		  !is_in_range(file_size, entry.name_offset, entry.name_size)
+		  || !is_in_range(file_size, entry.code_offset, entry.code_size)
+		  || !is_in_range(file_size, entry.bindings_offset, bindings_size)
+		  || !is_in_range(
+		    file_size,
+		    entry.specialization_constants_offset,
+		    specialization_constants_size
+		  )
+		)
+			return false;
+
+		// spir-v is consumed straight from the mapping
+		if (entry.code_offset % sizeof(uint32_t) || entry.code_size % sizeof(uint32_t))
+			return false;
+	}
+
+	return true;
+}
+
+} // namespace Assets
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "AssetParser.hpp"
+#include "MappedFile.hpp"
+
+#include <string_view>
+
+namespace Assets {
+
+/** "BVSP" */
+constexpr uint32_t shader_pack_magic   = 0x50535642u;
+constexpr uint32_t shader_pack_version = 2u;
+
+struct ShaderPackHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t shader_count;
+	uint32_t content_index_offset;
+};
+
+/** Entry of the content index, a second table of shader_count records sorted
+ * by content_hash */
+struct ShaderPackContentIndex
+{
+	uint64_t content_hash;
+	uint32_t entry_index;
+	uint32_t _0;
+};
+
+/** Descriptor set slot 2 binding, enum values are the vulkan ones */
+struct ShaderPackBinding
+{
+	uint32_t binding;
+	uint32_t descriptor_type;
+	uint32_t descriptor_count;
+	uint32_t _0;
+};
+
+struct ShaderPackSpecializationConstant
+{
+	uint32_t constant_id;
+	uint32_t name_offset;
+	uint32_t name_size;
+	uint32_t _0;
+};
+
+/** Fixed size record of a shader, offsets are relative to the start of the
+ * pack. Entries are sorted by name_hash */
+struct ShaderPackEntry
+{
+	uint64_t name_hash;
+	uint64_t content_hash;
+
+	uint32_t name_offset;
+	uint32_t name_size;
+
+	uint32_t code_offset;
+	uint32_t code_size;
+
+	uint32_t stage;
+	uint32_t push_constant_offset;
+	uint32_t push_constant_size;
+
+	uint32_t bindings_offset;
+	uint32_t binding_count;
+
+	uint32_t specialization_constants_offset;
+	uint32_t specialization_constant_count;
+
+	uint32_t _0;
+};
+
+/** Input of save_shader_pack, filled by the shader packer */
+struct ShaderInfo
+{
+	struct SpecializationConstant
+	{
+		uint32_t constant_id;
+		std::string name;
+	};
+
+	std::string name;
+	std::vector<uint32_t> code;
+
+	uint32_t stage;
+	uint32_t push_constant_offset;
+	uint32_t push_constant_size;
+
+	std::vector<ShaderPackBinding> bindings;
+	std::vector<SpecializationConstant> specialization_constants;
+};
+
+bool save_shader_pack(const char* path, std::vector<ShaderInfo> shaders);
+
+/** Memory mapped shader pack, every accessor points into the mapping */
+class ShaderPack
+{
+public:
+	bool open(const char* path);
+
+	void close()
+	{
+		file.close();
+	}
+
+	bool is_open() const
+	{
+		return file.is_open();
+	}
+
+	/** Binary search by name hash, returns nullptr if not found */
+	const ShaderPackEntry* find(std::string_view name) const;
+
+	/** Binary search by content hash through the content index, returns
+	 * nullptr if not found */
+	const ShaderPackEntry* find_by_content_hash(uint64_t hash) const;
+
+	uint32_t get_shader_count() const
+	{
+		return get_header()->shader_count;
+	}
+
+	const ShaderPackEntry* get_entries() const
+	{
+		return (const ShaderPackEntry*)(file.data() + sizeof(ShaderPackHeader));
+	}
+
+	std::string_view get_name(const ShaderPackEntry* entry) const
+	{
+		return { (const char*)file.data() + entry->name_offset, entry->name_size };
+	}
+
+	std::string_view get_name(
+	  const ShaderPackSpecializationConstant* specialization_constant
+	) const
+	{
+		return {
+			(const char*)file.data() + specialization_constant->name_offset,
+			specialization_constant->name_size,
+		};
+	}
+
+	const uint32_t* get_code(const ShaderPackEntry* entry) const
+	{
+		return (const uint32_t*)(file.data() + entry->code_offset);
+	}
+
+	const ShaderPackBinding* get_bindings(const ShaderPackEntry* entry) const
+	{
+		return (const ShaderPackBinding*)(file.data() + entry->bindings_offset);
+	}
+
+	const ShaderPackSpecializationConstant* get_specialization_constants(
+	  const ShaderPackEntry* entry
+	) const
+	{
+		const uint8_t* data = file.data() + entry->specialization_constants_offset;
+		return (const ShaderPackSpecializationConstant*)data;
+	}
+
+private:
+	const ShaderPackHeader* get_header() const
+	{
+		return (const ShaderPackHeader*)file.data();
+	}
+
+	const ShaderPackContentIndex* get_content_index() const
+	{
+		const uint8_t* data = file.data() + get_header()->content_index_offset;
+		return (const ShaderPackContentIndex*)data;
+	}
+
+	bool validate() const;
+
+private:
+	MappedFile file = {};
+};
+
+} // namespace Assets
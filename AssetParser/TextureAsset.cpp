@@ -1,5 +1,6 @@
 #include "TextureAsset.hpp"
 
+#include <cstring>
 #include <lz4.h>
 #include <nlohmann/json.hpp>
 
@@ -9,9 +10,14 @@ using namespace nlohmann;
 
 TextureInfo read_texture_info(AssetFile* file)
 {
-	json texture_meta_data = json::parse(file->json);
+	return read_texture_info(std::string_view { file->json });
+}
+
+TextureInfo read_texture_info(std::string_view json_view)
+{
+	json texture_meta_data = json::parse(json_view);
 
-	return TextureInfo {
+	TextureInfo info {
 		.size            = texture_meta_data["bufferSize"],
 		.compression_mode = texture_meta_data["compression"],
 		.format          = texture_meta_data["format"],
@@ -22,60 +28,177 @@ TextureInfo read_texture_info(AssetFile* file)
         },
 		.original_file = texture_meta_data["originalFile"],
 	};
+
+	// Assets baked before mip chains were stored only contain the base level
+	info.mip_levels = texture_meta_data.value("mipLevels", 1u);
+	info.mip_sizes  = texture_meta_data.value(
+	  "mipSizes",
+	  std::vector<size_t> { info.size }
+	);
+
+	// Chunks are stored flattened as [offset, size, offset, size, ...]
+	info.chunk_size = texture_meta_data.value("chunkSize", 0u);
+	const std::vector<uint32_t> chunks = texture_meta_data.value(
+	  "chunks",
+	  std::vector<uint32_t> {}
+	);
+
+	for (size_t i = 0; i + 1 < chunks.size(); i += 2)
+		info.chunks.push_back({ chunks[i], chunks[i + 1] });
+
+	info.compression_level = texture_meta_data.value("compressionLevel", 0);
+
+	return info;
 }
 
-void unpack_texture(
+bool unpack_texture(
   TextureInfo* info,
   const void* source_buffer,
   size_t source_size,
   void* destination
 )
 {
-	if (info->compression_mode == CompressionMode::LZ4)
+	if (info->compression_mode == CompressionMode::None)
 	{
-		LZ4_decompress_safe(
-		  (const char*)source_buffer,
-		  (char*)destination,
+		if (source_size < info->size)
+			return false;
+
+		memcpy(destination, source_buffer, info->size);
+		return true;
+	}
+
+	if (!info->chunks.empty())
+	{
+		return decompress_chunked(
+		  source_buffer,
 		  source_size,
+		  info->chunks,
+		  info->chunk_size,
+		  info->compression_mode,
+		  destination,
 		  info->size
 		);
 	}
-	else
+
+	// Blobs baked before chunking are a single lz4 block
+	if (info->compression_mode != CompressionMode::LZ4)
+		return false;
+
+	const int decompressed_size = LZ4_decompress_safe(
+	  (const char*)source_buffer,
+	  (char*)destination,
+	  source_size,
+	  info->size
+	);
+
+	return decompressed_size >= 0 && (size_t)decompressed_size == info->size;
+}
+
+bool unpack_texture_range(
+  const TextureInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  size_t offset,
+  size_t size,
+  void* destination
+)
+{
+	if (info->compression_mode == CompressionMode::None)
 	{
-		memcpy(destination, source_buffer, source_size);
+		if (offset + size > source_size)
+			return false;
+
+		memcpy(destination, (const uint8_t*)source_buffer + offset, size);
+		return true;
 	}
+
+	if (info->chunks.empty())
+		return false;
+
+	return decompress_chunked_range(
+	  source_buffer,
+	  source_size,
+	  info->chunks,
+	  info->chunk_size,
+	  info->compression_mode,
+	  info->size,
+	  offset,
+	  size,
+	  destination
+	);
 }
 
 AssetFile pack_texture(TextureInfo* info, void* pixel_data)
 {
+	if (!is_compression_supported(info->compression_mode))
+	{
+		info->compression_mode  = CompressionMode::LZ4;
+		info->compression_level = 0;
+	}
+
 	json metadata;
-	metadata["format"]       = info->format;
-	metadata["width"]        = info->pixel_size[0];
-	metadata["height"]       = info->pixel_size[1];
-	metadata["bufferSize"]   = info->size;
-	metadata["originalFile"] = info->original_file;
-	metadata["compression"]  = CompressionMode::LZ4;
+	metadata["format"]           = info->format;
+	metadata["width"]            = info->pixel_size[0];
+	metadata["height"]           = info->pixel_size[1];
+	metadata["bufferSize"]       = info->size;
+	metadata["originalFile"]     = info->original_file;
+	metadata["compression"]      = info->compression_mode;
+	metadata["compressionLevel"] = info->compression_level;
+	metadata["mipLevels"]        = info->mip_levels;
+	metadata["mipSizes"]         = info->mip_sizes.empty()
+	                                 ? std::vector<size_t> { info->size }
+	                                 : info->mip_sizes;
 
 	AssetFile file;
 	file.type    = AssetFile::Type::Texture;
 	file.version = 1u;
 
-	const int compress_staging = LZ4_compressBound(info->size);
-	file.blob.resize(compress_staging);
-	const int compression_size = LZ4_compress_default(
-	  (const char*)pixel_data,
-	  (char*)file.blob.data(),
-	  info->size,
-	  compress_staging
-	);
-	file.blob.resize(compression_size);
+	if (info->compression_mode == CompressionMode::None)
+	{
+		const uint8_t* pixels = (const uint8_t*)pixel_data;
+		file.blob.assign(pixels, pixels + info->size);
 
+		info->chunk_size = 0u;
+		info->chunks.clear();
+	}
+	else
+	{
+		// Independent chunks, so the blob can be decompressed in parallel (or on
+		// the gpu) straight into its destination
+		info->chunk_size = default_chunk_size;
+		file.blob = compress_chunked(
+		  pixel_data,
+		  info->size,
+		  info->chunk_size,
+		  info->compression_mode,
+		  info->compression_level,
+		  info->chunks
+		);
+	}
+
+	std::vector<uint32_t> chunks;
+	chunks.reserve(info->chunks.size() * 2);
+	for (const BlobChunk& chunk : info->chunks)
+	{
+		chunks.push_back(chunk.offset);
+		chunks.push_back(chunk.size);
+	}
 
-	metadata["compression"] = CompressionMode::LZ4;
+	metadata["chunkSize"] = info->chunk_size;
+	metadata["chunks"]    = chunks;
 
 	file.json = metadata.dump();
 
 	return file;
 }
 
+size_t get_mip_offset(const TextureInfo* info, uint32_t mip_level)
+{
+	size_t offset = 0ull;
+	for (uint32_t i = 0; i < mip_level; ++i)
+		offset += info->mip_sizes[i];
+
+	return offset;
+}
+
 } // namespace Assets
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AssetParser.hpp"
+#include "ChunkedBlob.hpp"
 
 namespace Assets {
 
@@ -8,6 +9,11 @@ enum class TextureFormat
 {
 	None = 0,
 	RGBA8,
+
+	// Block-compressed, 4x4 texel blocks
+	BC1, // RGB, 8 bytes per block
+	BC5, // RG (normal maps), 16 bytes per block
+	BC7, // RGBA, 16 bytes per block
 };
 
 struct TextureInfo
@@ -17,17 +23,61 @@ struct TextureInfo
 	TextureFormat format;
 	uint32_t pixel_size[3];
 	std::string original_file;
+
+	/** Number of mip levels stored in the blob, 1 if only the base level is baked */
+	uint32_t mip_levels = 1u;
+
+	/** Uncompressed size of each mip level, levels are tightly packed in order */
+	std::vector<size_t> mip_sizes;
+
+	/** Chunk table of the blob, empty if it's uncompressed or a single LZ4 stream
+	 * (older assets) */
+	uint32_t chunk_size = 0u;
+	std::vector<BlobChunk> chunks;
+
+	/** Codec specific level the blob is compressed with, 0 is the codec's default
+	 * (see compress_chunked) */
+	int compression_level = 0;
 };
 
 TextureInfo read_texture_info(AssetFile* file);
+TextureInfo read_texture_info(std::string_view json);
 
-void unpack_texture(
+/** Unpacks the whole texture into @a destination, which has to hold
+ * @a info's size bytes
+ *
+ * @returns false if the blob is malformed or uses a codec that isn't compiled in
+ */
+bool unpack_texture(
   TextureInfo* info,
   const void* source_buffer,
   size_t source_size,
   void* destination
 );
 
+/** Unpacks [@a offset, @a offset + @a size) of the texture into @a destination
+ *
+ * @returns false if the compressed blob isn't chunked (it can only be unpacked
+ * as a whole), is malformed or uses a codec that isn't compiled in
+ */
+bool unpack_texture_range(
+  const TextureInfo* info,
+  const void* source_buffer,
+  size_t source_size,
+  size_t offset,
+  size_t size,
+  void* destination
+);
+
+/** Packs the texture with @a info's compression mode & level, chunks are
+ * compressed in parallel
+ *
+ * @note Falls back to LZ4 if the requested codec isn't compiled in, @a info is
+ * updated to what the blob actually holds
+ */
 AssetFile pack_texture(TextureInfo* info, void* pixel_data);
 
+/** Uncompressed offset of @a mip_level in the unpacked texture blob */
+size_t get_mip_offset(const TextureInfo* info, uint32_t mip_level);
+
 } // namespace Assets
@@ -0,0 +1,568 @@
+#include "TextureCompression.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <string.h>
+
+namespace Assets {
+
+namespace {
+
+constexpr uint32_t block_dimension = 4u;
+
+constexpr uint32_t bc7_weights[16] = {
+	0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64,
+};
+
+struct Block
+{
+	float texels[16][4];
+};
+
+Block fetch_block(
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height,
+  uint32_t block_x,
+  uint32_t block_y
+)
+{
+	Block block;
+
+	// Texels past the edge of the level clamp, they're never sampled anyways
+	for (uint32_t y = 0; y < block_dimension; ++y)
+	{
+		for (uint32_t x = 0; x < block_dimension; ++x)
+		{
+			const uint32_t px = std::min(block_x * block_dimension + x, width - 1);
+			const uint32_t py = std::min(block_y * block_dimension + y, height - 1);
+
+			const uint8_t* texel = pixels + (size_t(py) * width + px) * 4;
+			for (uint32_t c = 0; c < 4; ++c)
+				block.texels[y * block_dimension + x][c] = texel[c];
+		}
+	}
+
+	return block;
+}
+
+void store_block(
+  const uint8_t texels[16][4],
+  uint32_t width,
+  uint32_t height,
+  uint32_t block_x,
+  uint32_t block_y,
+  uint8_t* pixels
+)
+{
+	for (uint32_t y = 0; y < block_dimension; ++y)
+	{
+		for (uint32_t x = 0; x < block_dimension; ++x)
+		{
+			const uint32_t px = block_x * block_dimension + x;
+			const uint32_t py = block_y * block_dimension + y;
+
+			if (px < width && py < height)
+			{
+				memcpy(
+				  pixels + (size_t(py) * width + px) * 4,
+				  texels[y * block_dimension + x],
+				  4
+				);
+			}
+		}
+	}
+}
+
+void write_bits(uint8_t* out, uint32_t& offset, uint32_t value, uint32_t count)
+{
+	for (uint32_t bit = 0; bit < count; ++bit, ++offset)
+		if ((value >> bit) & 1u)
+			out[offset / 8] |= uint8_t(1u << (offset % 8));
+}
+
+uint32_t read_bits(const uint8_t* in, uint32_t& offset, uint32_t count)
+{
+	uint32_t value = 0;
+	for (uint32_t bit = 0; bit < count; ++bit, ++offset)
+		value |= ((in[offset / 8] >> (offset % 8)) & 1u) << bit;
+
+	return value;
+}
+
+/** Fits a line through the first @a channels channels of the block's texels
+ * (principal axis through the mean) and returns its extremes */
+void find_endpoints(
+  const Block& block,
+  uint32_t channels,
+  float out_min[4],
+  float out_max[4]
+)
+{
+	float mean[4] = {};
+	for (uint32_t i = 0; i < 16; ++i)
+		for (uint32_t c = 0; c < channels; ++c)
+			mean[c] += block.texels[i][c] / 16.0f;
+
+	float covariance[4][4] = {};
+	for (uint32_t i = 0; i < 16; ++i)
+		for (uint32_t a = 0; a < channels; ++a)
+			for (uint32_t b = 0; b < channels; ++b)
+				covariance[a][b] += (block.texels[i][a] - mean[a])
+				                    * (block.texels[i][b] - mean[b]);
+
+	// Power iteration converges to the dominant eigenvector quickly enough
+	float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	for (uint32_t iteration = 0; iteration < 8; ++iteration)
+	{
+		float next[4] = {};
+		for (uint32_t a = 0; a < channels; ++a)
+			for (uint32_t b = 0; b < channels; ++b)
+				next[a] += covariance[a][b] * axis[b];
+
+		float length = 0.0f;
+		for (uint32_t c = 0; c < channels; ++c)
+			length += next[c] * next[c];
+
+		if (length < FLT_EPSILON)
+			break;
+
+		length = std::sqrt(length);
+		for (uint32_t c = 0; c < channels; ++c)
+			axis[c] = next[c] / length;
+	}
+
+	float min_t = FLT_MAX;
+	float max_t = -FLT_MAX;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		float t = 0.0f;
+		for (uint32_t c = 0; c < channels; ++c)
+			t += (block.texels[i][c] - mean[c]) * axis[c];
+
+		min_t = std::min(min_t, t);
+		max_t = std::max(max_t, t);
+	}
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		out_min[c] = c < channels
+		               ? std::clamp(mean[c] + axis[c] * min_t, 0.0f, 255.0f)
+		               : 255.0f;
+		out_max[c] = c < channels
+		               ? std::clamp(mean[c] + axis[c] * max_t, 0.0f, 255.0f)
+		               : 255.0f;
+	}
+}
+
+uint32_t find_nearest(
+  const float texel[4],
+  const float palette[][4],
+  uint32_t palette_size,
+  uint32_t channels
+)
+{
+	uint32_t nearest    = 0;
+	float nearest_error = FLT_MAX;
+
+	for (uint32_t i = 0; i < palette_size; ++i)
+	{
+		float error = 0.0f;
+		for (uint32_t c = 0; c < channels; ++c)
+			error += (texel[c] - palette[i][c]) * (texel[c] - palette[i][c]);
+
+		if (error < nearest_error)
+		{
+			nearest       = i;
+			nearest_error = error;
+		}
+	}
+
+	return nearest;
+}
+
+uint16_t encode_565(const float color[4])
+{
+	const uint32_t r = uint32_t(color[0] * 31.0f / 255.0f + 0.5f);
+	const uint32_t g = uint32_t(color[1] * 63.0f / 255.0f + 0.5f);
+	const uint32_t b = uint32_t(color[2] * 31.0f / 255.0f + 0.5f);
+
+	return uint16_t((r << 11) | (g << 5) | b);
+}
+
+void decode_565(uint16_t value, float color[4])
+{
+	const uint32_t r = value >> 11;
+	const uint32_t g = (value >> 5) & 63u;
+	const uint32_t b = value & 31u;
+
+	color[0] = float((r << 3) | (r >> 2));
+	color[1] = float((g << 2) | (g >> 4));
+	color[2] = float((b << 3) | (b >> 2));
+	color[3] = 255.0f;
+}
+
+void create_bc1_palette(uint16_t c0, uint16_t c1, float palette[4][4])
+{
+	decode_565(c0, palette[0]);
+	decode_565(c1, palette[1]);
+
+	for (uint32_t c = 0; c < 3; ++c)
+	{
+		if (c0 > c1)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+		else
+		{
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+			palette[3][c] = 0.0f;
+		}
+	}
+
+	palette[2][3] = 255.0f;
+	palette[3][3] = 255.0f;
+}
+
+void encode_bc1(const Block& block, uint8_t* out)
+{
+	float low[4], high[4];
+	find_endpoints(block, 3, low, high);
+
+	uint16_t c0 = encode_565(high);
+	uint16_t c1 = encode_565(low);
+
+	// c0 > c1 selects the 4-color mode, equal endpoints only ever use index 0
+	if (c0 < c1)
+		std::swap(c0, c1);
+
+	uint32_t indices = 0;
+	if (c0 != c1)
+	{
+		float palette[4][4];
+		create_bc1_palette(c0, c1, palette);
+
+		for (uint32_t i = 0; i < 16; ++i)
+			indices |= find_nearest(block.texels[i], palette, 4, 3) << (i * 2);
+	}
+
+	memcpy(out, &c0, sizeof(uint16_t));
+	memcpy(out + 2, &c1, sizeof(uint16_t));
+	memcpy(out + 4, &indices, sizeof(uint32_t));
+}
+
+void decode_bc1(const uint8_t* in, uint8_t texels[16][4])
+{
+	uint16_t c0, c1;
+	uint32_t indices;
+	memcpy(&c0, in, sizeof(uint16_t));
+	memcpy(&c1, in + 2, sizeof(uint16_t));
+	memcpy(&indices, in + 4, sizeof(uint32_t));
+
+	float palette[4][4];
+	create_bc1_palette(c0, c1, palette);
+
+	for (uint32_t i = 0; i < 16; ++i)
+		for (uint32_t c = 0; c < 4; ++c)
+			texels[i][c] = uint8_t(palette[(indices >> (i * 2)) & 3u][c] + 0.5f);
+}
+
+void encode_bc4(const Block& block, uint32_t channel, uint8_t* out)
+{
+	float low  = 255.0f;
+	float high = 0.0f;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		low  = std::min(low, block.texels[i][channel]);
+		high = std::max(high, block.texels[i][channel]);
+	}
+
+	const uint8_t r0 = uint8_t(high + 0.5f);
+	const uint8_t r1 = uint8_t(low + 0.5f);
+
+	uint64_t bits = uint64_t(r0) | (uint64_t(r1) << 8);
+
+	// r0 > r1 selects the 8-value mode: index 0 -> r0, 1 -> r1 & 2..7 -> lerp
+	if (r0 > r1)
+	{
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			const float t = (block.texels[i][channel] - r1) * 7.0f / (r0 - r1);
+			const uint32_t step = std::clamp(uint32_t(t + 0.5f), 0u, 7u);
+
+			const uint32_t index = step == 7u ? 0u : step == 0u ? 1u : 8u - step;
+			bits |= uint64_t(index) << (16 + i * 3);
+		}
+	}
+
+	memcpy(out, &bits, sizeof(uint64_t));
+}
+
+void decode_bc4(const uint8_t* in, uint32_t channel, uint8_t texels[16][4])
+{
+	uint64_t bits;
+	memcpy(&bits, in, sizeof(uint64_t));
+
+	const uint32_t r0 = bits & 0xffu;
+	const uint32_t r1 = (bits >> 8) & 0xffu;
+
+	uint8_t palette[8] = { uint8_t(r0), uint8_t(r1) };
+	if (r0 > r1)
+	{
+		for (uint32_t i = 2; i < 8; ++i)
+			palette[i] = uint8_t(((8 - i) * r0 + (i - 1) * r1 + 3) / 7);
+	}
+	else
+	{
+		for (uint32_t i = 2; i < 6; ++i)
+			palette[i] = uint8_t(((6 - i) * r0 + (i - 1) * r1 + 2) / 5);
+
+		palette[6] = 0u;
+		palette[7] = 255u;
+	}
+
+	for (uint32_t i = 0; i < 16; ++i)
+		texels[i][channel] = palette[(bits >> (16 + i * 3)) & 7u];
+}
+
+/** Quantizes an endpoint to 7 bits per channel plus a shared p-bit */
+void quantize_bc7_endpoint(
+  const float endpoint[4],
+  uint8_t out[4],
+  uint32_t& out_pbit
+)
+{
+	float best_error = FLT_MAX;
+
+	for (uint32_t pbit = 0; pbit < 2; ++pbit)
+	{
+		uint8_t quantized[4];
+		float error = 0.0f;
+
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			const float q = std::round((endpoint[c] - pbit) / 2.0f);
+			quantized[c]  = uint8_t(std::clamp(q, 0.0f, 127.0f));
+
+			const float value = float((quantized[c] << 1) | pbit);
+			error += (value - endpoint[c]) * (value - endpoint[c]);
+		}
+
+		if (error < best_error)
+		{
+			best_error = error;
+			out_pbit   = pbit;
+			for (uint32_t c = 0; c < 4; ++c)
+				out[c] = uint8_t((quantized[c] << 1) | pbit);
+		}
+	}
+}
+
+void encode_bc7(const Block& block, uint8_t* out)
+{
+	float low[4], high[4];
+	find_endpoints(block, 4, low, high);
+
+	uint8_t endpoints[2][4];
+	uint32_t pbits[2];
+	quantize_bc7_endpoint(low, endpoints[0], pbits[0]);
+	quantize_bc7_endpoint(high, endpoints[1], pbits[1]);
+
+	float palette[16][4];
+	for (uint32_t w = 0; w < 16; ++w)
+		for (uint32_t c = 0; c < 4; ++c)
+			palette[w][c] = float(
+			  ((64 - bc7_weights[w]) * endpoints[0][c]
+			   + bc7_weights[w] * endpoints[1][c] + 32)
+			  >> 6
+			);
+
+	uint32_t indices[16];
+	for (uint32_t i = 0; i < 16; ++i)
+		indices[i] = find_nearest(block.texels[i], palette, 16, 4);
+
+	// The anchor index's msb is implicitly 0, swap the endpoints if it's set
+	if (indices[0] & 8u)
+	{
+		std::swap(endpoints[0], endpoints[1]);
+		std::swap(pbits[0], pbits[1]);
+
+		for (uint32_t i = 0; i < 16; ++i)
+			indices[i] = 15u - indices[i];
+	}
+
+	memset(out, 0, 16);
+
+	uint32_t offset = 0;
+	write_bits(out, offset, 1u << 6, 7);
+
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		write_bits(out, offset, endpoints[0][c] >> 1, 7);
+		write_bits(out, offset, endpoints[1][c] >> 1, 7);
+	}
+
+	write_bits(out, offset, pbits[0], 1);
+	write_bits(out, offset, pbits[1], 1);
+
+	write_bits(out, offset, indices[0], 3);
+	for (uint32_t i = 1; i < 16; ++i)
+		write_bits(out, offset, indices[i], 4);
+}
+
+bool decode_bc7(const uint8_t* in, uint8_t texels[16][4])
+{
+	// Only mode 6 (6 zero bits followed by a set bit) is emitted by the baker
+	if ((in[0] & 0x7fu) != 0x40u)
+		return false;
+
+	uint32_t offset = 7;
+
+	uint32_t endpoints[2][4];
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		endpoints[0][c] = read_bits(in, offset, 7) << 1;
+		endpoints[1][c] = read_bits(in, offset, 7) << 1;
+	}
+
+	const uint32_t pbit0 = read_bits(in, offset, 1);
+	const uint32_t pbit1 = read_bits(in, offset, 1);
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		endpoints[0][c] |= pbit0;
+		endpoints[1][c] |= pbit1;
+	}
+
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		const uint32_t weight = bc7_weights[read_bits(in, offset, i == 0 ? 3 : 4)];
+
+		for (uint32_t c = 0; c < 4; ++c)
+			texels[i][c] = uint8_t(
+			  ((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32)
+			  >> 6
+			);
+	}
+
+	return true;
+}
+
+} // namespace
+
+bool is_block_compressed(TextureFormat format)
+{
+	return format == TextureFormat::BC1 || format == TextureFormat::BC5
+	       || format == TextureFormat::BC7;
+}
+
+size_t get_block_size(TextureFormat format)
+{
+	switch (format)
+	{
+	case TextureFormat::RGBA8: return 4u;
+	case TextureFormat::BC1: return 8u;
+	case TextureFormat::BC5: return 16u;
+	case TextureFormat::BC7: return 16u;
+	default: return 0u;
+	}
+}
+
+size_t get_level_size(TextureFormat format, uint32_t width, uint32_t height)
+{
+	if (!is_block_compressed(format))
+		return size_t(width) * height * get_block_size(format);
+
+	const size_t blocks_x = (width + block_dimension - 1) / block_dimension;
+	const size_t blocks_y = (height + block_dimension - 1) / block_dimension;
+
+	return blocks_x * blocks_y * get_block_size(format);
+}
+
+std::vector<uint8_t> compress_level(
+  TextureFormat format,
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height
+)
+{
+	std::vector<uint8_t> blocks(get_level_size(format, width, height));
+
+	const uint32_t blocks_x = (width + block_dimension - 1) / block_dimension;
+	const uint32_t blocks_y = (height + block_dimension - 1) / block_dimension;
+	const size_t block_size = get_block_size(format);
+
+	for (uint32_t y = 0; y < blocks_y; ++y)
+	{
+		for (uint32_t x = 0; x < blocks_x; ++x)
+		{
+			const Block block = fetch_block(pixels, width, height, x, y);
+			uint8_t* out      = blocks.data() + (size_t(y) * blocks_x + x) * block_size;
+
+			switch (format)
+			{
+			case TextureFormat::BC1: encode_bc1(block, out); break;
+			case TextureFormat::BC7: encode_bc7(block, out); break;
+			case TextureFormat::BC5:
+				encode_bc4(block, 0, out);
+				encode_bc4(block, 1, out + 8);
+				break;
+			default: break;
+			}
+		}
+	}
+
+	return blocks;
+}
+
+bool decompress_level(
+  TextureFormat format,
+  const uint8_t* blocks,
+  uint32_t width,
+  uint32_t height,
+  uint8_t* pixels
+)
+{
+	const uint32_t blocks_x = (width + block_dimension - 1) / block_dimension;
+	const uint32_t blocks_y = (height + block_dimension - 1) / block_dimension;
+	const size_t block_size = get_block_size(format);
+
+	for (uint32_t y = 0; y < blocks_y; ++y)
+	{
+		for (uint32_t x = 0; x < blocks_x; ++x)
+		{
+			const uint8_t* in = blocks + (size_t(y) * blocks_x + x) * block_size;
+			uint8_t texels[16][4];
+
+			switch (format)
+			{
+			case TextureFormat::BC1: decode_bc1(in, texels); break;
+
+			case TextureFormat::BC7:
+				if (!decode_bc7(in, texels))
+					return false;
+				break;
+
+			case TextureFormat::BC5:
+				for (uint32_t i = 0; i < 16; ++i)
+				{
+					texels[i][2] = 0u;
+					texels[i][3] = 255u;
+				}
+
+				decode_bc4(in, 0, texels);
+				decode_bc4(in + 8, 1, texels);
+				break;
+
+			default: return false;
+			}
+
+			store_block(texels, width, height, x, y, pixels);
+		}
+	}
+
+	return true;
+}
+
+} // namespace Assets
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "TextureAsset.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Assets {
+
+bool is_block_compressed(TextureFormat format);
+
+/** Size of a 4x4 block for compressed formats, size of a texel otherwise */
+size_t get_block_size(TextureFormat format);
+
+/** Size of a single @a width x @a height level, compressed formats round the
+ * dimensions up to whole blocks */
+size_t get_level_size(TextureFormat format, uint32_t width, uint32_t height);
+
+/** Encodes a level of RGBA8 @a pixels to a block-compressed @a format
+ *
+ * BC1 ignores alpha, BC5 only keeps the red & green channels and BC7 only
+ * emits mode 6 blocks (single subset RGBA with 4-bit indices).
+ */
+std::vector<uint8_t> compress_level(
+  TextureFormat format,
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height
+);
+
+/** Decodes a block-compressed level back to RGBA8, used when the device
+ * can't sample @a format natively
+ *
+ * @returns false if @a blocks contain an encoding that isn't supported
+ */
+bool decompress_level(
+  TextureFormat format,
+  const uint8_t* blocks,
+  uint32_t width,
+  uint32_t height,
+  uint8_t* pixels
+);
+
+} // namespace Assets
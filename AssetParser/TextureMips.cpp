@@ -0,0 +1,92 @@
+#include "TextureMips.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Assets {
+
+namespace {
+
+float srgb_to_linear(uint8_t value)
+{
+	const float c = value / 255.0f;
+
+	return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+uint8_t linear_to_srgb(float value)
+{
+	const float c = value <= 0.0031308f
+	                  ? value * 12.92f
+	                  : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+
+	return static_cast<uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+std::vector<uint8_t> generate_mip_chain(
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height,
+  bool srgb,
+  std::vector<size_t>& mip_sizes
+)
+{
+	const uint32_t mip_levels = std::floor(std::log2(std::max(width, height))) + 1;
+
+	std::vector<uint8_t> chain(pixels, pixels + size_t(width) * height * 4);
+	mip_sizes = { chain.size() };
+
+	std::vector<float> level(size_t(width) * height * 4);
+	for (size_t i = 0; i < level.size(); ++i)
+		level[i] = !srgb || i % 4 == 3 ? pixels[i] / 255.0f
+		                               : srgb_to_linear(pixels[i]);
+
+	for (uint32_t mip = 1; mip < mip_levels; ++mip)
+	{
+		const uint32_t src_width  = width;
+		const uint32_t src_height = height;
+		width                     = std::max(width / 2u, 1u);
+		height                    = std::max(height / 2u, 1u);
+
+		std::vector<float> next(size_t(width) * height * 4);
+		for (uint32_t y = 0; y < height; ++y)
+		{
+			const uint32_t y0 = std::min(y * 2u, src_height - 1u);
+			const uint32_t y1 = std::min(y * 2u + 1u, src_height - 1u);
+
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2u, src_width - 1u);
+				const uint32_t x1 = std::min(x * 2u + 1u, src_width - 1u);
+
+				for (uint32_t c = 0; c < 4; ++c)
+				{
+					next[(size_t(y) * width + x) * 4 + c] =
+					  (level[(size_t(y0) * src_width + x0) * 4 + c]
+					   + level[(size_t(y0) * src_width + x1) * 4 + c]
+					   + level[(size_t(y1) * src_width + x0) * 4 + c]
+					   + level[(size_t(y1) * src_width + x1) * 4 + c])
+					  * 0.25f;
+				}
+			}
+		}
+
+		const size_t offset = chain.size();
+		chain.resize(offset + next.size());
+		for (size_t i = 0; i < next.size(); ++i)
+		{
+			chain[offset + i] = !srgb || i % 4 == 3
+			                      ? uint8_t(next[i] * 255.0f + 0.5f)
+			                      : linear_to_srgb(next[i]);
+		}
+
+		mip_sizes.push_back(next.size());
+		level = std::move(next);
+	}
+
+	return chain;
+}
+
+} // namespace Assets
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Assets {
+
+/** Generates the full mip chain of an RGBA8 image
+ *
+ * Levels are filtered in linear space from the previous full-precision level
+ * (rather than the quantized one) to avoid darkening & banding down the chain,
+ * alpha (and every channel of non-srgb images) is filtered as-is. Odd
+ * dimensions clamp the 2x2 box at the edge.
+ *
+ * @returns Tightly packed levels, starting with a copy of the base level
+ */
+std::vector<uint8_t> generate_mip_chain(
+  const uint8_t* pixels,
+  uint32_t width,
+  uint32_t height,
+  bool srgb,
+  std::vector<size_t>& mip_sizes
+);
+
+} // namespace Assets
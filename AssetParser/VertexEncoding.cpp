@@ -0,0 +1,503 @@
+#include "VertexEncoding.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Assets {
+
+namespace {
+
+struct AttributeFormat
+{
+	uint32_t size;
+	uint32_t component_size;
+};
+
+AttributeFormat get_position_format(PositionEncoding encoding)
+{
+	// 16-bit positions are padded to 4 components, 3 component 16-bit formats are barely supported
+	switch (encoding)
+	{
+	case PositionEncoding::Half:
+	case PositionEncoding::Unorm16: return { 8u, 2u };
+	default: return { 12u, 4u };
+	}
+}
+
+AttributeFormat get_direction_format(DirectionEncoding encoding)
+{
+	switch (encoding)
+	{
+	case DirectionEncoding::OctahedralSnorm16: return { 4u, 2u };
+	case DirectionEncoding::OctahedralSnorm8: return { 2u, 1u };
+	default: return { 12u, 4u };
+	}
+}
+
+AttributeFormat get_uv_format(UvEncoding encoding)
+{
+	return encoding == UvEncoding::Half ? AttributeFormat { 4u, 2u } : AttributeFormat { 8u, 4u };
+}
+
+uint32_t align_up(uint32_t value, uint32_t alignment)
+{
+	return (value + alignment - 1u) / alignment * alignment;
+}
+
+/** @returns The offset of the attribute & moves @a offset past it */
+uint32_t place_attribute(uint32_t& offset, AttributeFormat format)
+{
+	offset                   = align_up(offset, format.component_size);
+	const uint32_t attribute = offset;
+	offset += format.size;
+
+	return attribute;
+}
+
+float get_length(const float vector[3])
+{
+	return std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+}
+
+void normalize(float vector[3])
+{
+	const float length = get_length(vector);
+	if (length > 0.0f)
+		for (uint32_t i = 0; i < 3; ++i)
+			vector[i] /= length;
+}
+
+/** Projects @a direction onto the octahedron & unfolds its lower half over the
+ * corners, @a encoded is in [-1, 1] */
+void encode_octahedral(const float direction[3], float encoded[2])
+{
+	const float length = std::abs(direction[0]) + std::abs(direction[1]) + std::abs(direction[2]);
+	if (length == 0.0f)
+	{
+		encoded[0] = 0.0f;
+		encoded[1] = 0.0f;
+		return;
+	}
+
+	const float x = direction[0] / length;
+	const float y = direction[1] / length;
+
+	encoded[0] = direction[2] >= 0.0f ? x : (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+	encoded[1] = direction[2] >= 0.0f ? y : (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+}
+
+/** Mirrors decode_direction of vertex.glsl */
+void decode_octahedral(float x, float y, float direction[3])
+{
+	const float z = 1.0f - std::abs(x) - std::abs(y);
+	const float t = std::max(-z, 0.0f);
+
+	direction[0] = x + (x >= 0.0f ? -t : t);
+	direction[1] = y + (y >= 0.0f ? -t : t);
+	direction[2] = z;
+
+	normalize(direction);
+}
+
+/** Vulkan's snorm to float conversion */
+float snorm_to_float(int32_t value, int32_t max_value)
+{
+	return std::max((float)value / (float)max_value, -1.0f);
+}
+
+/** Rounding each component to the nearest step isn't the closest encoding on
+ * the sphere, so every combination of rounding down & up is decoded & the
+ * closest one to @a direction is kept */
+void quantize_octahedral(const float direction[3], int32_t max_value, int32_t quantized[2])
+{
+	float encoded[2];
+	encode_octahedral(direction, encoded);
+
+	const int32_t x = (int32_t)std::floor(encoded[0] * max_value);
+	const int32_t y = (int32_t)std::floor(encoded[1] * max_value);
+
+	float closest_dot = -INFINITY;
+	for (int32_t i = 0; i < 4; ++i)
+	{
+		const int32_t candidate_x = std::clamp(x + (i & 1), -max_value, max_value);
+		const int32_t candidate_y = std::clamp(y + (i >> 1), -max_value, max_value);
+
+		float decoded[3];
+		decode_octahedral(
+		  snorm_to_float(candidate_x, max_value),
+		  snorm_to_float(candidate_y, max_value),
+		  decoded
+		);
+
+		const float dot = decoded[0] * direction[0] + decoded[1] * direction[1]
+		                  + decoded[2] * direction[2];
+
+		if (dot > closest_dot)
+		{
+			closest_dot  = dot;
+			quantized[0] = candidate_x;
+			quantized[1] = candidate_y;
+		}
+	}
+}
+
+void encode_position(
+  PositionEncoding encoding,
+  const PositionDequantization& dequantization,
+  const float position[3],
+  uint8_t* destination
+)
+{
+	uint16_t components[4] = {};
+
+	switch (encoding)
+	{
+	case PositionEncoding::Float: memcpy(destination, position, 3u * sizeof(float)); return;
+
+	case PositionEncoding::Half:
+		for (uint32_t i = 0; i < 3; ++i)
+			components[i] = float_to_half(position[i]);
+		break;
+
+	case PositionEncoding::Unorm16:
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const float scale      = dequantization.scale[i];
+			const float normalized = scale > 0.0f ? (position[i] - dequantization.offset[i]) / scale
+			                                      : 0.0f;
+
+			components[i] = (uint16_t)std::lround(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f);
+		}
+		break;
+	}
+
+	memcpy(destination, components, sizeof(components));
+}
+
+void decode_position(
+  PositionEncoding encoding,
+  const PositionDequantization& dequantization,
+  const uint8_t* source,
+  float position[3]
+)
+{
+	if (encoding == PositionEncoding::Float)
+	{
+		memcpy(position, source, 3u * sizeof(float));
+		return;
+	}
+
+	uint16_t components[4];
+	memcpy(components, source, sizeof(components));
+
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		const float value = encoding == PositionEncoding::Half ? half_to_float(components[i])
+		                                                       : components[i] / 65535.0f;
+
+		position[i] = dequantization.offset[i] + value * dequantization.scale[i];
+	}
+}
+
+void encode_direction(DirectionEncoding encoding, const float direction[3], uint8_t* destination)
+{
+	int32_t quantized[2];
+
+	switch (encoding)
+	{
+	case DirectionEncoding::Float: memcpy(destination, direction, 3u * sizeof(float)); break;
+
+	case DirectionEncoding::OctahedralSnorm16:
+	{
+		quantize_octahedral(direction, 32767, quantized);
+
+		const int16_t components[2] = { (int16_t)quantized[0], (int16_t)quantized[1] };
+		memcpy(destination, components, sizeof(components));
+		break;
+	}
+
+	case DirectionEncoding::OctahedralSnorm8:
+	{
+		quantize_octahedral(direction, 127, quantized);
+
+		const int8_t components[2] = { (int8_t)quantized[0], (int8_t)quantized[1] };
+		memcpy(destination, components, sizeof(components));
+		break;
+	}
+	}
+}
+
+void decode_direction(DirectionEncoding encoding, const uint8_t* source, float direction[3])
+{
+	switch (encoding)
+	{
+	case DirectionEncoding::Float:
+		memcpy(direction, source, 3u * sizeof(float));
+		normalize(direction);
+		break;
+
+	case DirectionEncoding::OctahedralSnorm16:
+	{
+		int16_t components[2];
+		memcpy(components, source, sizeof(components));
+
+		decode_octahedral(
+		  snorm_to_float(components[0], 32767),
+		  snorm_to_float(components[1], 32767),
+		  direction
+		);
+		break;
+	}
+
+	case DirectionEncoding::OctahedralSnorm8:
+	{
+		int8_t components[2];
+		memcpy(components, source, sizeof(components));
+
+		decode_octahedral(
+		  snorm_to_float(components[0], 127),
+		  snorm_to_float(components[1], 127),
+		  direction
+		);
+		break;
+	}
+	}
+}
+
+/** @returns The angle between the directions in degrees, through atan2 since
+ * acos loses most of its precision for the small angles measured here */
+float get_angle(const float a[3], const float b[3])
+{
+	const float cross[3] = {
+		a[1] * b[2] - a[2] * b[1],
+		a[2] * b[0] - a[0] * b[2],
+		a[0] * b[1] - a[1] * b[0],
+	};
+
+	const float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	return std::atan2(get_length(cross), dot) * (180.0f / 3.14159265f);
+}
+
+} // namespace
+
+VertexLayout get_vertex_layout(VertexEncoding encoding)
+{
+	uint32_t offset = 0u;
+
+	VertexLayout layout;
+	layout.position_stride  = align_up(get_position_format(encoding.position).size, 4u);
+	layout.normal_offset    = place_attribute(offset, get_direction_format(encoding.direction));
+	layout.tangent_offset   = place_attribute(offset, get_direction_format(encoding.direction));
+	layout.uv_offset        = place_attribute(offset, get_uv_format(encoding.uv));
+	layout.attribute_stride = align_up(offset, 4u);
+
+	return layout;
+}
+
+PositionDequantization get_position_dequantization(
+  PositionEncoding encoding,
+  const MeshBounds& bounds
+)
+{
+	if (encoding != PositionEncoding::Unorm16)
+		return { { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+
+	return {
+		{ bounds.min[0], bounds.min[1], bounds.min[2] },
+		{
+		  bounds.max[0] - bounds.min[0],
+		  bounds.max[1] - bounds.min[1],
+		  bounds.max[2] - bounds.min[2],
+		},
+	};
+}
+
+void encode_vertices(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const MeshVertex* vertices,
+  size_t count,
+  void* positions,
+  void* attributes
+)
+{
+	const VertexLayout layout = get_vertex_layout(encoding);
+	const PositionDequantization dequantization = get_position_dequantization(
+	  encoding.position,
+	  bounds
+	);
+
+	// Padding is zeroed so baked streams don't depend on what the memory held
+	uint8_t* encoded_positions  = (uint8_t*)positions;
+	uint8_t* encoded_attributes = (uint8_t*)attributes;
+	memset(encoded_positions, 0, count * layout.position_stride);
+	memset(encoded_attributes, 0, count * layout.attribute_stride);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const MeshVertex& vertex = vertices[i];
+		uint8_t* attribute       = encoded_attributes + i * layout.attribute_stride;
+
+		encode_position(
+		  encoding.position,
+		  dequantization,
+		  vertex.position,
+		  encoded_positions + i * layout.position_stride
+		);
+
+		encode_direction(encoding.direction, vertex.normal, attribute + layout.normal_offset);
+		encode_direction(encoding.direction, vertex.tangent, attribute + layout.tangent_offset);
+
+		if (encoding.uv == UvEncoding::Half)
+		{
+			const uint16_t uv[2] = { float_to_half(vertex.uv[0]), float_to_half(vertex.uv[1]) };
+			memcpy(attribute + layout.uv_offset, uv, sizeof(uv));
+		}
+		else
+		{
+			memcpy(attribute + layout.uv_offset, vertex.uv, sizeof(vertex.uv));
+		}
+	}
+}
+
+MeshVertex decode_vertex(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const void* positions,
+  const void* attributes,
+  size_t index
+)
+{
+	const VertexLayout layout = get_vertex_layout(encoding);
+	const uint8_t* attribute  = (const uint8_t*)attributes + index * layout.attribute_stride;
+
+	MeshVertex vertex;
+	decode_position(
+	  encoding.position,
+	  get_position_dequantization(encoding.position, bounds),
+	  (const uint8_t*)positions + index * layout.position_stride,
+	  vertex.position
+	);
+
+	decode_direction(encoding.direction, attribute + layout.normal_offset, vertex.normal);
+	decode_direction(encoding.direction, attribute + layout.tangent_offset, vertex.tangent);
+
+	if (encoding.uv == UvEncoding::Half)
+	{
+		uint16_t uv[2];
+		memcpy(uv, attribute + layout.uv_offset, sizeof(uv));
+
+		vertex.uv[0] = half_to_float(uv[0]);
+		vertex.uv[1] = half_to_float(uv[1]);
+	}
+	else
+	{
+		memcpy(vertex.uv, attribute + layout.uv_offset, sizeof(vertex.uv));
+	}
+
+	return vertex;
+}
+
+VertexEncodingError measure_encoding_error(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const MeshVertex* vertices,
+  size_t count,
+  const void* positions,
+  const void* attributes
+)
+{
+	VertexEncodingError error = {};
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const MeshVertex& original = vertices[i];
+		const MeshVertex decoded   = decode_vertex(encoding, bounds, positions, attributes, i);
+
+		const float offset[3] = {
+			decoded.position[0] - original.position[0],
+			decoded.position[1] - original.position[1],
+			decoded.position[2] - original.position[2],
+		};
+		error.position = std::max(error.position, get_length(offset));
+
+		if (get_length(original.normal) > 0.0f)
+			error.normal = std::max(error.normal, get_angle(original.normal, decoded.normal));
+
+		if (get_length(original.tangent) > 0.0f)
+			error.tangent = std::max(error.tangent, get_angle(original.tangent, decoded.tangent));
+
+		for (uint32_t c = 0; c < 2; ++c)
+			error.uv = std::max(error.uv, std::abs(decoded.uv[c] - original.uv[c]));
+	}
+
+	return error;
+}
+
+uint16_t float_to_half(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	const uint16_t sign      = (bits >> 16u) & 0x8000u;
+	const uint32_t magnitude = bits & 0x7fffffffu;
+
+	// NaNs stay NaNs, infinities stay infinite & finite values past the largest
+	// half are clamped to it
+	if (magnitude > 0x7f800000u)
+		return sign | 0x7e00u;
+
+	if (magnitude >= 0x477ff000u)
+		return sign | (magnitude == 0x7f800000u ? 0x7c00u : 0x7bffu);
+
+	// Normal halves, the exponent is rebiased & the mantissa rounded to nearest even
+	if (magnitude >= 0x38800000u)
+	{
+		uint32_t rebiased = magnitude - 0x38000000u;
+		rebiased += 0x0fffu + ((rebiased >> 13u) & 1u);
+
+		return sign | (uint16_t)(rebiased >> 13u);
+	}
+
+	// Subnormal halves, half of the smallest one & below round to zero
+	if (magnitude <= 0x33000000u)
+		return sign;
+
+	const uint32_t exponent = magnitude >> 23u;
+	const uint32_t mantissa = (magnitude & 0x7fffffu) | 0x800000u;
+	const uint32_t shift    = 126u - exponent;
+
+	uint32_t half_mantissa   = mantissa >> shift;
+	const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+	const uint32_t halfway   = 1u << (shift - 1u);
+
+	if (remainder > halfway || (remainder == halfway && (half_mantissa & 1u)))
+		++half_mantissa;
+
+	return sign | (uint16_t)half_mantissa;
+}
+
+float half_to_float(uint16_t value)
+{
+	const uint32_t sign     = (uint32_t)(value & 0x8000u) << 16u;
+	const uint32_t exponent = (value >> 10u) & 0x1fu;
+	const uint32_t mantissa = value & 0x3ffu;
+
+	if (!exponent)
+	{
+		const float subnormal = std::ldexp((float)mantissa, -24);
+		return sign ? -subnormal : subnormal;
+	}
+
+	const uint32_t bits = exponent == 0x1fu
+	                        ? sign | 0x7f800000u | (mantissa << 13u)
+	                        : sign | ((exponent + 112u) << 23u) | (mantissa << 13u);
+
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+
+	return result;
+}
+
+} // namespace Assets
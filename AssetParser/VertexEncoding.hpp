@@ -0,0 +1,150 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Assets {
+
+/** Full precision vertex, laid out like BindlessVk's Model::Vertex. It's what
+ * vertices are encoded from & what the float encoding stores as-is */
+struct MeshVertex
+{
+	float position[3];
+	float normal[3];
+	float tangent[3];
+	float uv[2];
+};
+
+struct MeshBounds
+{
+	float min[3];
+	float max[3];
+};
+
+enum class PositionEncoding : uint32_t
+{
+	Float,
+
+	/** 16-bit floats, the error grows with the distance from the origin */
+	Half,
+
+	/** 16-bit fixed point relative to the mesh bounds, the error is uniform
+	 * across the mesh & 1/65535th of its extent at most */
+	Unorm16,
+};
+
+/** Normals & tangents are unit vectors, octahedral encodings fold them into
+ * two components */
+enum class DirectionEncoding : uint32_t
+{
+	Float,
+	OctahedralSnorm16,
+	OctahedralSnorm8,
+};
+
+enum class UvEncoding : uint32_t
+{
+	Float,
+	Half,
+};
+
+/** How each attribute of a vertex is stored, the default is full precision */
+struct VertexEncoding
+{
+	PositionEncoding position   = PositionEncoding::Float;
+	DirectionEncoding direction = DirectionEncoding::Float;
+	UvEncoding uv               = UvEncoding::Float;
+
+	bool operator==(const VertexEncoding&) const = default;
+};
+
+/** 20 bytes per vertex rather than 44, well below a texel of error for most meshes */
+constexpr VertexEncoding compact_vertex_encoding = {
+	PositionEncoding::Unorm16,
+	DirectionEncoding::OctahedralSnorm16,
+	UvEncoding::Half,
+};
+
+/** Encoded vertices are split in two streams, positions alone so depth only
+ * passes fetch nothing else, and the rest of the attributes interleaved
+ *
+ * Offsets are within the attribute stream, each is aligned to its component
+ * size & both strides to 4 bytes
+ */
+struct VertexLayout
+{
+	uint32_t position_stride;
+
+	uint32_t normal_offset;
+	uint32_t tangent_offset;
+	uint32_t uv_offset;
+	uint32_t attribute_stride;
+};
+
+/** Encoded positions decode to offset + position * scale, which folds the
+ * bounds in for unorm16 positions & is the identity otherwise */
+struct PositionDequantization
+{
+	float offset[3];
+	float scale[3];
+};
+
+/** Largest error of each attribute over an encode & decode round trip */
+struct VertexEncodingError
+{
+	/** Distance in model space */
+	float position;
+
+	/** Angles in degrees */
+	float normal;
+	float tangent;
+
+	/** Per component */
+	float uv;
+};
+
+VertexLayout get_vertex_layout(VertexEncoding encoding);
+
+PositionDequantization get_position_dequantization(
+  PositionEncoding encoding,
+  const MeshBounds& bounds
+);
+
+/** Encodes @a count vertices into the @a positions & @a attributes streams,
+ * which have to hold count of their stride. @a bounds have to contain every position
+ *
+ * @note Zero length normals & tangents decode to +z
+ */
+void encode_vertices(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const MeshVertex* vertices,
+  size_t count,
+  void* positions,
+  void* attributes
+);
+
+/** Decodes vertex @a index the way the vertex shader does, directions come out normalized */
+MeshVertex decode_vertex(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const void* positions,
+  const void* attributes,
+  size_t index
+);
+
+/** Decodes every vertex & compares it to the original, zero length directions
+ * are left out since they have no direction to lose */
+VertexEncodingError measure_encoding_error(
+  VertexEncoding encoding,
+  const MeshBounds& bounds,
+  const MeshVertex* vertices,
+  size_t count,
+  const void* positions,
+  const void* attributes
+);
+
+uint16_t float_to_half(float value);
+float half_to_float(uint16_t value);
+
+} // namespace Assets
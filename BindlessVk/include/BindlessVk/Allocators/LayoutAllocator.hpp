@@ -52,7 +52,10 @@ public:
 	/** Destructor */
 	~LayoutAllocator();
 
-	/** Get or create descriptor set layout. */
+	/** Get or create descriptor set layout.
+	 *
+	 * @note Immutable samplers should come from the SamplerCache and outlive this allocator
+	 */
 	auto goc_descriptor_set_layout(
 	    vk::DescriptorSetLayoutCreateFlags layout_flags,
 	    span<vk::DescriptorSetLayoutBinding const> bindings,
@@ -64,7 +67,8 @@ public:
 	    vk::PipelineLayoutCreateFlags layout_flags,
 	    DescriptorSetLayoutWithHash graph_descriptor_set_layout,
 	    DescriptorSetLayoutWithHash pass_descriptor_set_layout,
-	    DescriptorSetLayoutWithHash shader_descriptor_set_layout
+	    DescriptorSetLayoutWithHash shader_descriptor_set_layout,
+	    span<vk::PushConstantRange const> push_constant_ranges = {}
 	) -> vk::PipelineLayout;
 
 private:
@@ -78,7 +82,8 @@ private:
 	    vk::PipelineLayoutCreateFlags layout_flags,
 	    DescriptorSetLayoutWithHash graph_descriptor_set_layout,
 	    DescriptorSetLayoutWithHash pass_descriptor_set_layout,
-	    DescriptorSetLayoutWithHash shader_descriptor_set_layout
+	    DescriptorSetLayoutWithHash shader_descriptor_set_layout,
+	    span<vk::PushConstantRange const> push_constant_ranges
 	) -> u64;
 
 private:
@@ -56,21 +56,57 @@ public:
 	/** Default destructor */
 	~FragmentedBuffer() = default;
 
-	void copy_staging_to_fragment(Buffer *staging_buffer, Fragment fragment);
+	/** Copies the fragment's length worth of @a staging_buffer, starting at @a staging_offset */
+	void copy_staging_to_fragment(
+	    Buffer *staging_buffer,
+	    Fragment fragment,
+	    usize staging_offset = 0u
+	);
 
 	void bind(vk::CommandBuffer cmd, u32 binding = 0) const;
 
+	/** Binds an index buffer with @a index_type, models may use either 16 or 32 bit indices
+	 * so it has to be rebound whenever the type changes between draws
+	 */
+	void bind(vk::CommandBuffer cmd, vk::IndexType index_type) const;
+
 	void write_buffer(Buffer const &src_buffer, vk::BufferCopy const &copy_info);
 
 	auto get_buffer() -> vk::Buffer;
 
 	/** Grabs a fragment from the buffer
+	 *
+	 * @note Sizes are rounded up to 4 bytes, so fragments of 16 & 32 bit indices can share a
+	 * buffer while staying aligned to their index size
 	 *
 	 * @param size The  size of the grabbed fragment
+	 * @param alignment The fragment's offset is a multiple of it, eg. the vertex stride so
+	 * vertex offsets can be derived from it. Doesn't have to be a power of 2
 	 * @returns A buffer fragment
 	 */
 	[[nodiscard]] //
-	auto grab_fragment(u32 size) -> Fragment;
+	auto grab_fragment(u32 size, u32 alignment = 4u) -> Fragment;
+
+	/** Grabs the fragment at @a offset, which has to be free, eg. one found by find_free_index
+	 *
+	 * @param offset The offset of the grabbed fragment
+	 * @param size The size of the grabbed fragment
+	 * @returns A buffer fragment
+	 */
+	[[nodiscard]] //
+	auto grab_fragment_at(usize offset, u32 size) -> Fragment;
+
+	/** Finds the lowest free run of @a count elements, eg. vertices of a stream
+	 *
+	 * @note Used to place fragments at the same index across several buffers, since a draw's
+	 * vertex offset applies to every vertex binding
+	 *
+	 * @param count Number of elements in the run
+	 * @param stride Size of each element, the run's offset is a multiple of it
+	 * @param min_index Runs starting before this element are skipped
+	 * @returns Index of the run's first element
+	 */
+	auto find_free_index(u32 count, u32 stride, usize min_index = 0u) const -> usize;
 
 	void return_fragment(Fragment returned_fragment);
 
@@ -61,6 +61,20 @@ public:
 	    vk::QueueFlags queue = vk::QueueFlagBits::eGraphics
 	) const;
 
+	/** Submits @a cmd without waiting for it to execute
+	 *
+	 * @param cmd A recorded command buffer
+	 * @param fence Signaled once the commands (and everything submitted before) have executed
+	 * @param queue Which queue to submit the commands to (graphics/compute)
+	 *
+	 * @note Work submitted to the same queue afterwards is ordered against it by its barriers
+	 */
+	void submit(
+	    vk::CommandBuffer cmd,
+	    vk::Fence fence,
+	    vk::QueueFlags queue = vk::QueueFlagBits::eGraphics
+	) const;
+
 	/** Trivial accessor for the underyling device */
 	auto vk() const
 	{
@@ -51,6 +51,9 @@ public:
 	    fn<u32(Gpu)> calculate_score
 	) -> Gpu;
 
+	/** Checks whether optimal-tiling images of @a format support all of @a features */
+	auto supports_format(vk::Format format, vk::FormatFeatureFlags features) const -> bool;
+
 	/** @brief Trivial accessor for the wrapped vulkan physical device */
 	auto vk() const
 	{
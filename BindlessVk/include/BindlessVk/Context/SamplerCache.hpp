@@ -0,0 +1,76 @@
+#pragma once
+
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/Device.hpp"
+
+#include <mutex>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Shares reference-counted samplers between textures (and descriptor set layouts), keyed by their
+ * create info. Keeps large scenes well below the device's sampler allocation limit.
+ */
+class SamplerCache
+{
+public:
+	/** Default constructor */
+	SamplerCache() = default;
+
+	/** Argumented constructor
+	 *
+	 * @param device The device to create the samplers on
+	 */
+	SamplerCache(Device *device);
+
+	/** Deleted move constructor */
+	SamplerCache(SamplerCache &&other) = delete;
+
+	/** Deleted move assignment opeator */
+	SamplerCache &operator=(SamplerCache &&other) = delete;
+
+	/** Deleted copy constructor */
+	SamplerCache(SamplerCache const &) = delete;
+
+	/** Deleted copy assignment opeator */
+	SamplerCache &operator=(SamplerCache const &other) = delete;
+
+	/** Destructor */
+	~SamplerCache();
+
+	/** Gets or creates a sampler matching @a info and adds a reference to it
+	 *
+	 * @note For immutable samplers, acquire once per layout and never release; layouts live as long
+	 * as the LayoutAllocator
+	 */
+	auto acquire(vk::SamplerCreateInfo const &info) -> vk::Sampler;
+
+	/** Removes a reference from @a sampler, destroying it once there are none left */
+	void release(vk::Sampler sampler);
+
+	/** Trivial accessor for the number of unique samplers */
+	auto get_sampler_count() const
+	{
+		return samplers.size();
+	}
+
+private:
+	struct Entry
+	{
+		vk::SamplerCreateInfo info;
+		vk::Sampler sampler;
+		u32 ref_count;
+	};
+
+private:
+	auto hash_sampler_info(vk::SamplerCreateInfo const &info) const -> u64;
+
+private:
+	Device *device = {};
+
+	std::mutex mutex = {};
+
+	hash_map<u64, Entry> samplers = {};
+	hash_map<VkSampler, u64> sampler_hashes = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
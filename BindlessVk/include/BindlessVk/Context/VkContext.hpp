@@ -5,6 +5,7 @@
 #include "BindlessVk/Context/Gpu.hpp"
 #include "BindlessVk/Context/Instance.hpp"
 #include "BindlessVk/Context/Queues.hpp"
+#include "BindlessVk/Context/SamplerCache.hpp"
 #include "BindlessVk/Context/Surface.hpp"
 
 #include <tracy/TracyVulkan.hpp>
@@ -74,6 +75,12 @@ public:
 		return queues;
 	}
 
+	/** Trivial accessor for sampler_cache */
+	auto get_sampler_cache() const
+	{
+		return sampler_cache.get();
+	}
+
 	/** Trivial accessor for tracy_graphics */
 	auto get_tracy_graphics() const
 	{
@@ -103,6 +110,8 @@ private:
 	Gpu *gpu = {};
 	Queues *queues = {};
 
+	std::unique_ptr<SamplerCache> sampler_cache = {};
+
 	TracyContext tracy_graphics;
 	TracyContext tracy_compute;
 
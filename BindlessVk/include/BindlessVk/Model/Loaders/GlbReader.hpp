@@ -0,0 +1,75 @@
+#pragma once
+
+#include "BindlessVk/Common/Common.hpp"
+
+#include <MappedFile.hpp>
+#include <tiny_gltf.h>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Reads binary gltf (.glb) files without copying their buffers
+ *
+ * The file is memory mapped & the json chunk is parsed with nlohmann json into a tinygltf model.
+ * Buffers & images are left empty in the model, their bytes are accessed through the spans below
+ * which point into the mapping (or the mappings of external files)
+ *
+ * @note Only the parts of the json the gltf loader consumes are read, everything else is skipped.
+ * Uris are percent-decoded like tinygltf does
+ */
+class GlbReader
+{
+public:
+	GlbReader() = default;
+
+	GlbReader(GlbReader &&) = delete;
+	GlbReader &operator=(GlbReader &&) = delete;
+
+	GlbReader(GlbReader const &) = delete;
+	GlbReader &operator=(GlbReader const &) = delete;
+
+	~GlbReader() = default;
+
+	/** Maps & parses @a file_path into @a model, asserts if the file is malformed */
+	void read(str_view file_path, tinygltf::Model &model);
+
+	/** Trivial accessor for whether a file has been read */
+	auto is_open() const -> bool
+	{
+		return file.is_open();
+	}
+
+	/** Bytes of a buffer, the binary chunk for the glb's own buffer */
+	auto get_buffer(u32 const index) const -> span<u8 const>
+	{
+		return buffers[index];
+	}
+
+	/** Encoded bytes of an image, either in a buffer view or an external file */
+	auto get_image(u32 const index) const -> span<u8 const>
+	{
+		return images[index];
+	}
+
+private:
+	auto read_container() -> str_view;
+
+	void read_external_buffers(tinygltf::Model const &model, vec<usize> const &buffer_sizes);
+	void read_images(tinygltf::Model const &model);
+
+	void validate_accessors(tinygltf::Model const &model) const;
+
+	auto map_external_file(str_view uri) -> span<u8 const>;
+
+private:
+	std::filesystem::path directory = {};
+
+	Assets::MappedFile file = {};
+	span<u8 const> binary_chunk = {};
+
+	vec<Assets::MappedFile> external_files = {};
+
+	vec<span<u8 const>> buffers = {};
+	vec<span<u8 const>> images = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -5,7 +5,10 @@
 #include "BindlessVk/Buffers/FragmentedBuffer.hpp"
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Model/Loaders/GlbReader.hpp"
+#include "BindlessVk/Model/Loaders/VertexKernels.hpp"
 #include "BindlessVk/Model/Model.hpp"
+#include "BindlessVk/Texture/ResidencyManager.hpp"
 #include "BindlessVk/Texture/TextureLoader.hpp"
 
 #include <tiny_gltf.h>
@@ -14,12 +17,24 @@ namespace BINDLESSVK_NAMESPACE {
 
 class GltfLoader
 {
+private:
+	/** Result of decoding a single gltf image on a worker thread */
+	struct DecodedImage
+	{
+		u32 index;
+		std::unique_ptr<u8, void (*)(void *)> pixels;
+		i32 width;
+		i32 height;
+	};
+
 public:
 	GltfLoader(
 	    VkContext const *vk_context,
 	    MemoryAllocator const *memory_allocator,
 	    TextureLoader const *texture_loader,
-	    FragmentedBuffer *vertex_buffer,
+	    ResidencyManager *residency_manager,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
 	    FragmentedBuffer *index_buffer,
 	    Buffer *staging_vertex_buffer,
 	    Buffer *staging_index_buffer,
@@ -34,15 +49,46 @@ public:
 
 	~GltfLoader() = default;
 
-	auto load_from_ascii(str_view file_path, str_view debug_name) -> Model;
-	auto load_from_binary(str_view file_path, str_view debug_name) -> Model = delete;
+	auto load_from_ascii(
+	    str_view file_path,
+	    str_view debug_name,
+	    Model::VertexEncoding vertex_encoding
+	) -> Model;
+
+	auto load_from_binary(
+	    str_view file_path,
+	    str_view debug_name,
+	    Model::VertexEncoding vertex_encoding
+	) -> Model;
 
 private:
 	void load_gltf_model_from_ascii(str_view file_path);
-	void load_gltf_model_from_binary(str_view file_path) = delete;
+	void load_gltf_model_from_binary(str_view file_path);
 
 	void load_textures();
+	auto decode_image(u32 index) -> DecodedImage;
+
+	auto get_encoded_image(u32 index) const -> span<u8 const>;
+
+	void stream_textures();
+	auto get_placeholder_texel(u32 image_index) const -> arr<u8, 4>;
+
+	static auto defer_image_decoding(
+	    tinygltf::Image *image,
+	    i32 image_index,
+	    str *err,
+	    str *warn,
+	    i32 requested_width,
+	    i32 requested_height,
+	    u8 const *bytes,
+	    i32 size,
+	    void *user_data
+	) -> bool;
+
 	void load_material_parameters();
+
+	auto get_max_vertex_count() -> usize;
+	auto select_index_type() -> vk::IndexType;
 	void stage_mesh_data();
 
 	void write_mesh_data_to_gpu();
@@ -52,15 +98,22 @@ private:
 	void write_vertex_buffer_to_gpu();
 	void write_index_buffer_to_gpu();
 
+	/** Encodes the staged vertices into the staging buffer, positions first */
+	void encode_vertices();
+
 	void load_mesh_primitives(tinygltf::Mesh const &gltf_mesh, Model::Node *node);
 
 	void load_mesh_primitive_vertices(tinygltf::Primitive const &gltf_primitive);
 	auto load_mesh_primitive_indices(tinygltf::Primitive const &gltf_primitive) -> u32;
 
-	auto get_primitive_attribute_buffer(
-	    const tinygltf::Primitive &gltf_primitive,
+	auto static get_index_size(i32 component_type) -> usize;
+
+	auto get_primitive_attribute_stream(
+	    tinygltf::Primitive const &gltf_primitive,
 	    str_view attribute_name
-	) -> const f32 *;
+	) const -> AttributeStream;
+
+	auto get_buffer_data(i32 buffer_index) const -> u8 const *;
 
 	auto get_primitive_vertex_count(tinygltf::Primitive const &gltf_primitive) -> usize;
 	auto get_primitive_index_count(tinygltf::Primitive const &gltf_primitive) -> usize;
@@ -75,10 +128,13 @@ private:
 
 	MemoryAllocator const *memory_allocator = {};
 	TextureLoader const *texture_loader = {};
+	ResidencyManager *residency_manager = {};
 
-	FragmentedBuffer *vertex_buffer = {};
+	FragmentedBuffer *position_buffer = {};
+	FragmentedBuffer *attribute_buffer = {};
 	FragmentedBuffer *index_buffer = {};
 
+	GlbReader glb_reader = {};
 	tinygltf::Model gltf_model = {};
 	Model model = {};
 
@@ -87,7 +143,9 @@ private:
 	Buffer *staging_texture_buffer = {};
 
 	Model::Vertex *vertex_map = {};
-	u32 *index_map = {};
+	void *index_map = {};
+
+	vec<Model::Vertex> full_precision_vertices = {};
 
 	usize vertex_count = {};
 	usize index_count = {};
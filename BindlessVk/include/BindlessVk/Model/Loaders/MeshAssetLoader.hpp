@@ -0,0 +1,81 @@
+#pragma once
+
+#include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Buffers/FragmentedBuffer.hpp"
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Model/Model.hpp"
+#include "BindlessVk/Texture/TextureLoader.hpp"
+
+#include <AssetArchive.hpp>
+#include <AssetParser.hpp>
+#include <MeshAsset.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Loads baked .asset_mesh files, loose or packed in an asset archive
+ *
+ * The vertex & index streams are stored in their final layout, they're unpacked from the mapped
+ * file straight into the staging buffers, no parsing or per-vertex conversion happens at load
+ */
+class MeshAssetLoader
+{
+public:
+	MeshAssetLoader(
+	    VkContext const *vk_context,
+	    TextureLoader const *texture_loader,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
+	    FragmentedBuffer *index_buffer,
+	    Buffer *staging_vertex_buffer,
+	    Buffer *staging_index_buffer,
+	    Buffer *staging_texture_buffer
+	);
+
+	MeshAssetLoader(MeshAssetLoader &&) = delete;
+	MeshAssetLoader &operator=(MeshAssetLoader &&) = delete;
+
+	MeshAssetLoader(MeshAssetLoader const &) = delete;
+	MeshAssetLoader &operator=(MeshAssetLoader const &) = delete;
+
+	~MeshAssetLoader() = default;
+
+	auto load(str_view file_path, str_view debug_name) -> Model;
+
+	/** Loads the mesh named @a name from @a archive, its textures are looked up in the same
+	 * archive. The archive has to stay open for the duration of the call */
+	auto load(Assets::AssetArchive const *archive, str_view name, str_view debug_name) -> Model;
+
+private:
+	void load_mesh(str_view path);
+	void read_mesh_info();
+
+	void load_textures(str_view path);
+	void load_material_parameters();
+	void load_nodes();
+
+	void write_vertex_buffer_to_gpu();
+	void write_index_buffer_to_gpu();
+
+private:
+	VkContext const *vk_context = {};
+	TextureLoader const *texture_loader = {};
+
+	FragmentedBuffer *position_buffer = {};
+	FragmentedBuffer *attribute_buffer = {};
+	FragmentedBuffer *index_buffer = {};
+
+	Buffer *staging_vertex_buffer = {};
+	Buffer *staging_index_buffer = {};
+	Buffer *staging_texture_buffer = {};
+
+	Assets::AssetArchive const *archive = {};
+
+	Assets::MappedAssetFile mapped_file = {};
+	Assets::AssetView asset = {};
+	Assets::MeshInfo mesh_info = {};
+
+	Model model = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
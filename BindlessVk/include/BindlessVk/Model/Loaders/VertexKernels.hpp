@@ -0,0 +1,104 @@
+#pragma once
+
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Model/Model.hpp"
+
+#include <cstring>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** An accessor's elements, read one at a time since they may be strided & unaligned */
+struct AttributeStream
+{
+	u8 const *data;
+	usize stride;
+
+	template<typename T>
+	auto get(usize const index) const -> T
+	{
+		auto value = T {};
+		std::memcpy(&value, data + index * stride, sizeof(T));
+		return value;
+	}
+
+	explicit operator bool() const
+	{
+		return data;
+	}
+};
+
+/** Source streams of a primitive's vertices, missing attributes are null */
+struct VertexStreams
+{
+	AttributeStream position;
+	AttributeStream normal;
+	AttributeStream tangent;
+	AttributeStream uv;
+};
+
+/** Interleaves @a count vertices into @a vertices & grows @a bounds to contain their positions
+ *
+ * Missing attributes come out as zeros, so do tangents of zero length, the rest are normalized.
+ * Four vertices are converted at a time with sse or neon where available
+ *
+ * @note Produces the exact same results as interleave_vertices_scalar
+ */
+void interleave_vertices(
+    VertexStreams const &streams,
+    usize count,
+    Model::Vertex *vertices,
+    Model::Bounds &bounds
+);
+
+/** Reference implementation of interleave_vertices, one vertex at a time */
+void interleave_vertices_scalar(
+    VertexStreams const &streams,
+    usize count,
+    Model::Vertex *vertices,
+    Model::Bounds &bounds
+);
+
+/** Widens @a count tightly packed indices of @a index_size (1, 2 or 4) bytes to u32 & offsets
+ * them by @a base_vertex
+ *
+ * Vectorized with avx2 (when the cpu supports it), sse2 or neon
+ */
+void rebase_indices(
+    void const *indices,
+    usize index_size,
+    usize count,
+    u32 base_vertex,
+    u32 *rebased_indices
+);
+
+/** Reference implementation of rebase_indices, one index at a time */
+void rebase_indices_scalar(
+    void const *indices,
+    usize index_size,
+    usize count,
+    u32 base_vertex,
+    u32 *rebased_indices
+);
+
+/** Like rebase_indices but narrows the indices to u16, for models with few enough vertices
+ *
+ * @note Rebased indices that don't fit in 16 bits are truncated
+ */
+void rebase_indices(
+    void const *indices,
+    usize index_size,
+    usize count,
+    u32 base_vertex,
+    u16 *rebased_indices
+);
+
+/** Reference implementation of the 16 bit rebase_indices, one index at a time */
+void rebase_indices_scalar(
+    void const *indices,
+    usize index_size,
+    usize count,
+    u32 base_vertex,
+    u16 *rebased_indices
+);
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -4,6 +4,7 @@
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Texture/Texture.hpp"
 
+#include <VertexEncoding.hpp>
 #include <vulkan/vulkan.hpp>
 
 namespace BINDLESSVK_NAMESPACE {
@@ -22,9 +23,21 @@ class Model
 public:
 	friend class ModelLoader;
 	friend class GltfLoader;
+	friend class MeshAssetLoader;
 
 public:
-	/** Holds attibutes of points-in-space to represent a geometric shape */
+	/** How vertices are stored in the vertex buffer, full precision by default */
+	using VertexEncoding = Assets::VertexEncoding;
+
+	/** Holds attibutes of points-in-space to represent a geometric shape
+	 *
+	 * @note This is the full precision layout, models may store their vertices with a more
+	 * compact encoding. Pipelines drawing them need the encoding's vertex input state
+	 *
+	 * @note Models keep positions in a stream of their own, bound to position_binding, & the
+	 * rest of the attributes interleaved in another, bound to attribute_binding. Depth only
+	 * pipelines use the position input state & fetch nothing besides positions
+	 */
 	struct Vertex
 	{
 		vec3 position;
@@ -32,9 +45,31 @@ public:
 		vec3 tangent;
 		vec2 uv;
 
-		auto static get_attributes() -> arr<vk::VertexInputAttributeDescription, 4>;
-		auto static get_bindings() -> arr<vk::VertexInputBindingDescription, 1>;
-		auto static get_vertex_input_state() -> vk::PipelineVertexInputStateCreateInfo;
+		auto static constexpr position_binding = u32 { 0 };
+		auto static constexpr attribute_binding = u32 { 1 };
+
+		auto static get_attributes(VertexEncoding encoding = {})
+		    -> arr<vk::VertexInputAttributeDescription, 4>;
+
+		auto static get_bindings(VertexEncoding encoding = {})
+		    -> arr<vk::VertexInputBindingDescription, 2>;
+
+		/** @note The returned state points to descriptions that live as long as the program */
+		auto static get_vertex_input_state(VertexEncoding encoding = {})
+		    -> vk::PipelineVertexInputStateCreateInfo;
+
+		auto static get_position_attributes(VertexEncoding encoding = {})
+		    -> arr<vk::VertexInputAttributeDescription, 1>;
+
+		auto static get_position_bindings(VertexEncoding encoding = {})
+		    -> arr<vk::VertexInputBindingDescription, 1>;
+
+		/** Input state of depth only pipelines, eg. depth pre-passes & shadow maps
+		 *
+		 * @note The returned state points to descriptions that live as long as the program
+		 */
+		auto static get_position_vertex_input_state(VertexEncoding encoding = {})
+		    -> vk::PipelineVertexInputStateCreateInfo;
 	};
 
 	/** A node that holds child-nodes and/or primitives and their transforrmation matrix */
@@ -77,6 +112,13 @@ public:
 		i32 mr_index;
 	};
 
+	/** Axis aligned bounding box of every vertex, in model space */
+	struct Bounds
+	{
+		vec3 min;
+		vec3 max;
+	};
+
 public:
 	/** Default move constructor */
 	Model(Model &&) = default;
@@ -111,35 +153,99 @@ public:
 		return textures;
 	}
 
+	/** Trivial ref accessor for textures */
+	auto &get_textures()
+	{
+		return textures;
+	}
+
 	/** Trivial const-ref accessor for material_parameters */
 	auto &get_material_parameters() const
 	{
 		return material_parameters;
 	}
 
-	/**  Calcualtes the vertex offset from beginning of vertex buffer to model's first vertex */
+	/** Trivial const-ref accessor for bounds */
+	auto &get_bounds() const
+	{
+		return bounds;
+	}
+
+	/** Trivial accessor for vertex_encoding, pipelines drawing the model have to use it */
+	auto get_vertex_encoding() const
+	{
+		return vertex_encoding;
+	}
+
+	/** Size of a single encoded position in bytes */
+	auto get_position_stride() const -> usize
+	{
+		return Assets::get_vertex_layout(vertex_encoding).position_stride;
+	}
+
+	/** Size of a single vertex's encoded attributes, besides the position, in bytes */
+	auto get_attribute_stride() const -> usize
+	{
+		return Assets::get_vertex_layout(vertex_encoding).attribute_stride;
+	}
+
+	/** Scale & offset that take encoded positions back to model space */
+	auto get_position_dequantization() const -> Assets::PositionDequantization;
+
+	/**  Calcualtes the vertex offset from beginning of vertex buffers to model's first vertex
+	 *
+	 * @note Both vertex streams start at this offset
+	 */
 	auto get_vertex_offset() const
 	{
-		return vertex_buffer_fragment.offset / sizeof(Model::Vertex);
+		return position_buffer_fragment.offset / get_position_stride();
+	}
+
+	/** Trivial accessor for index_type, the index buffer has to be bound with it */
+	auto get_index_type() const
+	{
+		return index_type;
+	}
+
+	/** Size of a single index in bytes */
+	auto get_index_size() const -> usize
+	{
+		return index_type == vk::IndexType::eUint16 ? sizeof(u16) : sizeof(u32);
 	}
 
 	/**  Calcualtes the index offset from beginning of index buffer to model's first index */
 	auto get_index_offset() const
 	{
-		return index_buffer_fragment.offset / sizeof(u32);
+		return index_buffer_fragment.offset / get_index_size();
 	}
 
 private:
 	Model() = default;
 
+	/** Grabs both vertex streams' fragments for @a vertex_count vertices, at the same vertex
+	 * offset in their buffers
+	 */
+	void grab_vertex_fragments(
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
+	    u32 vertex_count
+	);
+
 private:
 	vec<Node *> nodes = {};
 	vec<Texture> textures = {};
 	vec<MaterialParameters> material_parameters = {};
+	Bounds bounds = {};
 
-	FragmentedBuffer::Fragment vertex_buffer_fragment = {};
+	FragmentedBuffer::Fragment position_buffer_fragment = {};
+	FragmentedBuffer::Fragment attribute_buffer_fragment = {};
 	FragmentedBuffer::Fragment index_buffer_fragment = {};
 
+	/** 16-bit when every vertex of the model is addressable with it */
+	vk::IndexType index_type = vk::IndexType::eUint32;
+
+	VertexEncoding vertex_encoding = {};
+
 	str debug_name = {};
 };
 
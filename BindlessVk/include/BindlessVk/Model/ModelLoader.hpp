@@ -4,6 +4,7 @@
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Context/VkContext.hpp"
 #include "BindlessVk/Model/Model.hpp"
+#include "BindlessVk/Texture/ResidencyManager.hpp"
 #include "BindlessVk/Texture/TextureLoader.hpp"
 
 namespace BINDLESSVK_NAMESPACE {
@@ -19,8 +20,14 @@ public:
 	 *
 	 * @param vk_context Pointer to the vk context
 	 * @param memory_allocator Pointer to the memory allocator
+	 * @param residency_manager Optional, if set the textures are streamed in by it rather than
+	 * loaded up-front
 	 */
-	ModelLoader(VkContext const *vk_context, MemoryAllocator const *memory_allocator);
+	ModelLoader(
+	    VkContext const *vk_context,
+	    MemoryAllocator const *memory_allocator,
+	    ResidencyManager *residency_manager = {}
+	);
 
 	/** Default destructor */
 	~ModelLoader() = default;
@@ -28,16 +35,48 @@ public:
 	/** Loads a model from a .gltf file
 	 *
 	 * @param file_path null-terminated str view to path of the gltf model file
-	 * @param vertex_buffer A fragmented buffer for vertex data to be written to
+	 * @param position_buffer A fragmented buffer for vertex positions to be written to
+	 * @param attribute_buffer A fragmented buffer for the rest of the vertex attributes to be
+	 * written to, at the same vertex offset as the positions
 	 * @param index_bufer A fragmented buffer for index data to be written to
 	 * @param staging_vertex_buffer A buffer to be used to stage data for uploading to gpu
 	 * @param staging_index_buffer A buffer to be used to stage data for uploading to gpu
 	 * @param staging_image_buffer A buffer to be used to stage data for uploading to gpu
 	 * @param debug_namedebug name attached to vulkan objects for debugging tools like renderdoc
+	 * @param vertex_encoding How the vertices are stored in the vertex buffers
 	 */
 	auto load_from_gltf_ascii(
 	    str_view file_path,
-	    FragmentedBuffer *vertex_buffer,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
+	    FragmentedBuffer *index_buffer,
+	    Buffer *staging_vertex_buffer,
+	    Buffer *staging_index_buffer,
+	    Buffer *staging_image_buffer,
+	    str_view debug_name = default_debug_name,
+	    Model::VertexEncoding vertex_encoding = {}
+	) const -> Model;
+
+	/** Loads a model from a baked .asset_mesh file
+	 *
+	 * @note The streams are copied as-is, without any parsing or per-vertex conversion. Textures
+	 * are loaded from the baked .asset_texture files the mesh references. The vertex encoding is
+	 * the one the mesh was baked with
+	 *
+	 * @param file_path null-terminated str view to path of the baked mesh file
+	 * @param position_buffer A fragmented buffer for vertex positions to be written to
+	 * @param attribute_buffer A fragmented buffer for the rest of the vertex attributes to be
+	 * written to, at the same vertex offset as the positions
+	 * @param index_bufer A fragmented buffer for index data to be written to
+	 * @param staging_vertex_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_index_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_image_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param debug_name debug name attached to vulkan objects for debugging tools like renderdoc
+	 */
+	auto load_from_asset(
+	    str_view file_path,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
 	    FragmentedBuffer *index_buffer,
 	    Buffer *staging_vertex_buffer,
 	    Buffer *staging_index_buffer,
@@ -45,8 +84,59 @@ public:
 	    str_view debug_name = default_debug_name
 	) const -> Model;
 
-	/** @todo Implement */
-	auto load_from_gltf_binary() -> Model = delete;
+	/** Loads a model from a baked mesh packed in an asset archive
+	 *
+	 * @note Textures the mesh references are loaded from the same archive
+	 *
+	 * @param archive An open asset archive, has to stay open for the duration of the call
+	 * @param name Path of the .asset_mesh relative to the bake's output directory
+	 * @param position_buffer A fragmented buffer for vertex positions to be written to
+	 * @param attribute_buffer A fragmented buffer for the rest of the vertex attributes to be
+	 * written to, at the same vertex offset as the positions
+	 * @param index_bufer A fragmented buffer for index data to be written to
+	 * @param staging_vertex_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_index_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_image_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param debug_name debug name attached to vulkan objects for debugging tools like renderdoc
+	 */
+	auto load_from_archive(
+	    Assets::AssetArchive const *archive,
+	    str_view name,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
+	    FragmentedBuffer *index_buffer,
+	    Buffer *staging_vertex_buffer,
+	    Buffer *staging_index_buffer,
+	    Buffer *staging_image_buffer,
+	    str_view debug_name = default_debug_name
+	) const -> Model;
+
+	/** Loads a model from a .glb file
+	 *
+	 * @note The file is memory mapped & vertex/index data is read straight from the mapping
+	 *
+	 * @param file_path null-terminated str view to path of the glb model file
+	 * @param position_buffer A fragmented buffer for vertex positions to be written to
+	 * @param attribute_buffer A fragmented buffer for the rest of the vertex attributes to be
+	 * written to, at the same vertex offset as the positions
+	 * @param index_bufer A fragmented buffer for index data to be written to
+	 * @param staging_vertex_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_index_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param staging_image_buffer A buffer to be used to stage data for uploading to gpu
+	 * @param debug_name debug name attached to vulkan objects for debugging tools like renderdoc
+	 * @param vertex_encoding How the vertices are stored in the vertex buffers
+	 */
+	auto load_from_gltf_binary(
+	    str_view file_path,
+	    FragmentedBuffer *position_buffer,
+	    FragmentedBuffer *attribute_buffer,
+	    FragmentedBuffer *index_buffer,
+	    Buffer *staging_vertex_buffer,
+	    Buffer *staging_index_buffer,
+	    Buffer *staging_image_buffer,
+	    str_view debug_name = default_debug_name,
+	    Model::VertexEncoding vertex_encoding = {}
+	) const -> Model;
 
 	/** @todo Implement */
 	auto load_from_fbx() -> Model = delete;
@@ -57,6 +147,7 @@ public:
 private:
 	VkContext const *vk_context = {};
 	MemoryAllocator const *memory_allocator = {};
+	ResidencyManager *residency_manager = {};
 	TextureLoader texture_loader = {};
 };
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Shader/Shader.hpp"
+
+#include <ShaderPackAsset.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Loads shaders from a memory mapped shader pack, reflection data is read from the pack instead
+ * of being generated with spirv-reflect */
+class PackLoader
+{
+public:
+	PackLoader(VkContext const *vk_context);
+
+	auto load(Assets::ShaderPack const *pack, str_view name) -> Shader;
+
+private:
+	void create_vulkan_shader_module();
+
+	void load_shader_stage();
+	void load_descriptor_set_bindings();
+	void load_push_constant_range();
+	void load_specialization_constants();
+
+private:
+	Device const *device = {};
+
+	Assets::ShaderPack const *pack = {};
+	Assets::ShaderPackEntry const *entry = {};
+
+	Shader shader = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -27,6 +27,8 @@ private:
 
 	void reflect_descriptor_sets();
 	void reflect_shader_stage();
+	void reflect_specialization_constants();
+	void reflect_push_constant_blocks();
 
 	auto reflect_descriptor_set_bindings(SpvReflectDescriptorSet const *spv_set)
 	    -> vec<vk::DescriptorSetLayoutBinding>;
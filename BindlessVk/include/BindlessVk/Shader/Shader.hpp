@@ -6,18 +6,37 @@
 
 namespace BINDLESSVK_NAMESPACE {
 
+/** Specialization constant reflected from a shader module */
+struct ShaderSpecializationConstant
+{
+	str name;
+	u32 constant_id;
+};
+
 /** Wrapper around vulkan shader module that holds descriptor set slot 2's bindings */
 struct Shader
 {
 	vk::ShaderModule module;
 	vk::ShaderStageFlagBits stage;
 	vec<vk::DescriptorSetLayoutBinding> descriptor_set_bindings;
+	vec<ShaderSpecializationConstant> specialization_constants;
+
+	/** Range of the shader's push constant block, size is 0 if the shader has none */
+	vk::PushConstantRange push_constant_range;
 };
 
 /** Wrapper around vulkan graphics pipeline */
 class ShaderPipeline
 {
 public:
+	/** Value of a specialization constant, matched against the reflected constant ids */
+	struct SpecializationValue
+	{
+		u32 constant_id;
+		u32 size;
+		u64 data;
+	};
+
 	/** Pipeline state of the shader */
 	struct Configuration
 	{
@@ -33,6 +52,44 @@ public:
 
 		vec<vk::PipelineColorBlendAttachmentState> color_blend_attachments;
 		vec<vk::DynamicState> dynamic_states;
+
+		vec<SpecializationValue> specialization_values;
+
+		/** Sets (or overrides) the value of a specialization constant
+		 *
+		 * @param constant_id The constant_id of the specialization constant
+		 * @param value The value, bools are converted to VkBool32
+		 */
+		template<typename T>
+		    requires(std::is_trivially_copyable_v<T> && (sizeof(T) <= sizeof(u64)))
+		auto set_specialization_constant(u32 const constant_id, T const value) -> Configuration &
+		{
+			auto specialization_value = SpecializationValue { constant_id, sizeof(T), 0ull };
+
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				auto const bool32 = static_cast<vk::Bool32>(value);
+				specialization_value.size = sizeof(vk::Bool32);
+				memcpy(&specialization_value.data, &bool32, sizeof(vk::Bool32));
+			}
+			else
+			{
+				memcpy(&specialization_value.data, &value, sizeof(T));
+			}
+
+			auto const it = std::find_if(
+			    specialization_values.begin(),
+			    specialization_values.end(),
+			    [&](auto const &existing_value) { return existing_value.constant_id == constant_id; }
+			);
+
+			if (it != specialization_values.end())
+				*it = specialization_value;
+			else
+				specialization_values.push_back(specialization_value);
+
+			return *this;
+		}
 	};
 
 	enum class Type
@@ -84,6 +141,42 @@ public:
 		return pipeline;
 	}
 
+	/** Checks if the pipeline was created with the @a module shader module */
+	auto uses_shader_module(vk::ShaderModule const module) const
+	{
+		return std::any_of(shaders.begin(), shaders.end(), [&](auto const &shader) {
+			return shader.module == module;
+		});
+	}
+
+	/** Creates a new pipeline with the same state, but @a shader replacing the shader of its stage
+	 *
+	 * @param shader The new shader, usually a hot reloaded version of one of the pipeline's shaders
+	 *
+	 * @note This pipeline is left untouched, it's up to the caller to swap and retire it once the
+	 * frames using it are no longer in flight
+	 */
+	auto recreate_with_shader(Shader const &shader) const -> ShaderPipeline;
+
+	/** Returns the value of a specialization constant the pipeline was created with
+	 *
+	 * @param constant_id The constant_id of the specialization constant
+	 * @param fallback The value to return if the constant wasn't set on this pipeline
+	 */
+	template<typename T>
+	auto get_specialization_constant(u32 const constant_id, T const fallback) const -> T
+	{
+		for (auto const &specialization_value : specialization_values)
+			if (specialization_value.constant_id == constant_id)
+			{
+				auto value = T {};
+				memcpy(&value, &specialization_value.data, sizeof(T));
+				return value;
+			}
+
+		return fallback;
+	}
+
 	/** Trivial accessor for pipeline_layout */
 	auto get_pipeline_layout() const
 	{
@@ -99,6 +192,42 @@ public:
 		return descriptor_set_layout;
 	}
 
+	/** Trivial accessor for push_constant_range
+	 * @note The range is merged across all the stages, it's empty if no stage uses push constants
+	 */
+	auto get_push_constant_range() const
+	{
+		return push_constant_range;
+	}
+
+	/** Records a push constants update for this pipeline's layout
+	 *
+	 * @param cmd The command buffer to record to
+	 * @param value Per-draw or per-dispatch parameters, laid out like the shaders' push_constant
+	 * block
+	 * @param offset Byte offset into the push constant block
+	 *
+	 * @warning Layouts that differ in push constant ranges are not compatible, descriptor sets
+	 * bound through another layout may need to be re-bound after binding this pipeline
+	 */
+	template<typename T>
+	    requires(std::is_trivially_copyable_v<T>)
+	void push_constants(vk::CommandBuffer const cmd, T const &value, u32 const offset = 0) const
+	{
+		assert_true(
+		    offset >= push_constant_range.offset
+		        && offset + sizeof(T) <= push_constant_range.offset + push_constant_range.size,
+		    "Push constants [{}, {}) are out of range [{}, {}) of shader pipeline {}",
+		    offset,
+		    offset + sizeof(T),
+		    push_constant_range.offset,
+		    push_constant_range.offset + push_constant_range.size,
+		    debug_name
+		);
+
+		cmd.pushConstants(pipeline_layout, push_constant_range.stageFlags, offset, sizeof(T), &value);
+	}
+
 	/** Checks if shader pipeline uses set slot 2 (per shader descriptor set)
 	 * It does so by validating descriptor_set_layout
 	 */
@@ -107,9 +236,20 @@ public:
 		return !!descriptor_set_layout;
 	}
 
+private:
+	/** Storage for a shader stage's vk::SpecializationInfo, which has to outlive pipeline creation */
+	struct StageSpecialization
+	{
+		vec<vk::SpecializationMapEntry> map_entries;
+		vec<u8> data;
+		vk::SpecializationInfo info;
+	};
+
 private:
 	void create_descriptor_set_layout(vec<Shader *> const &shaders);
 
+	void combine_push_constant_ranges(vec<Shader *> const &shaders);
+
 	void create_pipeline_layout(
 	    DescriptorSetLayoutWithHash graph_descriptor_set_layout,
 	    DescriptorSetLayoutWithHash pass_descriptor_set_layout
@@ -125,19 +265,37 @@ private:
 	auto combine_descriptor_sets_bindings(vec<Shader *> const &shaders) const
 	    -> vec<vk::DescriptorSetLayoutBinding>;
 
-	auto create_shader_stage_create_infos(vec<Shader *> const &shaders) const
-	    -> vec<vk::PipelineShaderStageCreateInfo>;
+	auto create_shader_stage_create_infos(
+	    vec<Shader *> const &shaders,
+	    vec<StageSpecialization> &stage_specializations
+	) const -> vec<vk::PipelineShaderStageCreateInfo>;
+
+	void create_stage_specialization(
+	    Shader const *shader,
+	    StageSpecialization &stage_specialization
+	) const;
 
 
 private:
 	tidy_ptr<Device const> device = {};
 
+	VkContext const *vk_context = {};
 	Surface const *surface = {};
 	LayoutAllocator *layout_allocator = {};
 
+	// creation state, kept around to recreate the pipeline
+	Type type = {};
+	vec<Shader> shaders = {};
+	Configuration configuration = {};
+	DescriptorSetLayoutWithHash graph_descriptor_set_layout = {};
+	DescriptorSetLayoutWithHash pass_descriptor_set_layout = {};
+
 	vk::Pipeline pipeline = {};
 	vk::PipelineLayout pipeline_layout = {};
 	DescriptorSetLayoutWithHash descriptor_set_layout = {};
+	vk::PushConstantRange push_constant_range = {};
+
+	vec<SpecializationValue> specialization_values = {};
 
 	str debug_name = {};
 };
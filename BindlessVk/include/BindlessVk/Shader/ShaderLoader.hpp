@@ -4,6 +4,10 @@
 #include "BindlessVk/Context/VkContext.hpp"
 #include "BindlessVk/Shader/Shader.hpp"
 
+namespace Assets {
+class ShaderPack;
+}
+
 namespace BINDLESSVK_NAMESPACE {
 
     /** Loads shader files like .spv */
@@ -28,6 +32,13 @@ public:
 	 */
 	auto load_from_spv(str_view file_path) -> Shader;
 
+	/** Loads a shader from a memory mapped shader pack (built by ShaderPacker)
+	 *
+	 * @param pack An opened shader pack, only needs to outlive this call
+	 * @param name Name of the shader, which is the spv file name without extension
+	 */
+	auto load_from_pack(Assets::ShaderPack const *pack, str_view name) -> Shader;
+
 	auto load_from_glsl(str_view file_path) -> Shader = delete;
 
 	auto load_from_hlsl(str_view file_path) -> Shader = delete;
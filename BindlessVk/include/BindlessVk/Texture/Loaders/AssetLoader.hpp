@@ -0,0 +1,88 @@
+#pragma once
+
+#include "BindlessVk/Allocators/MemoryAllocator.hpp"
+#include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Loaders/GpuDecompressor.hpp"
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
+#include "BindlessVk/Texture/Texture.hpp"
+
+#include <AssetParser.hpp>
+#include <TextureAsset.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Loads baked .asset_texture files, uploading the whole baked mip chain at once
+ *
+ * @note Block-compressed textures are uploaded as-is when the gpu can sample them, otherwise
+ * they're transcoded to RGBA8 on the cpu. Chunked LZ4/LZ4HC blobs are staged compressed &
+ * decompressed on the gpu when a gpu decompressor is provided, other codecs (zstd) are
+ * decompressed in parallel on the cpu
+ */
+class AssetLoader
+{
+public:
+	AssetLoader(
+	    VkContext const *vk_context,
+	    MemoryAllocator const *memory_allocator,
+	    Buffer *staging_buffer,
+	    GpuDecompressor *gpu_decompressor = {}
+	);
+
+	Texture load(str_view path, Texture::Type type, vk::ImageLayout final_layout, str_view name);
+
+	/** Loads a texture viewed in place, eg. inside an asset archive, the view has to outlive
+	 * the call */
+	Texture load(
+	    Assets::AssetView const &asset_view,
+	    Texture::Type type,
+	    vk::ImageLayout final_layout,
+	    str_view name
+	);
+
+private:
+	void read_texture_info();
+
+	auto select_format() -> vk::Format;
+	auto get_native_format(Assets::TextureFormat format) const -> vk::Format;
+	void calculate_level_offsets();
+
+	auto load_with_runtime_mipmaps(Texture::Type type, vk::ImageLayout final_layout) -> Texture;
+
+	void upload_texture_data(vk::ImageLayout final_layout);
+	auto can_decompress_on_gpu() const -> bool;
+	void upload_gpu_decompressed_levels();
+	void upload_packed_levels();
+	auto can_unpack_ranges() const -> bool;
+	void upload_level_ranges();
+	void upload_unpacked_levels();
+	void upload_transcoded_levels();
+
+	void create_image();
+	void create_image_view();
+	void create_sampler();
+
+	auto create_mip_buffer_copies(vk::DeviceSize base_offset) const -> vec<vk::BufferImageCopy>;
+
+private:
+	VkContext const *vk_context = {};
+	Device const *device = {};
+	MemoryAllocator const *memory_allocator = {};
+	SamplerCache *sampler_cache = {};
+
+	Buffer *const staging_buffer = {};
+	TextureUploader uploader;
+	GpuDecompressor *gpu_decompressor = {};
+
+	Texture texture = {};
+
+	Assets::MappedAssetFile mapped_file = {};
+	Assets::AssetView asset = {};
+	Assets::TextureInfo texture_info = {};
+
+	vec<vk::DeviceSize> level_offsets = {};
+	bool transcode = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -4,7 +4,9 @@
 #include "BindlessVk/Buffers/Buffer.hpp"
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
 #include "BindlessVk/Texture/Texture.hpp"
+#include "BindlessVk/Texture/TextureLoader.hpp"
 
 namespace BINDLESSVK_NAMESPACE {
 
@@ -27,22 +29,39 @@ public:
 	    str_view debug_name
 	);
 
+	auto load_batch(
+	    span<TextureLoader::BinaryTextureInfo const> infos,
+	    Texture::Type type,
+	    vk::ImageLayout final_layout
+	) -> vec<Texture>;
+
+	/** Starts an incremental batch of @a count textures, for producers that can't provide every
+	 * texture up-front (eg. parallel decoding). Textures may be added in any order and their
+	 * pixel-data can be released as soon as add_to_batch returns.
+	 */
+	void begin_batch(usize count);
+	void add_to_batch(u32 index, TextureLoader::BinaryTextureInfo const &info);
+	auto end_batch() -> vec<Texture>;
+
 private:
-	void create_image();
-	void create_image_view();
-	void create_sampler();
+	void create_texture(TextureLoader::BinaryTextureInfo const &info, Texture &texture);
+
+	void create_image(Texture &texture);
+	void create_image_view(Texture &texture);
+	void create_sampler(Texture &texture);
 
-	void create_mipmaps(vk::CommandBuffer cmd);
+	void upload_texture_data(TextureLoader::BinaryTextureInfo const &info, Texture &texture);
 
-	void stage_texture_data(u8 const *const pixels, vk::DeviceSize size);
-	void write_texture_data_to_gpu();
+	/** Runtime fallback, baked assets carry their mip chain (see AssetLoader) */
+	void create_mipmaps(vk::CommandBuffer cmd, Texture &texture);
 
 private:
 	Device const *device = {};
 	MemoryAllocator const *memory_allocator = {};
-	Buffer *const staging_buffer = {};
+	SamplerCache *sampler_cache = {};
+	TextureUploader uploader;
 
-	Texture texture = {};
+	vec<Texture> batch_textures = {};
 };
 
 } // namespace BINDLESSVK_NAMESPACE
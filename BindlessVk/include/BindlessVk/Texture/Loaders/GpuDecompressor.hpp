@@ -0,0 +1,160 @@
+#pragma once
+
+#include "BindlessVk/Allocators/MemoryAllocator.hpp"
+#include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Shader/Shader.hpp"
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
+#include "BindlessVk/Texture/Texture.hpp"
+
+#include <ChunkedBlob.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Decompresses chunked LZ4 (or LZ4HC) blobs on the gpu, with Shaders/lz4_decompress.glsl
+ *
+ * The compressed blob is staged as-is & decompressed into a device local output buffer, one
+ * invocation per chunk, then copied to its destination image or buffer. This cuts the staged
+ * bytes to the compressed size & takes the decoding off the cpu.
+ *
+ * @note The staging buffer of the uploaders it records to needs storage buffer usage
+ */
+class GpuDecompressor
+{
+public:
+	/** Default constructor */
+	GpuDecompressor() = default;
+
+	/** Argumented constructor
+	 *
+	 * @param vk_context The vulkan context
+	 * @param memory_allocator The memory allocator
+	 * @param layout_allocator The layout allocator, for the descriptor set & pipeline layouts
+	 * @param shader The lz4_decompress compute shader, its push constant block is reflected
+	 * @param capacity Size of the output buffer, the largest decompressed blob it can take
+	 */
+	GpuDecompressor(
+	    VkContext const *vk_context,
+	    MemoryAllocator const *memory_allocator,
+	    LayoutAllocator *layout_allocator,
+	    Shader *shader,
+	    vk::DeviceSize capacity
+	);
+
+	/** Default move constructor */
+	GpuDecompressor(GpuDecompressor &&other) = default;
+
+	/** Default move assignment operator */
+	GpuDecompressor &operator=(GpuDecompressor &&other) = default;
+
+	/** Deleted copy constructor */
+	GpuDecompressor(GpuDecompressor const &) = delete;
+
+	/** Deleted copy assignment operator */
+	GpuDecompressor &operator=(GpuDecompressor const &) = delete;
+
+	/** Destructor */
+	~GpuDecompressor();
+
+	/** Checks if a blob fits in both @a uploader's staging buffer & the output buffer */
+	auto can_decompress(
+	    TextureUploader const &uploader,
+	    usize blob_size,
+	    usize chunk_count,
+	    vk::DeviceSize decompressed_size
+	) const -> bool;
+
+	/** Stages @a blob & records its decompression into the output buffer
+	 *
+	 * @note Flushes @a uploader first, the output buffer holds a single blob at a time. Copy it out
+	 * with copy_to_image / copy_to_buffer before the next decompression
+	 */
+	void decompress(
+	    TextureUploader &uploader,
+	    u8 const *blob,
+	    usize blob_size,
+	    span<Assets::BlobChunk const> chunks,
+	    u32 chunk_size,
+	    vk::DeviceSize decompressed_size
+	);
+
+	/** Records a copy of the decompressed blob to @a texture, offsets are relative to the blob */
+	void copy_to_image(
+	    TextureUploader &uploader,
+	    Texture &texture,
+	    vec<vk::BufferImageCopy> &&regions
+	) const;
+
+	/** Records a copy of the decompressed blob to @a buffer, offsets are relative to the blob */
+	void copy_to_buffer(
+	    TextureUploader &uploader,
+	    vk::Buffer buffer,
+	    vec<vk::BufferCopy> &&regions
+	) const;
+
+	/** Reads the decompressed blob back & compares it against @a expected, flushes @a uploader
+	 *
+	 * @param expected The blob decompressed by the cpu reference (Assets::decompress_chunked)
+	 * @returns true if the gpu output is byte-exact
+	 */
+	auto validate(TextureUploader &uploader, u8 const *expected, usize size) -> bool;
+
+	/** Trivial accessor for validation */
+	auto is_validating() const
+	{
+		return validation;
+	}
+
+	/** Trivial mutator for validation, validated loads read back & compare every blob */
+	void set_validation(bool const enabled)
+	{
+		validation = enabled;
+	}
+
+private:
+	struct PushConstants
+	{
+		u32 chunk_count;
+		u32 chunk_size;
+		u32 decompressed_size;
+	};
+
+private:
+	void create_output_buffer(vk::DeviceSize capacity);
+
+	void create_descriptor_set(LayoutAllocator *layout_allocator);
+
+	void create_pipeline(LayoutAllocator *layout_allocator, Shader *shader);
+
+	void write_descriptor_set(
+	    vk::Buffer staging_buffer,
+	    vk::DeviceSize chunks_offset,
+	    vk::DeviceSize chunks_size,
+	    vk::DeviceSize blob_offset,
+	    vk::DeviceSize blob_size,
+	    vk::DeviceSize decompressed_size
+	) const;
+
+	auto allocate_storage(TextureUploader &uploader, vk::DeviceSize size) const
+	    -> pair<u8 *, vk::DeviceSize>;
+
+private:
+	VkContext const *vk_context = {};
+	tidy_ptr<Device const> device = {};
+	MemoryAllocator const *memory_allocator = {};
+
+	Buffer output_buffer = {};
+	Buffer readback_buffer = {};
+
+	DescriptorSetLayoutWithHash descriptor_set_layout = {};
+	vk::DescriptorPool descriptor_pool = {};
+	vk::DescriptorSet descriptor_set = {};
+
+	ShaderPipeline pipeline = {};
+
+	vk::DeviceSize storage_alignment = {};
+	bool validation = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -4,9 +4,11 @@
 #include "BindlessVk/Buffers/Buffer.hpp"
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
 #include "BindlessVk/Texture/Texture.hpp"
 
 #include <AssetParser.hpp>
+#include <MappedFile.hpp>
 #include <TextureAsset.hpp>
 #include <ktx.h>
 #include <ktxvulkan.h>
@@ -15,6 +17,15 @@ namespace BINDLESSVK_NAMESPACE {
 
 class KtxLoader
 {
+private:
+	/** Location of a single face of a mip level in the ktx image data */
+	struct KtxImage
+	{
+		u32 level;
+		u32 face;
+		usize offset;
+	};
+
 public:
 	KtxLoader(
 	    VkContext const *vk_context,
@@ -25,26 +36,33 @@ public:
 	Texture load(str_view path, Texture::Type type, vk::ImageLayout final_layout, str_view name);
 
 private:
+	auto map_ktx_file(str_view path) -> bool;
+	auto parse_ktx1_file() -> bool;
+	auto parse_ktx2_file() -> bool;
+
 	void load_ktx_texture(str_view path);
 	void destroy_ktx_texture();
 
-	void stage_texture_data();
-	void write_texture_data_to_gpu(vk::ImageLayout final_layout);
+	void upload_texture_data(vk::ImageLayout final_layout);
 
 	void create_image();
 	void create_image_view();
 	void create_sampler();
 
-	auto create_texture_face_buffer_copies() -> vec<vk::BufferImageCopy>;
-
 private:
 	Device const *device {};
 	MemoryAllocator const *memory_allocator {};
+	SamplerCache *sampler_cache = {};
 
-	Buffer *const staging_buffer = {};
+	TextureUploader uploader;
 
 	Texture texture = {};
+
+	Assets::MappedFile ktx_file = {};
 	ktxTexture *ktx_texture = {};
+
+	u8 const *image_data = {};
+	vec<KtxImage> images = {};
 };
 
 } // namespace BINDLESSVK_NAMESPACE
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Texture.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Size & dimensions of a texel block, 1x1 for uncompressed formats */
+struct TexelBlock
+{
+	u32 width;
+	u32 height;
+	u32 size;
+};
+
+/** Returns the texel block of a sampled @a format, asserts on formats textures aren't created with */
+auto get_texel_block(vk::Format format) -> TexelBlock;
+
+/** Streams texture data through a bounded staging buffer
+ *
+ * Subresources are split into block-row aligned chunks, the recorded commands are submitted
+ * whenever the staging buffer fills up, so textures of any size upload with constant staging
+ * memory.
+ */
+class TextureUploader
+{
+public:
+	TextureUploader(VkContext const *vk_context, Buffer *staging_buffer);
+
+	TextureUploader(TextureUploader &&) = delete;
+	TextureUploader &operator=(TextureUploader &&) = delete;
+
+	TextureUploader(TextureUploader const &) = delete;
+	TextureUploader &operator=(TextureUploader const &) = delete;
+
+	~TextureUploader();
+
+	/** Records commands to be executed by the next submission, in order with the copies */
+	void record(fn<void(vk::CommandBuffer)> &&commands);
+
+	/** Reserves a contiguous region of the staging buffer, flushing first if it doesn't fit
+	 *
+	 * @returns Mapped pointer to and offset of the region
+	 */
+	auto allocate(vk::DeviceSize size) -> pair<u8 *, vk::DeviceSize>;
+
+	/** Records a copy of already staged regions, offsets are relative to the staging buffer */
+	void copy_staged_to_image(Texture &texture, vec<vk::BufferImageCopy> &&regions);
+
+	/** Stages & copies a tightly packed subresource, in as many chunks as it takes
+	 *
+	 * @param data Tightly packed texel blocks of the subresource
+	 * @param width Width of the subresource in texels
+	 * @param height Height of the subresource in texels
+	 * @param block Texel block of the texture's format
+	 */
+	void copy_to_image(
+	    Texture &texture,
+	    u32 mip_level,
+	    u32 layer,
+	    u8 const *data,
+	    u32 width,
+	    u32 height,
+	    TexelBlock block
+	);
+
+	/** Submits every recorded command & frees the staging buffer */
+	void flush();
+
+	/** Trivial accessor for staging_buffer */
+	auto get_staging_buffer() const
+	{
+		return staging_buffer;
+	}
+
+	/** Trivial accessor for the staging buffer's capacity */
+	auto get_capacity() const
+	{
+		return staging_buffer->get_block_size();
+	}
+
+	/** Trivial accessor for alignment, every allocation's offset is aligned to it */
+	auto get_alignment() const
+	{
+		return alignment;
+	}
+
+private:
+	auto align_offset(vk::DeviceSize offset) const -> vk::DeviceSize;
+
+private:
+	Device const *device = {};
+	Buffer *staging_buffer = {};
+
+	vk::DeviceSize alignment = {};
+	vk::DeviceSize offset = {};
+	u8 *map = {};
+
+	vec<fn<void(vk::CommandBuffer)>> commands = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
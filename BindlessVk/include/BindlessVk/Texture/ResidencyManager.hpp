@@ -0,0 +1,280 @@
+#pragma once
+
+#include "BindlessVk/Allocators/MemoryAllocator.hpp"
+#include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Common/Common.hpp"
+#include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
+#include "BindlessVk/Texture/Texture.hpp"
+#include "BindlessVk/Texture/TextureStreamer.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Keeps the mip chains of registered 2d textures within a device memory budget
+ *
+ * Shaders write the log2 of the texel width they need (+1, 0 means unused) per bindless texture
+ * into a feedback buffer which is consumed once its frame's fence is waited on, so the readback
+ * never stalls. Requested mips are paged in from host memory and the least recently requested
+ * textures get their finest mips paged out when the budget is exceeded.
+ *
+ * Streamed textures start out with placeholder levels while their levels load in the background,
+ * once loaded they're brought in one level per update, coarsest first, as far as the budget allows.
+ *
+ * Paging rebuilds the texture's image with the new mip range, the descriptor of every frame's
+ * set is re-written before the old image gets destroyed. The copies of an update are recorded into
+ * a single submission which is never waited on, paged out levels are read back once a later update
+ * finds its fence signaled.
+ */
+class ResidencyManager
+{
+public:
+	/** Value written to the feedback buffer by the shaders */
+	using Feedback = u32;
+
+public:
+	/** Default constructor */
+	ResidencyManager() = default;
+
+	/** Argumented constructor
+	 *
+	 * @param vk_context The vulkan context
+	 * @param memory_allocator The memory allocator
+	 * @param budget Device memory textures are allowed to occupy in bytes
+	 */
+	ResidencyManager(
+	    VkContext const *vk_context,
+	    MemoryAllocator const *memory_allocator,
+	    vk::DeviceSize budget
+	);
+
+	/** Default move constructor */
+	ResidencyManager(ResidencyManager &&other) = default;
+
+	/** Default move assignment operator */
+	ResidencyManager &operator=(ResidencyManager &&other) = default;
+
+	/** Deleted copy constructor */
+	ResidencyManager(ResidencyManager const &) = delete;
+
+	/** Deleted copy assignment operator */
+	ResidencyManager &operator=(ResidencyManager const &) = delete;
+
+	/** Destructor */
+	~ResidencyManager();
+
+	/** Starts managing the residency of @a texture
+	 *
+	 * @param texture A 2d texture in shader read only layout, has to outlive the manager
+	 * @param descriptor_index Index of the texture in the bindless textures array
+	 *
+	 * @note Registering the same texture twice is a no-op, streamed textures get their descriptor
+	 * index assigned
+	 */
+	void register_texture(Texture *texture, u32 descriptor_index);
+
+	/** Starts managing @a texture & loading its levels in the background
+	 *
+	 * @param texture A 2d texture in shader read only layout holding placeholder levels, which
+	 * stand in for the coarsest levels of the full chain until they're loaded. Has to outlive the
+	 * manager
+	 * @param full_size Size of the finest level once streamed in
+	 * @param load_levels Produces every level of the full chain, ran on a streaming thread. No
+	 * levels means they failed to load, the texture is then left on its placeholder
+	 */
+	void stream_texture(
+	    Texture *texture,
+	    pair<u32, u32> full_size,
+	    TextureStreamer::LevelLoader &&load_levels
+	);
+
+	/** Consumes the feedback of a retired frame, pages mips in/out & re-writes the frame's set
+	 *
+	 * @param frame_index Index of the frame whose fence has just been waited on
+	 * @param feedback Feedback written by the frame, indexed by descriptor index. Zeroed after
+	 * being consumed
+	 * @param descriptor_set The frame's descriptor set containing the bindless textures
+	 * @param binding Binding of the bindless textures array
+	 */
+	void update(
+	    u32 frame_index,
+	    span<Feedback> feedback,
+	    vk::DescriptorSet descriptor_set,
+	    u32 binding
+	);
+
+	/** Trivial accessor for budget */
+	auto get_budget() const
+	{
+		return budget;
+	}
+
+	/** Trivial mutator for budget, applied on next update */
+	void set_budget(vk::DeviceSize new_budget)
+	{
+		budget = new_budget;
+	}
+
+	/** Trivial accessor for resident_size */
+	auto get_resident_size() const
+	{
+		return resident_size;
+	}
+
+	/** Trivial accessor for the number of managed textures */
+	auto get_texture_count() const
+	{
+		return textures.size();
+	}
+
+private:
+	struct ResidentTexture
+	{
+		Texture *texture;
+		u32 descriptor_index;
+
+		pair<u32, u32> full_size;
+		u32 full_mip_levels;
+		TexelBlock block;
+
+		u32 resident_mip;
+		u32 tail_mip;
+
+		u32 requested_mip;
+		u64 last_requested_frame;
+
+		/** Host copies of paged out (or streamed in) levels, indexed by mip level */
+		vec<vec<u8>> paged_out_levels;
+
+		/** Levels are still being produced by the streamer */
+		bool is_loading;
+
+		/** Resident levels don't hold the texture's data yet */
+		bool is_placeholder;
+
+		/** Loaded levels are being brought in one per update */
+		bool is_streaming;
+
+		/** Paged by a submission that hasn't executed yet, it's left alone until it has */
+		bool is_paging;
+	};
+
+	struct PageInRequest
+	{
+		usize index;
+		u32 mip;
+
+		/** Streaming refinements only take the free budget, they never page anything out */
+		bool is_refinement;
+	};
+
+	struct RetiredImage
+	{
+		u64 frame;
+		Image image;
+		vk::ImageView image_view;
+	};
+
+	struct PendingReadback
+	{
+		usize index;
+		u32 first_level;
+		u32 last_level;
+		Buffer buffer;
+	};
+
+	/** Page-ins & page-outs of an update, recorded into a single submission */
+	struct PagingBatch
+	{
+		vk::CommandBuffer cmd;
+		vk::Fence fence;
+
+		/** Host copies of the paged in levels, kept alive until the batch has executed */
+		vec<Buffer> staging_buffers;
+
+		/** Paged out levels, copied to host memory once the batch has executed */
+		vec<PendingReadback> readbacks;
+
+		/** Indices of the textures paged by the batch */
+		vec<usize> paged_indices;
+	};
+
+private:
+	auto add_texture(
+	    Texture *texture,
+	    u32 descriptor_index,
+	    pair<u32, u32> full_size,
+	    u32 full_mip_levels
+	) -> ResidentTexture &;
+
+	void destroy_retired_images();
+
+	void retire_executed_batches();
+
+	void receive_streamed_levels();
+
+	void consume_feedback(span<Feedback> feedback);
+
+	void enforce_budget();
+
+	auto collect_page_in_requests() const -> vec<PageInRequest>;
+
+	auto make_room(vk::DeviceSize size, usize requester_index) -> bool;
+
+	void page_texture(usize index, u32 mip);
+
+	auto get_recording_batch() -> PagingBatch &;
+
+	void submit_recording_batch();
+
+	auto create_level_copies(ResidentTexture const &resident, u32 first_level, u32 last_level)
+	    const -> vec<vk::BufferImageCopy>;
+
+	auto create_staging_buffer(ResidentTexture const &resident, u32 first_level, u32 last_level)
+	    const -> Buffer;
+
+	auto create_readback_buffer(ResidentTexture const &resident, u32 first_level, u32 last_level)
+	    const -> Buffer;
+
+	void read_back_levels(PendingReadback &readback);
+
+	auto create_image(ResidentTexture const &resident, u32 mip) const -> Image;
+
+	auto create_image_view(ResidentTexture const &resident, vk::Image image, u32 mip) const
+	    -> vk::ImageView;
+
+	void write_descriptors(u32 frame_index, vk::DescriptorSet descriptor_set, u32 binding);
+
+	auto calculate_level_extent(ResidentTexture const &resident, u32 level) const
+	    -> vk::Extent3D;
+
+	auto calculate_level_size(ResidentTexture const &resident, u32 level) const
+	    -> vk::DeviceSize;
+
+	auto calculate_chain_size(ResidentTexture const &resident, u32 mip) const -> vk::DeviceSize;
+
+private:
+	VkContext const *vk_context = {};
+	tidy_ptr<Device const> device = {};
+	MemoryAllocator const *memory_allocator = {};
+
+	vk::CommandPool command_pool = {};
+
+	vk::DeviceSize budget = {};
+	vk::DeviceSize resident_size = {};
+
+	u64 frame_counter = {};
+
+	vec<ResidentTexture> textures = {};
+	hash_map<Texture *, usize> texture_indices = {};
+	hash_map<u32, usize> descriptor_indices = {};
+
+	vec<RetiredImage> retired_images = {};
+
+	PagingBatch recording_batch = {};
+	vec<PagingBatch> submitted_batches = {};
+	arr<vec<u32>, max_frames_in_flight> pending_writes = {};
+
+	std::unique_ptr<TextureStreamer> streamer = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
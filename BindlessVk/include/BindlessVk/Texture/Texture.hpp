@@ -14,6 +14,9 @@ private:
 	friend class TextureLoader;
 	friend class BinaryLoader;
 	friend class KtxLoader;
+	friend class AssetLoader;
+	friend class TextureUploader;
+	friend class ResidencyManager;
 
 public:
 	enum class Type : u8
@@ -124,6 +127,7 @@ private:
 	tidy_ptr<Device const> device = {};
 
 	MemoryAllocator const *memory_allocator = {};
+	SamplerCache *sampler_cache = {};
 
 	Image image = {};
 
@@ -3,13 +3,27 @@
 #include "BindlessVk/Buffers/Buffer.hpp"
 #include "BindlessVk/Common/Common.hpp"
 #include "BindlessVk/Context/VkContext.hpp"
+#include "BindlessVk/Texture/Loaders/GpuDecompressor.hpp"
 #include "BindlessVk/Texture/Texture.hpp"
 
+#include <AssetArchive.hpp>
+
 namespace BINDLESSVK_NAMESPACE {
 
 /** Loads texture files like ktx, png, etc. */
 class TextureLoader
 {
+public:
+	/** Describes a single texture of a batched binary load */
+	struct BinaryTextureInfo
+	{
+		u8 const *pixels;
+		u32 width;
+		u32 height;
+		vk::DeviceSize size;
+		str_view debug_name;
+	};
+
 public:
 	/** Default constructor */
 	TextureLoader() = default;
@@ -45,6 +59,21 @@ public:
 	    str_view debug_name = default_debug_name
 	) const -> Texture;
 
+	/** Loads multiple textures from buffer data with as few submissions as possible
+	 *
+	 * @param infos Pixel-data & dimensions of the textures
+	 * @param type Type of the textures (eg. 2d, cubemap)
+	 * @param staging_buffer Buffer to pack the pixel-data into, it's flushed to the gpu whenever it
+	 * gets full; textures larger than it are streamed through in chunks
+	 * @param final_layout Final layout of the created textures
+	 */
+	auto load_from_binaries(
+	    span<BinaryTextureInfo const> infos,
+	    Texture::Type type,
+	    Buffer *staging_buffer,
+	    vk::ImageLayout final_layout = vk::ImageLayout::eShaderReadOnlyOptimal
+	) const -> vec<Texture>;
+
 	/** Loads a texture from a ktx(khronos texture) file
 	 *
 	 * @param name Name of the texture
@@ -60,9 +89,49 @@ public:
 	    str_view debug_name = default_debug_name
 	) const -> Texture;
 
+	/** Loads a texture from a baked .asset_texture file
+	 *
+	 * @note Baked mip chains are uploaded directly, assets without them fall back to runtime
+	 * mipmap generation. Chunked blobs are decompressed on the gpu if a gpu decompressor is set
+	 *
+	 * @param uri Path to the .asset_texture file
+	 * @param type Type of the texture (eg. 2d, cubemap)
+	 * @param layout Final layout of the created texture
+	 */
+	auto load_from_asset(
+	    str_view uri,
+	    Texture::Type type,
+	    Buffer *staging_buffer,
+	    vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+	    str_view debug_name = default_debug_name
+	) const -> Texture;
+
+	/** Loads a baked texture packed in an asset archive, read straight from the archive's mapping
+	 *
+	 * @param archive An open asset archive
+	 * @param name Path of the .asset_texture relative to the bake's output directory
+	 * @param type Type of the texture (eg. 2d, cubemap)
+	 * @param layout Final layout of the created texture
+	 */
+	auto load_from_archive(
+	    Assets::AssetArchive const *archive,
+	    str_view name,
+	    Texture::Type type,
+	    Buffer *staging_buffer,
+	    vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+	    str_view debug_name = default_debug_name
+	) const -> Texture;
+
+	/** Trivial mutator for gpu_decompressor, null decompresses assets on the cpu */
+	void set_gpu_decompressor(GpuDecompressor *decompressor)
+	{
+		gpu_decompressor = decompressor;
+	}
+
 private:
 	VkContext const *vk_context = {};
 	MemoryAllocator const *memory_allocator = {};
+	GpuDecompressor *gpu_decompressor = {};
 };
 
 } // namespace BINDLESSVK_NAMESPACE
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "BindlessVk/Common/Common.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+/** Runs texture level loaders (decoding, mip generation, etc.) on background threads
+ *
+ * Results are collected without blocking, so the render thread can pick them up as they arrive.
+ */
+class TextureStreamer
+{
+public:
+	/** Produces the texel blocks of every level of a texture, indexed by mip level */
+	using LevelLoader = fn<vec<vec<u8>>()>;
+
+	/** Levels produced by a finished loader */
+	struct StreamedLevels
+	{
+		usize id;
+		vec<vec<u8>> levels;
+	};
+
+public:
+	/** Argumented constructor
+	 *
+	 * @param thread_count Number of background threads to run the loaders on
+	 */
+	TextureStreamer(u32 thread_count);
+
+	/** Deleted move constructor */
+	TextureStreamer(TextureStreamer &&) = delete;
+
+	/** Deleted move assignment operator */
+	TextureStreamer &operator=(TextureStreamer &&) = delete;
+
+	/** Deleted copy constructor */
+	TextureStreamer(TextureStreamer const &) = delete;
+
+	/** Deleted copy assignment operator */
+	TextureStreamer &operator=(TextureStreamer const &) = delete;
+
+	/** Destructor, drops the loaders that haven't started yet & waits for the running ones */
+	~TextureStreamer();
+
+	/** Queues @a loader to be ran on a background thread, loaders start in push order */
+	void push(usize id, LevelLoader &&loader);
+
+	/** Takes the results of every loader that has finished since the last call */
+	auto pop_finished() -> vec<StreamedLevels>;
+
+private:
+	void work(std::stop_token stop_token);
+
+private:
+	std::mutex mutex = {};
+	std::condition_variable_any condition = {};
+
+	std::queue<pair<usize, LevelLoader>> loaders = {};
+	vec<StreamedLevels> finished = {};
+
+	// Declared last, so the threads are stopped & joined before the rest is destroyed
+	vec<std::jthread> threads = {};
+};
+
+} // namespace BINDLESSVK_NAMESPACE
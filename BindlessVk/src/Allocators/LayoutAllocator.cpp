@@ -52,7 +52,8 @@ auto LayoutAllocator::goc_pipeline_layout(
     vk::PipelineLayoutCreateFlags layout_flags,
     DescriptorSetLayoutWithHash graph_descriptor_set_layout,
     DescriptorSetLayoutWithHash pass_descriptor_set_layout,
-    DescriptorSetLayoutWithHash shader_descriptor_set_layout
+    DescriptorSetLayoutWithHash shader_descriptor_set_layout,
+    span<vk::PushConstantRange const> push_constant_ranges /* = {} */
 ) -> vk::PipelineLayout
 {
 	ZoneScoped;
@@ -61,7 +62,8 @@ auto LayoutAllocator::goc_pipeline_layout(
 	    layout_flags,
 	    graph_descriptor_set_layout,
 	    pass_descriptor_set_layout,
-	    shader_descriptor_set_layout
+	    shader_descriptor_set_layout,
+	    push_constant_ranges
 	);
 
 	if (!pipeline_layouts.contains(hash))
@@ -83,6 +85,7 @@ auto LayoutAllocator::goc_pipeline_layout(
 		    device->vk().createPipelineLayout(vk::PipelineLayoutCreateInfo {
 		        layout_flags,
 		        set_layouts,
+		        push_constant_ranges,
 		    })
 		);
 	}
@@ -107,7 +110,11 @@ auto LayoutAllocator::hash_descriptor_set_layout_info(
 		hash ^= hash_t(hash, static_cast<u32>(binding.stageFlags));
 		hash ^= hash_t(hash, static_cast<u32>(binding.descriptorType));
 		hash ^= hash_t(hash, static_cast<u32>(binding.descriptorCount));
-		assert_false(binding.pImmutableSamplers, "Immutable samplres are not supported");
+
+		// Samplers are deduplicated by the SamplerCache, so equal handles mean equal samplers
+		if (binding.pImmutableSamplers)
+			for (u32 i = 0; i < binding.descriptorCount; ++i)
+				hash ^= hash_t(hash, static_cast<VkSampler>(binding.pImmutableSamplers[i]));
 	}
 
 	for (auto const &binding_flag : binding_flags)
@@ -120,7 +127,8 @@ auto LayoutAllocator::hash_pipeline_layout_info(
     vk::PipelineLayoutCreateFlags layout_flags,
     DescriptorSetLayoutWithHash graph_descriptor_set_layout,
     DescriptorSetLayoutWithHash pass_descriptor_set_layout,
-    DescriptorSetLayoutWithHash shader_descriptor_set_layout
+    DescriptorSetLayoutWithHash shader_descriptor_set_layout,
+    span<vk::PushConstantRange const> push_constant_ranges
 ) -> u64
 {
 	ZoneScoped;
@@ -132,6 +140,13 @@ auto LayoutAllocator::hash_pipeline_layout_info(
 	hash ^= hash_t(hash, pass_descriptor_set_layout.hash);
 	hash ^= hash_t(hash, shader_descriptor_set_layout.hash);
 
+	for (auto const &push_constant_range : push_constant_ranges)
+	{
+		hash ^= hash_t(hash, static_cast<u32>(push_constant_range.stageFlags));
+		hash ^= hash_t(hash, push_constant_range.offset);
+		hash ^= hash_t(hash, push_constant_range.size);
+	}
+
 	return hash;
 }
 
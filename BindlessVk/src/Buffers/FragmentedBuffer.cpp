@@ -36,14 +36,18 @@ FragmentedBuffer::FragmentedBuffer(
 	ZoneScoped;
 }
 
-void FragmentedBuffer::copy_staging_to_fragment(Buffer *staging_buffer, Fragment fragment)
+void FragmentedBuffer::copy_staging_to_fragment(
+    Buffer *staging_buffer,
+    Fragment fragment,
+    usize const staging_offset /* = 0u */
+)
 {
 	ZoneScoped;
 
 	buffer.write_buffer(
 	    *staging_buffer,
 	    vk::BufferCopy {
-	        0,
+	        staging_offset,
 	        fragment.offset,
 	        fragment.length,
 	    }
@@ -77,19 +81,42 @@ void FragmentedBuffer::bind(vk::CommandBuffer cmd, u32 binding /** = 0 */) const
 	}
 }
 
-[[nodiscard]] auto FragmentedBuffer::grab_fragment(u32 size) -> Fragment
+void FragmentedBuffer::bind(vk::CommandBuffer const cmd, vk::IndexType const index_type) const
 {
 	ZoneScoped;
 
+	assert_true(
+	    type == Type::eIndex,
+	    "Fragmented buffer ({}) bound with an index type is not an index buffer",
+	    buffer.get_name()
+	);
+
+	cmd.bindIndexBuffer(*buffer.vk(), 0u, index_type);
+}
+
+[[nodiscard]] auto FragmentedBuffer::grab_fragment(u32 size, u32 const alignment /* = 4u */)
+    -> Fragment
+{
+	ZoneScoped;
+
+	size = (size + 3u) & ~3u;
+
 	for (auto &region : fragments)
-		if (region.length >= size)
+	{
+		// The padding in front of an aligned fragment is left unused
+		auto const padding = (alignment - region.offset % alignment) % alignment;
+
+		if (region.length >= size + padding)
 		{
-			region.offset += size;
+			region.offset += padding + size;
+			region.length -= padding + size;
+
 			return Fragment {
 				region.offset - size,
 				size,
 			};
 		}
+	}
 
 	assert_fail(
 	    "Failed to grab a fragment of size {}bytes out of fragmented buffer {}",
@@ -100,6 +127,73 @@ void FragmentedBuffer::bind(vk::CommandBuffer cmd, u32 binding /** = 0 */) const
 	return {};
 }
 
+[[nodiscard]] auto FragmentedBuffer::grab_fragment_at(usize const offset, u32 size) -> Fragment
+{
+	ZoneScoped;
+
+	size = (size + 3u) & ~3u;
+
+	for (auto i = usize { 0 }; i < fragments.size(); ++i)
+	{
+		auto const region = fragments[i];
+		if (offset < region.offset || offset + size > region.offset + region.length)
+			continue;
+
+		// Whatever is left in front of the fragment stays free as a region of its own
+		fragments[i] = Fragment {
+			offset + size,
+			region.offset + region.length - offset - size,
+		};
+
+		if (offset > region.offset)
+			fragments.push_back(Fragment { region.offset, offset - region.offset });
+
+		return Fragment {
+			offset,
+			size,
+		};
+	}
+
+	assert_fail(
+	    "Failed to grab a fragment of size {}bytes at offset {} out of fragmented buffer {}",
+	    size,
+	    offset,
+	    buffer.get_name()
+	);
+
+	return {};
+}
+
+auto FragmentedBuffer::find_free_index(
+    u32 const count,
+    u32 const stride,
+    usize const min_index /* = 0u */
+) const -> usize
+{
+	ZoneScoped;
+
+	auto const size = usize { count } * stride;
+	auto index = std::numeric_limits<usize>::max();
+
+	for (auto const &region : fragments)
+	{
+		auto const first = std::max((region.offset + stride - 1u) / stride, min_index);
+
+		if (first * stride + size <= region.offset + region.length)
+			index = std::min(index, first);
+	}
+
+	assert_true(
+	    index != std::numeric_limits<usize>::max(),
+	    "Failed to find {} free elements of stride {} out of fragmented buffer {}",
+	    count,
+	    stride,
+	    buffer.get_name()
+	);
+
+	return index;
+}
+
 void FragmentedBuffer::return_fragment(Fragment returned_fragment)
 {
 	ZoneScoped;
@@ -20,12 +20,16 @@ Device::Device(Gpu *gpu)
 	auto const queues_info = create_queues_create_infos(gpu);
 	auto const requirements = gpu->get_requirements();
 
+	// Block-compressed textures are opportunistic, TextureLoader transcodes them when unsupported
+	auto physical_device_features = requirements.physical_device_features;
+	physical_device_features.textureCompressionBC = gpu->vk().getFeatures().textureCompressionBC;
+
 	device = gpu->vk().createDevice(vk::DeviceCreateInfo {
 	    {},
 	    queues_info,
 	    {},
 	    requirements.logical_device_extensions,
-	    &requirements.physical_device_features,
+	    &physical_device_features,
 	    &dynamic_rendering_features,
 	});
 
@@ -113,6 +117,26 @@ void Device::immediate_submit(
 	device.resetCommandPool(immediate_cmd_pool);
 }
 
+void Device::submit(
+    vk::CommandBuffer const cmd,
+    vk::Fence const fence,
+    vk::QueueFlags const queue /* = vk::QueueFlagBits::eGraphics */
+) const
+{
+	ZoneScoped;
+
+	auto const submit_info = vk::SubmitInfo { 0u, {}, {}, 1u, &cmd, 0u, {}, {} };
+
+	if (queue == vk::QueueFlagBits::eGraphics)
+		graphics_queue.submit(submit_info, fence);
+
+	else if (queue == vk::QueueFlagBits::eCompute)
+		compute_queue.submit(submit_info, fence);
+
+	else
+		assert_fail("Invalid queue flags for submit");
+}
+
 auto Device::create_queues_create_infos(Gpu *gpu) const -> vec<vk::DeviceQueueCreateInfo>
 {
 	ZoneScoped;
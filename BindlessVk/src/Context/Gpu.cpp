@@ -59,6 +59,15 @@ auto Gpu::pick_by_score(
 	return adequate_gpus[high_score_index];
 }
 
+auto Gpu::supports_format(vk::Format const format, vk::FormatFeatureFlags const features) const
+    -> bool
+{
+	ZoneScoped;
+
+	auto const properties = physical_device.getFormatProperties(format);
+	return (properties.optimalTilingFeatures & features) == features;
+}
+
 void Gpu::calculate_max_sample_counts()
 {
 	ZoneScoped;
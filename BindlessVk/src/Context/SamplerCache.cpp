@@ -0,0 +1,92 @@
+#include "BindlessVk/Context/SamplerCache.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+SamplerCache::SamplerCache(Device *const device): device(device)
+{
+	ZoneScoped;
+}
+
+SamplerCache::~SamplerCache()
+{
+	ZoneScoped;
+
+	if (!device)
+		return;
+
+	for (auto const &[hash, entry] : samplers)
+		device->vk().destroySampler(entry.sampler);
+}
+
+auto SamplerCache::acquire(vk::SamplerCreateInfo const &info) -> vk::Sampler
+{
+	ZoneScoped;
+
+	assert_false(info.pNext, "Extended sampler create infos are not supported");
+
+	auto const lock = std::scoped_lock(mutex);
+	auto const hash = hash_sampler_info(info);
+
+	auto it = samplers.find(hash);
+	if (it == samplers.end())
+	{
+		auto const sampler = device->vk().createSampler(info);
+
+		it = samplers.emplace(hash, Entry { info, sampler, 0u }).first;
+		sampler_hashes.emplace(static_cast<VkSampler>(sampler), hash);
+	}
+
+	assert_true(it->second.info == info, "Sampler create info hash collision");
+
+	++it->second.ref_count;
+	return it->second.sampler;
+}
+
+void SamplerCache::release(vk::Sampler const sampler)
+{
+	ZoneScoped;
+
+	if (!sampler)
+		return;
+
+	auto const lock = std::scoped_lock(mutex);
+
+	auto const hash_it = sampler_hashes.find(static_cast<VkSampler>(sampler));
+	assert_false(hash_it == sampler_hashes.end(), "Released sampler is not owned by the cache");
+
+	auto &entry = samplers.at(hash_it->second);
+	if (--entry.ref_count)
+		return;
+
+	device->vk().destroySampler(entry.sampler);
+	samplers.erase(hash_it->second);
+	sampler_hashes.erase(hash_it);
+}
+
+auto SamplerCache::hash_sampler_info(vk::SamplerCreateInfo const &info) const -> u64
+{
+	ZoneScoped;
+
+	auto hash = u64 {};
+
+	hash ^= hash_t(hash, static_cast<u32>(info.flags));
+	hash ^= hash_t(hash, static_cast<u32>(info.magFilter));
+	hash ^= hash_t(hash, static_cast<u32>(info.minFilter));
+	hash ^= hash_t(hash, static_cast<u32>(info.mipmapMode));
+	hash ^= hash_t(hash, static_cast<u32>(info.addressModeU));
+	hash ^= hash_t(hash, static_cast<u32>(info.addressModeV));
+	hash ^= hash_t(hash, static_cast<u32>(info.addressModeW));
+	hash ^= hash_t(hash, info.mipLodBias);
+	hash ^= hash_t(hash, info.anisotropyEnable);
+	hash ^= hash_t(hash, info.maxAnisotropy);
+	hash ^= hash_t(hash, info.compareEnable);
+	hash ^= hash_t(hash, static_cast<u32>(info.compareOp));
+	hash ^= hash_t(hash, info.minLod);
+	hash ^= hash_t(hash, info.maxLod);
+	hash ^= hash_t(hash, static_cast<u32>(info.borderColor));
+	hash ^= hash_t(hash, info.unnormalizedCoordinates);
+
+	return hash;
+}
+
+} // namespace BINDLESSVK_NAMESPACE
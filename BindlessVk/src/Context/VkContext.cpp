@@ -10,6 +10,7 @@ VkContext::VkContext(Instance *instance, Surface *surface, Gpu *gpu, Queues *que
     , gpu(gpu)
     , queues(queues)
     , device(device)
+    , sampler_cache(std::make_unique<SamplerCache>(device))
 {
 	ZoneScoped;
 
@@ -0,0 +1,487 @@
+#include "BindlessVk/Model/Loaders/GlbReader.hpp"
+
+#include <cstring>
+#include <nlohmann/json.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+namespace {
+
+constexpr auto glb_magic = u32 { 0x46546C67 };
+constexpr auto glb_version = u32 { 2u };
+constexpr auto glb_json_chunk = u32 { 0x4E4F534A };
+constexpr auto glb_binary_chunk = u32 { 0x004E4942 };
+
+using json = nlohmann::json;
+
+/** Numbers of @a key's array, @a values are left as they are if it's missing */
+template<typename T>
+void read_numbers(json const &object, char const *const key, vec<T> &values)
+{
+	if (auto const it = object.find(key); it != object.end())
+		values = it->get<vec<T>>();
+}
+
+/** Reads every object of @a key's array, constructing an element for each of them */
+template<typename T, typename Read>
+void read_objects(json const &object, char const *const key, vec<T> &objects, Read &&read)
+{
+	if (auto const it = object.find(key); it != object.end())
+		for (auto const &element : *it)
+			read(element, objects.emplace_back());
+}
+
+auto get_accessor_type(str_view const type) -> i32
+{
+	if (type == "SCALAR")
+		return TINYGLTF_TYPE_SCALAR;
+	if (type == "VEC2")
+		return TINYGLTF_TYPE_VEC2;
+	if (type == "VEC3")
+		return TINYGLTF_TYPE_VEC3;
+	if (type == "VEC4")
+		return TINYGLTF_TYPE_VEC4;
+	if (type == "MAT2")
+		return TINYGLTF_TYPE_MAT2;
+	if (type == "MAT3")
+		return TINYGLTF_TYPE_MAT3;
+	if (type == "MAT4")
+		return TINYGLTF_TYPE_MAT4;
+
+	assert_fail("Unknown gltf accessor type: {}", type);
+	return -1;
+}
+
+/** Decodes the percent-encoded characters of a relative uri, like tinygltf does */
+auto decode_uri(str_view const uri) -> str
+{
+	auto const hex_value = [](char const c) -> i32 {
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+
+		return -1;
+	};
+
+	auto decoded = str {};
+	decoded.reserve(uri.size());
+
+	for (auto i = usize { 0u }; i < uri.size(); ++i)
+	{
+		auto const high = i + 2u < uri.size() && uri[i] == '%' ? hex_value(uri[i + 1u]) : -1;
+		auto const low = high != -1 ? hex_value(uri[i + 2u]) : -1;
+
+		if (low == -1)
+		{
+			decoded.push_back(uri[i]);
+			continue;
+		}
+
+		decoded.push_back(static_cast<char>(high * 16 + low));
+		i += 2u;
+	}
+
+	return decoded;
+}
+
+void read_texture_info(json const &object, char const *const key, i32 &index, i32 &tex_coord)
+{
+	if (auto const it = object.find(key); it != object.end())
+	{
+		index = it->value("index", index);
+		tex_coord = it->value("texCoord", tex_coord);
+	}
+}
+
+/** Textures also go in the legacy parameter map, which is what tinygltf users like us read */
+void set_texture_parameter(tinygltf::Material &material, str const &name, i32 index, i32 tex_coord)
+{
+	material.values[name].json_double_value = {
+		{ "index", static_cast<f64>(index) },
+		{ "texCoord", static_cast<f64>(tex_coord) },
+	};
+}
+
+void read_material(json const &object, tinygltf::Material &material)
+{
+	auto &pbr = material.pbrMetallicRoughness;
+
+	material.name = object.value("name", material.name);
+	material.alphaMode = object.value("alphaMode", material.alphaMode);
+	material.alphaCutoff = object.value("alphaCutoff", material.alphaCutoff);
+	material.doubleSided = object.value("doubleSided", material.doubleSided);
+	read_numbers(object, "emissiveFactor", material.emissiveFactor);
+
+	read_texture_info(
+	    object,
+	    "normalTexture",
+	    material.normalTexture.index,
+	    material.normalTexture.texCoord
+	);
+
+	read_texture_info(
+	    object,
+	    "occlusionTexture",
+	    material.occlusionTexture.index,
+	    material.occlusionTexture.texCoord
+	);
+
+	read_texture_info(
+	    object,
+	    "emissiveTexture",
+	    material.emissiveTexture.index,
+	    material.emissiveTexture.texCoord
+	);
+
+	if (auto const it = object.find("pbrMetallicRoughness"); it != object.end())
+	{
+		read_numbers(*it, "baseColorFactor", pbr.baseColorFactor);
+		pbr.metallicFactor = it->value("metallicFactor", pbr.metallicFactor);
+		pbr.roughnessFactor = it->value("roughnessFactor", pbr.roughnessFactor);
+
+		read_texture_info(
+		    *it,
+		    "baseColorTexture",
+		    pbr.baseColorTexture.index,
+		    pbr.baseColorTexture.texCoord
+		);
+
+		read_texture_info(
+		    *it,
+		    "metallicRoughnessTexture",
+		    pbr.metallicRoughnessTexture.index,
+		    pbr.metallicRoughnessTexture.texCoord
+		);
+	}
+
+	if (pbr.baseColorTexture.index != -1)
+		set_texture_parameter(
+		    material,
+		    "baseColorTexture",
+		    pbr.baseColorTexture.index,
+		    pbr.baseColorTexture.texCoord
+		);
+
+	if (pbr.metallicRoughnessTexture.index != -1)
+		set_texture_parameter(
+		    material,
+		    "metallicRoughnessTexture",
+		    pbr.metallicRoughnessTexture.index,
+		    pbr.metallicRoughnessTexture.texCoord
+		);
+}
+
+void read_primitive(json const &object, tinygltf::Primitive &primitive)
+{
+	primitive.indices = object.value("indices", primitive.indices);
+	primitive.material = object.value("material", primitive.material);
+	primitive.mode = object.value("mode", primitive.mode);
+
+	if (auto const it = object.find("attributes"); it != object.end())
+		for (auto const &[attribute, accessor] : it->items())
+			primitive.attributes[attribute] = accessor.get<i32>();
+}
+
+void read_mesh(json const &object, tinygltf::Mesh &mesh)
+{
+	mesh.name = object.value("name", mesh.name);
+	read_objects(object, "primitives", mesh.primitives, read_primitive);
+}
+
+void read_node(json const &object, tinygltf::Node &node)
+{
+	node.name = object.value("name", node.name);
+	node.mesh = object.value("mesh", node.mesh);
+
+	read_numbers(object, "children", node.children);
+	read_numbers(object, "matrix", node.matrix);
+	read_numbers(object, "translation", node.translation);
+	read_numbers(object, "rotation", node.rotation);
+	read_numbers(object, "scale", node.scale);
+}
+
+void read_scene(json const &object, tinygltf::Scene &scene)
+{
+	scene.name = object.value("name", scene.name);
+	read_numbers(object, "nodes", scene.nodes);
+}
+
+void read_accessor(json const &object, tinygltf::Accessor &accessor)
+{
+	accessor.bufferView = object.value("bufferView", accessor.bufferView);
+	accessor.byteOffset = object.value("byteOffset", accessor.byteOffset);
+	accessor.componentType = object.value("componentType", accessor.componentType);
+	accessor.normalized = object.value("normalized", accessor.normalized);
+	accessor.count = object.value("count", accessor.count);
+	accessor.name = object.value("name", accessor.name);
+
+	if (auto const it = object.find("type"); it != object.end())
+		accessor.type = get_accessor_type(it->get_ref<str const &>());
+
+	read_numbers(object, "min", accessor.minValues);
+	read_numbers(object, "max", accessor.maxValues);
+}
+
+void read_buffer_view(json const &object, tinygltf::BufferView &buffer_view)
+{
+	buffer_view.buffer = object.value("buffer", buffer_view.buffer);
+	buffer_view.byteOffset = object.value("byteOffset", buffer_view.byteOffset);
+	buffer_view.byteLength = object.value("byteLength", buffer_view.byteLength);
+	buffer_view.byteStride = object.value("byteStride", buffer_view.byteStride);
+	buffer_view.target = object.value("target", buffer_view.target);
+	buffer_view.name = object.value("name", buffer_view.name);
+}
+
+void read_texture(json const &object, tinygltf::Texture &texture)
+{
+	texture.source = object.value("source", texture.source);
+	texture.sampler = object.value("sampler", texture.sampler);
+	texture.name = object.value("name", texture.name);
+}
+
+void read_image(json const &object, tinygltf::Image &image)
+{
+	image.uri = decode_uri(object.value("uri", str {}));
+	image.bufferView = object.value("bufferView", image.bufferView);
+	image.mimeType = object.value("mimeType", image.mimeType);
+	image.name = object.value("name", image.name);
+}
+
+/** Buffers stay empty, only their uri & size are kept */
+void read_buffer(json const &object, tinygltf::Buffer &buffer, usize &byte_length)
+{
+	buffer.uri = decode_uri(object.value("uri", str {}));
+	buffer.name = object.value("name", buffer.name);
+	byte_length = object.value("byteLength", usize { 0u });
+}
+
+/** Reads every part of the json the gltf loader consumes into @a model
+ *
+ * @note Throws json::type_error if a field has the wrong type
+ */
+void read_model(json const &root, tinygltf::Model &model, vec<usize> &buffer_sizes)
+{
+	model.defaultScene = root.value("scene", model.defaultScene);
+
+	read_objects(root, "scenes", model.scenes, read_scene);
+	read_objects(root, "nodes", model.nodes, read_node);
+	read_objects(root, "meshes", model.meshes, read_mesh);
+	read_objects(root, "materials", model.materials, read_material);
+	read_objects(root, "textures", model.textures, read_texture);
+	read_objects(root, "images", model.images, read_image);
+	read_objects(root, "accessors", model.accessors, read_accessor);
+	read_objects(root, "bufferViews", model.bufferViews, read_buffer_view);
+
+	if (auto const it = root.find("buffers"); it != root.end())
+		for (auto const &buffer : *it)
+			read_buffer(buffer, model.buffers.emplace_back(), buffer_sizes.emplace_back());
+}
+
+auto get_component_size(i32 const component_type) -> usize
+{
+	switch (component_type)
+	{
+	case TINYGLTF_COMPONENT_TYPE_BYTE:
+	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return 1u;
+
+	case TINYGLTF_COMPONENT_TYPE_SHORT:
+	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return 2u;
+
+	case TINYGLTF_COMPONENT_TYPE_INT:
+	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+	case TINYGLTF_COMPONENT_TYPE_FLOAT: return 4u;
+
+	case TINYGLTF_COMPONENT_TYPE_DOUBLE: return 8u;
+
+	default: assert_fail("Unknown gltf component type: {}", component_type);
+	}
+
+	return 0u;
+}
+
+} // namespace
+
+void GlbReader::read(str_view const file_path, tinygltf::Model &model)
+{
+	ZoneScoped;
+
+	directory = std::filesystem::path(file_path).parent_path();
+
+	assert_true(
+	    file.open(str(file_path).c_str()),
+	    "Failed to map glb file: \npath: {}",
+	    file_path
+	);
+
+	// Only the json chunk is parsed, buffers & images are read in place from the mapping
+	auto const json_chunk = read_container();
+	auto const root = json::parse(json_chunk.begin(), json_chunk.end(), nullptr, false);
+	assert_false(root.is_discarded() || !root.is_object(), "Invalid glb json: {}", file_path);
+
+	// Wrongly typed fields throw, they're reported like any other malformed file
+	auto buffer_sizes = vec<usize> {};
+	try
+	{
+		read_model(root, model, buffer_sizes);
+	}
+	catch (json::exception const &exception)
+	{
+		assert_fail("Invalid glb json: {}\n{}", file_path, exception.what());
+	}
+
+	read_external_buffers(model, buffer_sizes);
+	validate_accessors(model);
+	read_images(model);
+}
+
+auto GlbReader::read_container() -> str_view
+{
+	ZoneScoped;
+
+	auto const read_u32 = [this](usize const offset) {
+		auto value = u32 {};
+		memcpy(&value, file.data() + offset, sizeof(u32));
+		return value;
+	};
+
+	// header (magic, version, length), followed by chunks of (length, type, data)
+	auto constexpr header_size = usize { 12u };
+	auto constexpr chunk_header_size = usize { 8u };
+
+	assert_true(
+	    file.size() >= header_size + chunk_header_size && read_u32(0u) == glb_magic
+	        && read_u32(4u) == glb_version && read_u32(8u) >= header_size + chunk_header_size
+	        && read_u32(8u) <= file.size(),
+	    "Invalid glb header"
+	);
+
+	auto const length = usize { read_u32(8u) };
+
+	auto const json_size = usize { read_u32(header_size) };
+	auto const json_offset = header_size + chunk_header_size;
+	assert_true(
+	    read_u32(header_size + 4u) == glb_json_chunk && json_size <= length - json_offset,
+	    "Invalid glb json chunk"
+	);
+
+	// The binary chunk is optional
+	auto const binary_header_offset = json_offset + json_size;
+	if (binary_header_offset + chunk_header_size <= length
+	    && read_u32(binary_header_offset + 4u) == glb_binary_chunk)
+	{
+		auto const binary_size = usize { read_u32(binary_header_offset) };
+		auto const binary_offset = binary_header_offset + chunk_header_size;
+		assert_true(binary_size <= length - binary_offset, "Invalid glb binary chunk");
+
+		binary_chunk = { file.data() + binary_offset, binary_size };
+	}
+
+	return { reinterpret_cast<char const *>(file.data()) + json_offset, json_size };
+}
+
+void GlbReader::read_external_buffers(
+    tinygltf::Model const &model,
+    vec<usize> const &buffer_sizes
+)
+{
+	ZoneScoped;
+
+	buffers.reserve(model.buffers.size());
+	for (auto i = usize { 0u }; i < model.buffers.size(); ++i)
+	{
+		auto const &uri = model.buffers[i].uri;
+
+		// Only the first buffer may refer to the binary chunk
+		auto const bytes = uri.empty() && i == 0u ? binary_chunk : map_external_file(uri);
+		assert_true(
+		    bytes.size() >= buffer_sizes[i],
+		    "Glb buffer {} is smaller than its byteLength ({} < {})",
+		    i,
+		    bytes.size(),
+		    buffer_sizes[i]
+		);
+
+		buffers.push_back(bytes.first(buffer_sizes[i]));
+	}
+}
+
+void GlbReader::read_images(tinygltf::Model const &model)
+{
+	ZoneScoped;
+
+	images.reserve(model.images.size());
+	for (auto const &image : model.images)
+	{
+		if (image.bufferView == -1)
+		{
+			images.push_back(map_external_file(image.uri));
+			continue;
+		}
+
+		assert_true(
+		    image.bufferView >= 0 && static_cast<usize>(image.bufferView) < model.bufferViews.size(),
+		    "Glb image refers to a non-existent buffer view: {}",
+		    image.bufferView
+		);
+
+		auto const &view = model.bufferViews[image.bufferView];
+		images.push_back(buffers[view.buffer].subspan(view.byteOffset, view.byteLength));
+	}
+}
+
+void GlbReader::validate_accessors(tinygltf::Model const &model) const
+{
+	ZoneScoped;
+
+	// Accessors are read straight from the mapping, so everything they touch has to be in it
+	for (auto const &view : model.bufferViews)
+	{
+		assert_true(
+		    view.buffer >= 0 && static_cast<usize>(view.buffer) < buffers.size()
+		        && view.byteOffset <= buffers[view.buffer].size()
+		        && view.byteLength <= buffers[view.buffer].size() - view.byteOffset,
+		    "Glb buffer view is out of range of its buffer"
+		);
+	}
+
+	for (auto const &accessor : model.accessors)
+	{
+		assert_true(
+		    accessor.bufferView >= 0
+		        && static_cast<usize>(accessor.bufferView) < model.bufferViews.size(),
+		    "Glb accessor without a buffer view (sparse accessors aren't supported)"
+		);
+
+		assert_true(accessor.type != -1, "Glb accessor without a type");
+
+		if (!accessor.count)
+			continue;
+
+		auto const &view = model.bufferViews[accessor.bufferView];
+		auto const element_size = get_component_size(accessor.componentType)
+		                          * tinygltf::GetNumComponentsInType(accessor.type);
+
+		auto const stride = view.byteStride ? view.byteStride : element_size;
+		auto const end = accessor.byteOffset + stride * (accessor.count - 1u) + element_size;
+
+		assert_true(end <= view.byteLength, "Glb accessor is out of range of its buffer view");
+	}
+}
+
+auto GlbReader::map_external_file(str_view const uri) -> span<u8 const>
+{
+	ZoneScoped;
+
+	assert_false(uri.starts_with("data:"), "Embedded base64 data isn't supported in glb files");
+
+	auto const path = (directory / uri).string();
+	auto &external_file = external_files.emplace_back();
+
+	assert_true(external_file.open(path.c_str()), "Failed to map glb dependency: {}", path);
+	return { external_file.data(), external_file.size() };
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -2,10 +2,22 @@
 
 
 #include "BindlessVk/Buffers/Buffer.hpp"
+#include "BindlessVk/Texture/Loaders/BinaryLoader.hpp"
 #include "tracy/Tracy.hpp"
 
+#include <TextureMips.hpp>
+#include <stb_image.h>
+
 namespace BINDLESSVK_NAMESPACE {
 
+static_assert(
+    sizeof(Model::Vertex) == sizeof(Assets::MeshVertex)
+        && offsetof(Model::Vertex, normal) == offsetof(Assets::MeshVertex, normal)
+        && offsetof(Model::Vertex, tangent) == offsetof(Assets::MeshVertex, tangent)
+        && offsetof(Model::Vertex, uv) == offsetof(Assets::MeshVertex, uv),
+    "Vertices are encoded straight from Model::Vertex, it has to be laid out like MeshVertex"
+);
+
 auto static mat4_from_f64ptr(f64 const *const ptr) -> mat4
 {
 	auto mat = mat4 {};
@@ -31,6 +43,51 @@ void static translate(mat4 &mat, vec3 v)
 	mat[3 * 4 + 2] += v[2];
 }
 
+/** Decodes an encoded image & generates its full mip chain, empty if decoding fails */
+auto static decode_image_levels(vec<u8> const &encoded) -> vec<vec<u8>>
+{
+	ZoneScoped;
+
+	auto width = i32 {};
+	auto height = i32 {};
+	auto channels = i32 {};
+	auto const pixels = std::unique_ptr<u8, void (*)(void *)> {
+		stbi_load_from_memory(
+		    encoded.data(),
+		    static_cast<i32>(encoded.size()),
+		    &width,
+		    &height,
+		    &channels,
+		    STBI_rgb_alpha
+		),
+		&stbi_image_free,
+	};
+
+	if (!pixels)
+		return {};
+
+	auto mip_sizes = vec<usize> {};
+	auto const chain = Assets::generate_mip_chain(
+	    pixels.get(),
+	    static_cast<u32>(width),
+	    static_cast<u32>(height),
+	    true,
+	    mip_sizes
+	);
+
+	auto levels = vec<vec<u8>> {};
+	levels.reserve(mip_sizes.size());
+
+	auto offset = usize {};
+	for (auto const mip_size : mip_sizes)
+	{
+		levels.emplace_back(chain.begin() + offset, chain.begin() + offset + mip_size);
+		offset += mip_size;
+	}
+
+	return levels;
+}
+
 void static scale(mat4 &mat, vec3 v)
 {
 	mat[0 * 4 + 0] *= v[0];
@@ -53,7 +110,9 @@ GltfLoader::GltfLoader(
     VkContext const *const vk_context,
     MemoryAllocator const *const memory_allocator,
     TextureLoader const *const texture_loader,
-    FragmentedBuffer *const vertex_buffer,
+    ResidencyManager *const residency_manager,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
     FragmentedBuffer *const index_buffer,
     Buffer *const staging_vertex_buffer,
     Buffer *const staging_index_buffer,
@@ -62,7 +121,9 @@ GltfLoader::GltfLoader(
     : vk_context(vk_context)
     , memory_allocator(memory_allocator)
     , texture_loader(texture_loader)
-    , vertex_buffer(vertex_buffer)
+    , residency_manager(residency_manager)
+    , position_buffer(position_buffer)
+    , attribute_buffer(attribute_buffer)
     , index_buffer(index_buffer)
     , staging_vertex_buffer(staging_vertex_buffer)
     , staging_index_buffer(staging_index_buffer)
@@ -71,11 +132,16 @@ GltfLoader::GltfLoader(
 	ZoneScoped;
 }
 
-auto GltfLoader::load_from_ascii(str_view const file_path, str_view const debug_name) -> Model
+auto GltfLoader::load_from_ascii(
+    str_view const file_path,
+    str_view const debug_name,
+    Model::VertexEncoding const vertex_encoding
+) -> Model
 {
 	ZoneScoped;
 
 	model.debug_name = debug_name;
+	model.vertex_encoding = vertex_encoding;
 
 	load_gltf_model_from_ascii(file_path);
 
@@ -89,6 +155,29 @@ auto GltfLoader::load_from_ascii(str_view const file_path, str_view const debug_
 	return std::move(model);
 }
 
+auto GltfLoader::load_from_binary(
+    str_view const file_path,
+    str_view const debug_name,
+    Model::VertexEncoding const vertex_encoding
+) -> Model
+{
+	ZoneScoped;
+
+	model.debug_name = debug_name;
+	model.vertex_encoding = vertex_encoding;
+
+	load_gltf_model_from_binary(file_path);
+
+	load_textures();
+
+	load_material_parameters();
+
+	stage_mesh_data();
+	write_mesh_data_to_gpu();
+
+	return std::move(model);
+}
+
 void GltfLoader::load_gltf_model_from_ascii(str_view const file_path)
 {
 	ZoneScoped;
@@ -96,6 +185,8 @@ void GltfLoader::load_gltf_model_from_ascii(str_view const file_path)
 	tinygltf::TinyGLTF gltf_context;
 	str err, warn;
 
+	gltf_context.SetImageLoader(&GltfLoader::defer_image_decoding, nullptr);
+
 	assert_true(
 	    gltf_context.LoadASCIIFromFile(&gltf_model, &err, &warn, file_path.data()),
 	    "Failed to load gltf file: \nname: {}\npath: {}\nerr: {}",
@@ -108,27 +199,228 @@ void GltfLoader::load_gltf_model_from_ascii(str_view const file_path)
 		log_wrn("gltf warning -> ", warn);
 }
 
+void GltfLoader::load_gltf_model_from_binary(str_view const file_path)
+{
+	ZoneScoped;
+
+	// Buffers & images stay in the mapping, the model only gets their views
+	glb_reader.read(file_path, gltf_model);
+}
+
+auto GltfLoader::defer_image_decoding(
+    tinygltf::Image *const image,
+    i32 const image_index,
+    str *const err,
+    str *const warn,
+    i32 const requested_width,
+    i32 const requested_height,
+    u8 const *const bytes,
+    i32 const size,
+    void *const user_data
+) -> bool
+{
+	ZoneScoped;
+
+	// Keep the encoded bytes around, load_textures decodes all images in parallel
+	image->image.assign(bytes, bytes + size);
+	return true;
+}
+
 void GltfLoader::load_textures()
 {
 	ZoneScoped;
 
-	model.textures.reserve(gltf_model.images.size());
+	if (residency_manager)
+	{
+		stream_textures();
+		return;
+	}
+
+	auto const image_count = gltf_model.images.size();
+
+	auto decoded_images = std::queue<DecodedImage> {};
+	auto decoded_images_mutex = std::mutex {};
+	auto decoded_images_condition = std::condition_variable {};
+
+	auto next_image = std::atomic<u32> {};
+	auto const decode_images = [&]() {
+		for (auto index = next_image++; index < image_count; index = next_image++)
+		{
+			auto decoded_image = decode_image(index);
+
+			auto const lock = std::scoped_lock(decoded_images_mutex);
+			decoded_images.push(std::move(decoded_image));
+			decoded_images_condition.notify_one();
+		}
+	};
+
+	// Declared after the shared state, so they're joined first if staging throws
+	auto const worker_count = std::min<usize>(std::thread::hardware_concurrency(), image_count);
+	auto workers = vec<std::jthread> {};
+	for (usize i = 0; i < std::max<usize>(worker_count, 1u); ++i)
+		workers.emplace_back(decode_images);
+
+	// Stage images as they finish decoding, overlapping the staging and copies with the decodes
+	auto loader = BinaryLoader(vk_context, memory_allocator, staging_texture_buffer);
+	loader.begin_batch(image_count);
+
+	for (usize i = 0; i < image_count; ++i)
+	{
+		auto lock = std::unique_lock(decoded_images_mutex);
+		decoded_images_condition.wait(lock, [&]() { return !decoded_images.empty(); });
+
+		auto const decoded_image = std::move(decoded_images.front());
+		decoded_images.pop();
+		lock.unlock();
+
+		auto const &image = gltf_model.images[decoded_image.index];
+		assert_true(
+		    decoded_image.pixels,
+		    "Failed to decode gltf image: \nname: {}\nuri: {}",
+		    model.debug_name,
+		    image.uri
+		);
+
+		auto const width = static_cast<u32>(decoded_image.width);
+		auto const height = static_cast<u32>(decoded_image.height);
+
+		loader.add_to_batch(
+		    decoded_image.index,
+		    TextureLoader::BinaryTextureInfo {
+		        decoded_image.pixels.get(),
+		        width,
+		        height,
+		        static_cast<vk::DeviceSize>(width) * height * 4u,
+		        image.uri,
+		    }
+		);
+	}
+
+	model.textures = loader.end_batch();
+}
+
+auto GltfLoader::decode_image(u32 const index) -> DecodedImage
+{
+	ZoneScoped;
+
+	auto const encoded = get_encoded_image(index);
+
+	auto width = i32 {};
+	auto height = i32 {};
+	auto channels = i32 {};
+	auto *const pixels = stbi_load_from_memory(
+	    encoded.data(),
+	    static_cast<i32>(encoded.size()),
+	    &width,
+	    &height,
+	    &channels,
+	    STBI_rgb_alpha
+	);
+
+	// The encoded bytes are no longer needed
+	vec<u8> {}.swap(gltf_model.images[index].image);
+
+	return DecodedImage {
+		index,
+		{ pixels, &stbi_image_free },
+		width,
+		height,
+	};
+}
+
+void GltfLoader::stream_textures()
+{
+	ZoneScoped;
 
-	for (u32 i = 0; auto &image : gltf_model.images)
+	auto const image_count = gltf_model.images.size();
+	auto full_sizes = vec<pair<u32, u32>>(image_count);
+
+	// Textures start out as a single texel standing in for the coarsest level of their chain
+	auto loader = BinaryLoader(vk_context, memory_allocator, staging_texture_buffer);
+	loader.begin_batch(image_count);
+
+	for (u32 i = 0u; i < image_count; ++i)
 	{
-		model.textures.push_back(texture_loader->load_from_binary(
-		    &image.image[0],
-		    image.width,
-		    image.height,
-		    image.image.size(),
-		    Texture::Type::e2D,
-		    staging_texture_buffer,
-		    vk::ImageLayout::eShaderReadOnlyOptimal,
+		auto const &image = gltf_model.images[i];
+		auto const encoded = get_encoded_image(i);
+
+		auto width = i32 {};
+		auto height = i32 {};
+		auto channels = i32 {};
+		assert_true(
+		    stbi_info_from_memory(
+		        encoded.data(),
+		        static_cast<i32>(encoded.size()),
+		        &width,
+		        &height,
+		        &channels
+		    ),
+		    "Failed to read gltf image header: \nname: {}\nuri: {}",
+		    model.debug_name,
 		    image.uri
-		));
+		);
+
+		full_sizes[i] = { static_cast<u32>(width), static_cast<u32>(height) };
+
+		auto const placeholder_texel = get_placeholder_texel(i);
+		loader.add_to_batch(
+		    i,
+		    TextureLoader::BinaryTextureInfo {
+		        placeholder_texel.data(),
+		        1u,
+		        1u,
+		        placeholder_texel.size(),
+		        image.uri,
+		    }
+		);
+	}
+
+	model.textures = loader.end_batch();
+
+	// Decoding & mip generation happen on the streaming threads
+	for (u32 i = 0u; i < image_count; ++i)
+	{
+		// Decodes may outlive the glb mapping, so its images are copied out of it
+		auto const glb_image = glb_reader.is_open() ? get_encoded_image(i) : span<u8 const> {};
+		auto encoded = glb_reader.is_open() ? vec<u8>(glb_image.begin(), glb_image.end())
+		                                    : std::move(gltf_model.images[i].image);
+
+		residency_manager->stream_texture(
+		    &model.textures[i],
+		    full_sizes[i],
+		    [encoded = std::move(encoded)]() {
+			    return decode_image_levels(encoded);
+		    }
+		);
 	}
 }
 
+auto GltfLoader::get_encoded_image(u32 const index) const -> span<u8 const>
+{
+	ZoneScoped;
+
+	if (glb_reader.is_open())
+		return glb_reader.get_image(index);
+
+	return gltf_model.images[index].image;
+}
+
+auto GltfLoader::get_placeholder_texel(u32 const image_index) const -> arr<u8, 4>
+{
+	ZoneScoped;
+
+	// Flat normals for normal maps, mid gray for everything else
+	for (auto const &material : gltf_model.materials)
+	{
+		auto const normal_texture_index = material.normalTexture.index;
+		if (normal_texture_index != -1
+		    && gltf_model.textures[normal_texture_index].source == static_cast<i32>(image_index))
+			return { 128u, 128u, 255u, 255u };
+	}
+
+	return { 128u, 128u, 128u, 255u };
+}
+
 void GltfLoader::load_material_parameters()
 {
 	ZoneScoped;
@@ -151,12 +443,46 @@ void GltfLoader::load_material_parameters()
 	}
 }
 
+auto GltfLoader::get_max_vertex_count() -> usize
+{
+	ZoneScoped;
+
+	// An upper bound, meshes of nodes outside the scene are counted too
+	auto vertex_count = usize {};
+	for (auto const &gltf_node : gltf_model.nodes)
+	{
+		if (!node_has_any_mesh(gltf_node))
+			continue;
+
+		for (auto const &gltf_primitive : gltf_model.meshes[gltf_node.mesh].primitives)
+			vertex_count += get_primitive_vertex_count(gltf_primitive);
+	}
+
+	return vertex_count;
+}
+
+auto GltfLoader::select_index_type() -> vk::IndexType
+{
+	ZoneScoped;
+
+	// 0xffff is left unused so it never reads as a primitive restart
+	return get_max_vertex_count() <= std::numeric_limits<u16>::max() ? vk::IndexType::eUint16
+	                                                                  : vk::IndexType::eUint32;
+}
+
 void GltfLoader::stage_mesh_data()
 {
 	ZoneScoped;
 
-	vertex_map = static_cast<Model::Vertex *>(staging_vertex_buffer->map_block(0));
-	index_map = static_cast<u32 *>(staging_index_buffer->map_block(0));
+	model.index_type = select_index_type();
+
+	// Encoded positions may be relative to the bounds of the whole model & the streams' sizes
+	// depend on the vertex count, so vertices are interleaved at full precision first & encoded
+	// into the staging buffer once they're all in
+	full_precision_vertices.resize(get_max_vertex_count());
+	vertex_map = full_precision_vertices.data();
+
+	index_map = staging_index_buffer->map_block(0);
 
 	for (auto gltf_node_index : gltf_model.scenes[0].nodes)
 	{
@@ -202,13 +528,53 @@ void GltfLoader::write_vertex_buffer_to_gpu()
 {
 	ZoneScoped;
 
+	encode_vertices();
 	staging_vertex_buffer->unmap();
 
-	model.vertex_buffer_fragment = vertex_buffer->grab_fragment(
-	    vertex_count * sizeof(Model::Vertex)
+	model.grab_vertex_fragments(position_buffer, attribute_buffer, static_cast<u32>(vertex_count));
+
+	position_buffer->copy_staging_to_fragment(
+	    staging_vertex_buffer,
+	    model.position_buffer_fragment
+	);
+
+	attribute_buffer->copy_staging_to_fragment(
+	    staging_vertex_buffer,
+	    model.attribute_buffer_fragment,
+	    model.position_buffer_fragment.length
+	);
+}
+
+void GltfLoader::encode_vertices()
+{
+	ZoneScoped;
+
+	auto const positions_size = vertex_count * model.get_position_stride();
+	auto const size = positions_size + vertex_count * model.get_attribute_stride();
+	assert_true(
+	    size <= staging_vertex_buffer->get_block_size(),
+	    "Vertices of model {} don't fit in the staging buffer ({} > {})",
+	    model.debug_name,
+	    size,
+	    staging_vertex_buffer->get_block_size()
+	);
+
+	auto *const staging_map = static_cast<u8 *>(staging_vertex_buffer->map_block(0));
+
+	auto const &[min, max] = model.bounds;
+	Assets::encode_vertices(
+	    model.vertex_encoding,
+	    Assets::MeshBounds {
+	        { min[0], min[1], min[2] },
+	        { max[0], max[1], max[2] },
+	    },
+	    reinterpret_cast<Assets::MeshVertex const *>(full_precision_vertices.data()),
+	    vertex_count,
+	    staging_map,
+	    staging_map + positions_size
 	);
 
-	vertex_buffer->copy_staging_to_fragment(staging_vertex_buffer, model.vertex_buffer_fragment);
+	vec<Model::Vertex> {}.swap(full_precision_vertices);
 }
 
 void GltfLoader::write_index_buffer_to_gpu()
@@ -217,7 +583,9 @@ void GltfLoader::write_index_buffer_to_gpu()
 
 	staging_index_buffer->unmap();
 
-	model.index_buffer_fragment = index_buffer->grab_fragment(index_count * sizeof(u32));
+	model.index_buffer_fragment = index_buffer->grab_fragment(
+	    index_count * model.get_index_size()
+	);
 	index_buffer->copy_staging_to_fragment(staging_index_buffer, model.index_buffer_fragment);
 }
 
@@ -245,36 +613,26 @@ void GltfLoader::load_mesh_primitive_vertices(const tinygltf::Primitive &gltf_pr
 {
 	ZoneScoped;
 
-	auto const *position_buffer = (vec3 const *)
-	    get_primitive_attribute_buffer(gltf_primitive, "POSITION");
-
-	auto const *normal_buffer = (vec3 const *)
-	    get_primitive_attribute_buffer(gltf_primitive, "NORMAL");
+	auto const streams = VertexStreams {
+		get_primitive_attribute_stream(gltf_primitive, "POSITION"),
+		get_primitive_attribute_stream(gltf_primitive, "NORMAL"),
+		get_primitive_attribute_stream(gltf_primitive, "TANGENT"),
+		get_primitive_attribute_stream(gltf_primitive, "TEXCOORD_0"),
+	};
 
-	auto const *tangent_buffer = (vec3 const *)
-	    get_primitive_attribute_buffer(gltf_primitive, "TANGENT");
+	auto const primitive_vertex_count = get_primitive_vertex_count(gltf_primitive);
 
-	auto const *uv_buffer = (vec2 const *)(get_primitive_attribute_buffer(
-	    gltf_primitive,
-	    "TEXCOORD_0"
-	));
-
-	auto primitive_vertex_count = get_primitive_vertex_count(gltf_primitive);
-
-	for (auto v = 0; v < primitive_vertex_count; ++v)
+	// Bounds start out inverted, so the first vertex sets them
+	if (!vertex_count && primitive_vertex_count)
 	{
-		auto const [x, y, z] = tangent_buffer ? tangent_buffer[v] : vec3 { 0.0f };
-		auto const mag = sqrt(x * x + y * y + z * z);
-
-		vertex_map[vertex_count] = {
-			position_buffer[v],
-			normal_buffer ? normal_buffer[v] : vec3 { 0.0f },
-			tangent_buffer ? vec3 { x / mag, y / mag, z / mag } : vec3 { 0.0f },
-			uv_buffer ? uv_buffer[v] : vec2 { 0.0f },
-		};
+		auto constexpr max = std::numeric_limits<f32>::max();
+		auto constexpr lowest = std::numeric_limits<f32>::lowest();
 
-		++vertex_count;
+		model.bounds = { vec3 { max, max, max }, vec3 { lowest, lowest, lowest } };
 	}
+
+	interleave_vertices(streams, primitive_vertex_count, vertex_map + vertex_count, model.bounds);
+	vertex_count += primitive_vertex_count;
 }
 
 auto GltfLoader::load_mesh_primitive_indices(const tinygltf::Primitive &gltf_primitive) -> u32
@@ -283,65 +641,84 @@ auto GltfLoader::load_mesh_primitive_indices(const tinygltf::Primitive &gltf_pri
 
 	auto const &accessor = gltf_model.accessors[gltf_primitive.indices];
 	auto const &buffer_view = gltf_model.bufferViews[accessor.bufferView];
-	auto const &buffer = gltf_model.buffers[buffer_view.buffer];
-	auto const byte_offset = accessor.byteOffset + buffer_view.byteOffset;
+	auto const *const data = get_buffer_data(buffer_view.buffer)
+	                         + accessor.byteOffset + buffer_view.byteOffset;
+
+	auto const index_size = get_index_size(accessor.componentType);
+
+	// Converted to the model's index type & offset to the primitive's first vertex
+	auto const base_vertex = static_cast<u32>(vertex_count);
+	if (model.index_type == vk::IndexType::eUint16)
+		rebase_indices(
+		    data,
+		    index_size,
+		    accessor.count,
+		    base_vertex,
+		    static_cast<u16 *>(index_map) + index_count
+		);
+	else
+		rebase_indices(
+		    data,
+		    index_size,
+		    accessor.count,
+		    base_vertex,
+		    static_cast<u32 *>(index_map) + index_count
+		);
 
-	switch (accessor.componentType)
-	{
-	case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
-	{
-		auto buf = reinterpret_cast<u32 const *>(&buffer.data[byte_offset]);
-		for (size_t index = 0; index < accessor.count; index++)
-		{
-			index_map[index_count] = buf[index] + vertex_count;
-			index_count++;
-		}
-		break;
-	}
-	case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
-	{
-		auto buf = reinterpret_cast<u16 const *>(&buffer.data[byte_offset]);
-		for (usize index = 0; index < accessor.count; index++)
-		{
-			index_map[index_count] = buf[index] + vertex_count;
-			index_count++;
-		}
-		break;
-	}
-	case TINYGLTF_PARAMETER_TYPE_BYTE:
+	index_count += accessor.count;
+	return static_cast<u32>(accessor.count);
+}
+
+auto GltfLoader::get_index_size(i32 const component_type) -> usize
+{
+	ZoneScoped;
+
+	switch (component_type)
 	{
-		auto buf = reinterpret_cast<u8 const *>(&buffer.data[byte_offset]);
-		for (usize index = 0; index < accessor.count; index++)
-		{
-			index_map[index_count] = buf[index] + vertex_count;
-			index_count++;
-		}
-		break;
-	}
+	case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE: return sizeof(u8);
+	case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT: return sizeof(u16);
+	case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT: return sizeof(u32);
+
+	default: assert_fail("Invalid gltf index component type: {}", component_type);
 	}
 
-	return static_cast<u32>(accessor.count);
+	return {};
 }
 
-auto GltfLoader::get_primitive_attribute_buffer(
+auto GltfLoader::get_primitive_attribute_stream(
     tinygltf::Primitive const &gltf_primitive,
     str_view const attribute_name
-) -> f32 const *
+) const -> AttributeStream
 {
 	ZoneScoped;
 
 	auto const &it = gltf_primitive.attributes.find(attribute_name.data());
 	if (it == gltf_primitive.attributes.end())
 	{
-		return nullptr;
+		return { nullptr, 0u };
 	}
 
 	auto const &accessor = gltf_model.accessors[it->second];
 	auto const &view = gltf_model.bufferViews[accessor.bufferView];
 
-	return reinterpret_cast<const f32 *>(
-	    &(gltf_model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset])
-	);
+	// Falls back to the element size when the view is tightly packed
+	auto const stride = accessor.ByteStride(view);
+	assert_true(stride > 0, "Invalid gltf accessor stride: {}", attribute_name);
+
+	return {
+		get_buffer_data(view.buffer) + accessor.byteOffset + view.byteOffset,
+		static_cast<usize>(stride),
+	};
+}
+
+auto GltfLoader::get_buffer_data(i32 const buffer_index) const -> u8 const *
+{
+	ZoneScoped;
+
+	if (glb_reader.is_open())
+		return glb_reader.get_buffer(buffer_index).data();
+
+	return gltf_model.buffers[buffer_index].data.data();
 }
 
 auto GltfLoader::get_primitive_vertex_count(const tinygltf::Primitive &gltf_primitive) -> usize
@@ -0,0 +1,285 @@
+#include "BindlessVk/Model/Loaders/MeshAssetLoader.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+MeshAssetLoader::MeshAssetLoader(
+    VkContext const *const vk_context,
+    TextureLoader const *const texture_loader,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
+    FragmentedBuffer *const index_buffer,
+    Buffer *const staging_vertex_buffer,
+    Buffer *const staging_index_buffer,
+    Buffer *const staging_texture_buffer
+)
+    : vk_context(vk_context)
+    , texture_loader(texture_loader)
+    , position_buffer(position_buffer)
+    , attribute_buffer(attribute_buffer)
+    , index_buffer(index_buffer)
+    , staging_vertex_buffer(staging_vertex_buffer)
+    , staging_index_buffer(staging_index_buffer)
+    , staging_texture_buffer(staging_texture_buffer)
+{
+	ZoneScoped;
+}
+
+auto MeshAssetLoader::load(str_view const file_path, str_view const debug_name) -> Model
+{
+	ZoneScoped;
+
+	model.debug_name = debug_name;
+
+	assert_true(
+	    Assets::map_binary_file(str(file_path).c_str(), mapped_file),
+	    "Failed to map mesh asset file: \nname: {}\npath: {}",
+	    model.debug_name,
+	    file_path
+	);
+
+	asset = mapped_file;
+	load_mesh(file_path);
+
+	return std::move(model);
+}
+
+auto MeshAssetLoader::load(
+    Assets::AssetArchive const *const archive,
+    str_view const name,
+    str_view const debug_name
+) -> Model
+{
+	ZoneScoped;
+
+	model.debug_name = debug_name;
+	this->archive = archive;
+
+	auto const *const entry = archive->find(name);
+	assert_true(
+	    entry,
+	    "Mesh asset is not in the archive: \nname: {}\npath: {}",
+	    debug_name,
+	    name
+	);
+
+	asset = archive->get_asset(entry);
+	load_mesh(name);
+
+	return std::move(model);
+}
+
+void MeshAssetLoader::load_mesh(str_view const path)
+{
+	ZoneScoped;
+
+	read_mesh_info();
+
+	load_textures(path);
+	load_material_parameters();
+	load_nodes();
+
+	write_vertex_buffer_to_gpu();
+	write_index_buffer_to_gpu();
+}
+
+void MeshAssetLoader::read_mesh_info()
+{
+	ZoneScoped;
+
+	assert_true(
+	    asset.type == Assets::AssetFile::Type::Mesh,
+	    "Asset file is not a mesh: {}",
+	    model.debug_name
+	);
+
+	mesh_info = Assets::read_mesh_info(asset.json);
+
+	assert_true(
+	    mesh_info.index_size == sizeof(u16) || mesh_info.index_size == sizeof(u32),
+	    "Invalid index size of mesh {}: {}",
+	    model.debug_name,
+	    mesh_info.index_size
+	);
+
+	model.index_type = mesh_info.index_size == sizeof(u16) ? vk::IndexType::eUint16
+	                                                       : vk::IndexType::eUint32;
+
+	assert_true(
+	    mesh_info.split_vertex_streams,
+	    "Mesh {} has interleaved vertices, it has to be rebaked",
+	    model.debug_name
+	);
+
+	// Vertices were encoded at bake time, they're uploaded as they are
+	model.vertex_encoding = mesh_info.vertex_encoding;
+
+	auto const &[min, max] = mesh_info.bounds;
+	model.bounds = {
+		vec3 { min[0], min[1], min[2] },
+		vec3 { max[0], max[1], max[2] },
+	};
+}
+
+void MeshAssetLoader::load_textures(str_view const path)
+{
+	ZoneScoped;
+
+	// Texture paths are relative to the mesh asset, inside the archive too
+	auto const directory = std::filesystem::path(path).parent_path();
+
+	model.textures.reserve(mesh_info.textures.size());
+	for (auto const &texture_path : mesh_info.textures)
+	{
+		auto const texture_file = (directory / texture_path).lexically_normal().generic_string();
+
+		if (archive)
+		{
+			model.textures.emplace_back(texture_loader->load_from_archive(
+			    archive,
+			    texture_file,
+			    Texture::Type::e2D,
+			    staging_texture_buffer,
+			    vk::ImageLayout::eShaderReadOnlyOptimal,
+			    texture_path
+			));
+		}
+		else
+		{
+			model.textures.emplace_back(texture_loader->load_from_asset(
+			    texture_file,
+			    Texture::Type::e2D,
+			    staging_texture_buffer,
+			    vk::ImageLayout::eShaderReadOnlyOptimal,
+			    texture_path
+			));
+		}
+	}
+}
+
+void MeshAssetLoader::load_material_parameters()
+{
+	ZoneScoped;
+
+	for (auto const &material : mesh_info.materials)
+	{
+		model.material_parameters.push_back({
+		    vec3 { 1.0f },
+		    vec3 { 1.0f },
+		    vec3 { 1.0f },
+		    material.albedo_texture,
+		    material.normal_texture,
+		    material.metallic_roughness_texture,
+		});
+	}
+}
+
+void MeshAssetLoader::load_nodes()
+{
+	ZoneScoped;
+
+	// Parents are baked before their children, so they always exist by the time we get to them
+	auto nodes = vec<Model::Node *> {};
+	nodes.reserve(mesh_info.nodes.size());
+
+	for (auto const &baked_node : mesh_info.nodes)
+	{
+		auto *const parent = baked_node.parent == -1 ? nullptr : nodes[baked_node.parent];
+		auto *const node = new Model::Node(parent);
+
+		std::copy_n(baked_node.transform, node->transform.size(), node->transform.begin());
+
+		for (auto const &primitive : baked_node.primitives)
+		{
+			node->mesh.push_back({
+			    primitive.first_index,
+			    primitive.index_count,
+			    primitive.material_index,
+			});
+		}
+
+		if (parent)
+			parent->children.push_back(node);
+		else
+			model.nodes.push_back(node);
+
+		nodes.push_back(node);
+	}
+}
+
+void MeshAssetLoader::write_vertex_buffer_to_gpu()
+{
+	ZoneScoped;
+
+	auto const size = Assets::get_vertices_size(&mesh_info);
+	assert_true(
+	    size <= staging_vertex_buffer->get_block_size(),
+	    "Vertices of mesh {} don't fit in the staging buffer ({} > {})",
+	    model.debug_name,
+	    size,
+	    staging_vertex_buffer->get_block_size()
+	);
+
+	// Unpacked from the mapped file straight into the staging buffer
+	assert_true(
+	    Assets::unpack_mesh_vertices(
+	        &mesh_info,
+	        asset.blob,
+	        asset.blob_size,
+	        staging_vertex_buffer->map_block(0)
+	    ),
+	    "Failed to unpack vertices of mesh {}",
+	    model.debug_name
+	);
+
+	staging_vertex_buffer->unmap();
+
+	model.grab_vertex_fragments(
+	    position_buffer,
+	    attribute_buffer,
+	    static_cast<u32>(mesh_info.vertex_count)
+	);
+
+	// Positions start the vertex stream, the rest of the attributes follow them
+	position_buffer->copy_staging_to_fragment(
+	    staging_vertex_buffer,
+	    model.position_buffer_fragment
+	);
+
+	attribute_buffer->copy_staging_to_fragment(
+	    staging_vertex_buffer,
+	    model.attribute_buffer_fragment,
+	    Assets::get_positions_size(&mesh_info)
+	);
+}
+
+void MeshAssetLoader::write_index_buffer_to_gpu()
+{
+	ZoneScoped;
+
+	auto const size = Assets::get_indices_size(&mesh_info);
+	assert_true(
+	    size <= staging_index_buffer->get_block_size(),
+	    "Indices of mesh {} don't fit in the staging buffer ({} > {})",
+	    model.debug_name,
+	    size,
+	    staging_index_buffer->get_block_size()
+	);
+
+	assert_true(
+	    Assets::unpack_mesh_indices(
+	        &mesh_info,
+	        asset.blob,
+	        asset.blob_size,
+	        staging_index_buffer->map_block(0)
+	    ),
+	    "Failed to unpack indices of mesh {}",
+	    model.debug_name
+	);
+
+	staging_index_buffer->unmap();
+
+	model.index_buffer_fragment = index_buffer->grab_fragment(size);
+	index_buffer->copy_staging_to_fragment(staging_index_buffer, model.index_buffer_fragment);
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -0,0 +1,645 @@
+#include "BindlessVk/Model/Loaders/VertexKernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+	#define BINDLESSVK_SSE 1
+	#include <immintrin.h>
+#elif defined(__aarch64__)
+	#define BINDLESSVK_NEON 1
+	#include <arm_neon.h>
+#endif
+
+// Picked at runtime, the rest of the library doesn't need to be built for avx2
+#if defined(BINDLESSVK_SSE) && defined(__GNUC__)
+	#define BINDLESSVK_AVX2 1
+#endif
+
+namespace BINDLESSVK_NAMESPACE {
+
+namespace {
+
+static_assert(sizeof(Model::Vertex) == 11u * sizeof(f32), "Vertex kernels expect packed vertices");
+
+/** Read in place of missing attributes */
+alignas(16) constexpr auto zero_element = arr<u8, 16> {};
+
+auto get_stream_or_zeros(AttributeStream const &stream) -> AttributeStream
+{
+	return stream ? stream : AttributeStream { zero_element.data(), 0u };
+}
+
+/** Converts vertices [first, count), expects the missing streams to be replaced by zeros */
+void interleave_vertex_range(
+    VertexStreams const &streams,
+    usize const first,
+    usize const count,
+    Model::Vertex *const vertices,
+    Model::Bounds &bounds
+)
+{
+	for (auto v = first; v < count; ++v)
+	{
+		auto const position = streams.position.get<vec3>(v);
+		auto const [x, y, z] = streams.tangent.get<vec3>(v);
+		auto const mag = std::sqrt(x * x + y * y + z * z);
+
+		vertices[v] = {
+			position,
+			streams.normal.get<vec3>(v),
+			mag > 0.0f ? vec3 { x / mag, y / mag, z / mag } : vec3 { 0.0f },
+			streams.uv.get<vec2>(v),
+		};
+
+		for (usize i = 0; i < 3; ++i)
+		{
+			bounds.min[i] = std::min(bounds.min[i], position[i]);
+			bounds.max[i] = std::max(bounds.max[i], position[i]);
+		}
+	}
+}
+
+/** Rebases indices [first, count), truncating them if they're narrowed to 16 bits */
+template<typename T, typename U>
+void rebase_index_range(
+    T const *const indices,
+    usize const first,
+    usize const count,
+    u32 const base_vertex,
+    U *const rebased_indices
+)
+{
+	for (auto i = first; i < count; ++i)
+		rebased_indices[i] = static_cast<U>(indices[i] + base_vertex);
+}
+
+/** Calls @a function with @a indices cast to the unsigned type of @a index_size bytes */
+template<typename Fn>
+void visit_indices(void const *const indices, usize const index_size, Fn &&function)
+{
+	switch (index_size)
+	{
+	case sizeof(u8): function((u8 const *)indices); break;
+	case sizeof(u16): function((u16 const *)indices); break;
+	case sizeof(u32): function((u32 const *)indices); break;
+
+	default: assert_fail("Unsupported index size: {}", index_size);
+	}
+}
+
+#if defined(BINDLESSVK_SSE) || defined(BINDLESSVK_NEON)
+
+/** Thin layer over the 4 lane float ops the vertex kernel needs, so it's written only once
+ *
+ * @note Forced inline, the library is built with -Og which otherwise leaves every op a call
+ */
+	#if defined(BINDLESSVK_SSE)
+using f32x4 = __m128;
+
+[[gnu::always_inline]] inline auto load_f32x4(u8 const *const ptr) -> f32x4
+{
+	return _mm_loadu_ps((f32 const *)ptr);
+}
+
+[[gnu::always_inline]] inline auto load_f32x2(u8 const *const ptr) -> f32x4
+{
+	return _mm_castsi128_ps(_mm_loadl_epi64((__m128i const *)ptr));
+}
+
+[[gnu::always_inline]] inline void store_f32x4(f32 *const dst, f32x4 const value)
+{
+	_mm_storeu_ps(dst, value);
+}
+
+[[gnu::always_inline]] inline void store_f32x2(f32 *const dst, f32x4 const value)
+{
+	_mm_storel_epi64((__m128i *)dst, _mm_castps_si128(value));
+}
+
+[[gnu::always_inline]] inline auto splat(f32 const value) -> f32x4
+{
+	return _mm_set1_ps(value);
+}
+
+[[gnu::always_inline]] inline auto add(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return _mm_add_ps(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto mul(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return _mm_mul_ps(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto div(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return _mm_div_ps(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto sqrt(f32x4 const value) -> f32x4
+{
+	return _mm_sqrt_ps(value);
+}
+
+/** @returns lhs < rhs ? lhs : rhs, per lane */
+[[gnu::always_inline]] inline auto min(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return _mm_min_ps(lhs, rhs);
+}
+
+/** @returns lhs > rhs ? lhs : rhs, per lane */
+[[gnu::always_inline]] inline auto max(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return _mm_max_ps(lhs, rhs);
+}
+
+/** @returns value where condition > 0, zero elsewhere (including where condition is nan) */
+[[gnu::always_inline]] inline auto select_positive(
+    f32x4 const condition,
+    f32x4 const value
+) -> f32x4
+{
+	return _mm_and_ps(_mm_cmpgt_ps(condition, _mm_setzero_ps()), value);
+}
+
+[[gnu::always_inline]] inline void transpose(f32x4 (&rows)[4])
+{
+	_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+}
+
+[[gnu::always_inline]] inline auto from_vec3(vec3 const &value) -> f32x4
+{
+	return _mm_setr_ps(value[0], value[1], value[2], 0.0f);
+}
+
+[[gnu::always_inline]] inline auto to_vec3(f32x4 const value) -> vec3
+{
+	auto lanes = arr<f32, 4> {};
+	_mm_storeu_ps(lanes.data(), value);
+	return { lanes[0], lanes[1], lanes[2] };
+}
+	#else
+using f32x4 = float32x4_t;
+
+[[gnu::always_inline]] inline auto load_f32x4(u8 const *const ptr) -> f32x4
+{
+	return vld1q_f32((f32 const *)ptr);
+}
+
+[[gnu::always_inline]] inline auto load_f32x2(u8 const *const ptr) -> f32x4
+{
+	return vcombine_f32(vld1_f32((f32 const *)ptr), vdup_n_f32(0.0f));
+}
+
+[[gnu::always_inline]] inline void store_f32x4(f32 *const dst, f32x4 const value)
+{
+	vst1q_f32(dst, value);
+}
+
+[[gnu::always_inline]] inline void store_f32x2(f32 *const dst, f32x4 const value)
+{
+	vst1_f32(dst, vget_low_f32(value));
+}
+
+[[gnu::always_inline]] inline auto splat(f32 const value) -> f32x4
+{
+	return vdupq_n_f32(value);
+}
+
+[[gnu::always_inline]] inline auto add(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return vaddq_f32(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto mul(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return vmulq_f32(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto div(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return vdivq_f32(lhs, rhs);
+}
+
+[[gnu::always_inline]] inline auto sqrt(f32x4 const value) -> f32x4
+{
+	return vsqrtq_f32(value);
+}
+
+/** @returns lhs < rhs ? lhs : rhs, per lane (vminq differs on signed zeros & nans) */
+[[gnu::always_inline]] inline auto min(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return vbslq_f32(vcltq_f32(lhs, rhs), lhs, rhs);
+}
+
+/** @returns lhs > rhs ? lhs : rhs, per lane */
+[[gnu::always_inline]] inline auto max(f32x4 const lhs, f32x4 const rhs) -> f32x4
+{
+	return vbslq_f32(vcgtq_f32(lhs, rhs), lhs, rhs);
+}
+
+/** @returns value where condition > 0, zero elsewhere (including where condition is nan) */
+[[gnu::always_inline]] inline auto select_positive(
+    f32x4 const condition,
+    f32x4 const value
+) -> f32x4
+{
+	auto const mask = vcgtq_f32(condition, vdupq_n_f32(0.0f));
+	return vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(value)));
+}
+
+[[gnu::always_inline]] inline void transpose(f32x4 (&rows)[4])
+{
+	auto const rows_01 = vtrnq_f32(rows[0], rows[1]);
+	auto const rows_23 = vtrnq_f32(rows[2], rows[3]);
+
+	rows[0] = vcombine_f32(vget_low_f32(rows_01.val[0]), vget_low_f32(rows_23.val[0]));
+	rows[1] = vcombine_f32(vget_low_f32(rows_01.val[1]), vget_low_f32(rows_23.val[1]));
+	rows[2] = vcombine_f32(vget_high_f32(rows_01.val[0]), vget_high_f32(rows_23.val[0]));
+	rows[3] = vcombine_f32(vget_high_f32(rows_01.val[1]), vget_high_f32(rows_23.val[1]));
+}
+
+[[gnu::always_inline]] inline auto from_vec3(vec3 const &value) -> f32x4
+{
+	auto const lanes = arr<f32, 4> { value[0], value[1], value[2], 0.0f };
+	return vld1q_f32(lanes.data());
+}
+
+[[gnu::always_inline]] inline auto to_vec3(f32x4 const value) -> vec3
+{
+	return { vgetq_lane_f32(value, 0), vgetq_lane_f32(value, 1), vgetq_lane_f32(value, 2) };
+}
+	#endif
+
+/** @returns The number of vertices converted, the rest are left to the scalar loop */
+auto interleave_vertices_x4(
+    VertexStreams const &streams,
+    usize const count,
+    Model::Vertex *const vertices,
+    Model::Bounds &bounds
+) -> usize
+{
+	auto const element = [](AttributeStream const &stream, usize const index) {
+		return stream.data + index * stream.stride;
+	};
+
+	auto bounds_min = from_vec3(bounds.min);
+	auto bounds_max = from_vec3(bounds.max);
+
+	// vec3s are loaded as 4 lanes, the extra one is never stored & is overwritten by the next
+	// attribute. Reading it is only safe while there's another element after, hence the last
+	// vertex always goes to the scalar loop
+	auto v = usize {};
+	for (; v + 4u < count; v += 4u)
+	{
+		f32x4 tangents[4] = {
+			load_f32x4(element(streams.tangent, v + 0u)),
+			load_f32x4(element(streams.tangent, v + 1u)),
+			load_f32x4(element(streams.tangent, v + 2u)),
+			load_f32x4(element(streams.tangent, v + 3u)),
+		};
+
+		// Normalize four tangents at once, as rows of x, y & z
+		transpose(tangents);
+
+		auto const [x, y, z, w] = tangents;
+		auto const mag = sqrt(add(add(mul(x, x), mul(y, y)), mul(z, z)));
+
+		tangents[0] = select_positive(mag, div(x, mag));
+		tangents[1] = select_positive(mag, div(y, mag));
+		tangents[2] = select_positive(mag, div(z, mag));
+		tangents[3] = splat(0.0f);
+
+		transpose(tangents);
+
+		for (usize i = 0; i < 4u; ++i)
+		{
+			auto const position = load_f32x4(element(streams.position, v + i));
+			bounds_min = min(position, bounds_min);
+			bounds_max = max(position, bounds_max);
+
+			auto *const vertex = (f32 *)&vertices[v + i];
+			store_f32x4(vertex + 0u, position);
+			store_f32x4(vertex + 3u, load_f32x4(element(streams.normal, v + i)));
+			store_f32x4(vertex + 6u, tangents[i]);
+			store_f32x2(vertex + 9u, load_f32x2(element(streams.uv, v + i)));
+		}
+	}
+
+	bounds.min = to_vec3(bounds_min);
+	bounds.max = to_vec3(bounds_max);
+
+	return v;
+}
+
+#endif
+
+#if defined(BINDLESSVK_AVX2)
+
+template<typename T>
+__attribute__((target("avx2"))) auto rebase_indices_x8(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    u32 *const rebased_indices
+) -> usize
+{
+	auto const base = _mm256_set1_epi32(static_cast<i32>(base_vertex));
+
+	auto i = usize {};
+	for (; i + 8u <= count; i += 8u)
+	{
+		auto const *const src = (__m128i const *)(indices + i);
+		auto widened = __m256i {};
+
+		if constexpr (sizeof(T) == sizeof(u8))
+			widened = _mm256_cvtepu8_epi32(_mm_loadl_epi64(src));
+		else if constexpr (sizeof(T) == sizeof(u16))
+			widened = _mm256_cvtepu16_epi32(_mm_loadu_si128(src));
+		else
+			widened = _mm256_loadu_si256((__m256i const *)src);
+
+		_mm256_storeu_si256((__m256i *)(rebased_indices + i), _mm256_add_epi32(widened, base));
+	}
+
+	return i;
+}
+
+#endif
+
+#if defined(BINDLESSVK_SSE)
+
+template<typename T>
+auto rebase_indices_x4(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    u32 *const rebased_indices
+) -> usize
+{
+	auto const base = _mm_set1_epi32(static_cast<i32>(base_vertex));
+	auto const zero = _mm_setzero_si128();
+
+	// Narrow indices are widened by interleaving them with zeros
+	auto i = usize {};
+	for (; i + 4u <= count; i += 4u)
+	{
+		auto const *const src = (__m128i const *)(indices + i);
+		auto widened = __m128i {};
+
+		if constexpr (sizeof(T) == sizeof(u8))
+		{
+			auto bytes = i32 {};
+			std::memcpy(&bytes, src, sizeof(bytes));
+			widened = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+		}
+		else if constexpr (sizeof(T) == sizeof(u16))
+			widened = _mm_unpacklo_epi16(_mm_loadl_epi64(src), zero);
+		else
+			widened = _mm_loadu_si128(src);
+
+		_mm_storeu_si128((__m128i *)(rebased_indices + i), _mm_add_epi32(widened, base));
+	}
+
+	return i;
+}
+
+template<typename T>
+auto rebase_short_indices_x8(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    u16 *const rebased_indices
+) -> usize
+{
+	auto const base = _mm_set1_epi16(static_cast<u16>(base_vertex));
+	auto const zero = _mm_setzero_si128();
+
+	auto i = usize {};
+	for (; i + 8u <= count; i += 8u)
+	{
+		auto const *const src = (__m128i const *)(indices + i);
+		auto narrowed = __m128i {};
+
+		if constexpr (sizeof(T) == sizeof(u8))
+			narrowed = _mm_unpacklo_epi8(_mm_loadl_epi64(src), zero);
+		else if constexpr (sizeof(T) == sizeof(u16))
+			narrowed = _mm_loadu_si128(src);
+		else
+		{
+			// Sign extend the low halves, so the saturating pack keeps them as they are
+			auto const low = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128(src + 0), 16), 16);
+			auto const high = _mm_srai_epi32(_mm_slli_epi32(_mm_loadu_si128(src + 1), 16), 16);
+			narrowed = _mm_packs_epi32(low, high);
+		}
+
+		_mm_storeu_si128((__m128i *)(rebased_indices + i), _mm_add_epi16(narrowed, base));
+	}
+
+	return i;
+}
+
+#elif defined(BINDLESSVK_NEON)
+
+template<typename T>
+auto rebase_indices_x4(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    u32 *const rebased_indices
+) -> usize
+{
+	auto const base = vdupq_n_u32(base_vertex);
+
+	auto i = usize {};
+	for (; i + 4u <= count; i += 4u)
+	{
+		auto widened = uint32x4_t {};
+
+		if constexpr (sizeof(T) == sizeof(u8))
+		{
+			auto bytes = u32 {};
+			std::memcpy(&bytes, indices + i, sizeof(bytes));
+			widened = vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(bytes))));
+		}
+		else if constexpr (sizeof(T) == sizeof(u16))
+			widened = vmovl_u16(vld1_u16(indices + i));
+		else
+			widened = vld1q_u32(indices + i);
+
+		vst1q_u32(rebased_indices + i, vaddq_u32(widened, base));
+	}
+
+	return i;
+}
+
+template<typename T>
+auto rebase_short_indices_x8(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    u16 *const rebased_indices
+) -> usize
+{
+	auto const base = vdupq_n_u16(static_cast<u16>(base_vertex));
+
+	auto i = usize {};
+	for (; i + 8u <= count; i += 8u)
+	{
+		auto narrowed = uint16x8_t {};
+
+		if constexpr (sizeof(T) == sizeof(u8))
+			narrowed = vmovl_u8(vld1_u8(indices + i));
+		else if constexpr (sizeof(T) == sizeof(u16))
+			narrowed = vld1q_u16(indices + i);
+		else
+			narrowed = vcombine_u16(
+			    vmovn_u32(vld1q_u32(indices + i)),
+			    vmovn_u32(vld1q_u32(indices + i + 4u))
+			);
+
+		vst1q_u16(rebased_indices + i, vaddq_u16(narrowed, base));
+	}
+
+	return i;
+}
+
+#endif
+
+template<typename T, typename U>
+void rebase_typed_indices(
+    T const *const indices,
+    usize const count,
+    u32 const base_vertex,
+    U *const rebased_indices
+)
+{
+	auto first = usize {};
+
+	if constexpr (sizeof(U) == sizeof(u16))
+	{
+#if defined(BINDLESSVK_SSE) || defined(BINDLESSVK_NEON)
+		first = rebase_short_indices_x8(indices, count, base_vertex, rebased_indices);
+#endif
+	}
+	else
+	{
+#if defined(BINDLESSVK_AVX2)
+		first = __builtin_cpu_supports("avx2")
+		            ? rebase_indices_x8(indices, count, base_vertex, rebased_indices)
+		            : rebase_indices_x4(indices, count, base_vertex, rebased_indices);
+#elif defined(BINDLESSVK_SSE) || defined(BINDLESSVK_NEON)
+		first = rebase_indices_x4(indices, count, base_vertex, rebased_indices);
+#endif
+	}
+
+	rebase_index_range(indices, first, count, base_vertex, rebased_indices);
+}
+
+} // namespace
+
+void interleave_vertices(
+    VertexStreams const &streams,
+    usize const count,
+    Model::Vertex *const vertices,
+    Model::Bounds &bounds
+)
+{
+	ZoneScoped;
+
+	// Missing attributes are read from a zeroed element with a stride of 0, so the loops don't
+	// have to branch on them
+	auto const filled_streams = VertexStreams {
+		streams.position,
+		get_stream_or_zeros(streams.normal),
+		get_stream_or_zeros(streams.tangent),
+		get_stream_or_zeros(streams.uv),
+	};
+
+	auto first = usize {};
+
+#if defined(BINDLESSVK_SSE) || defined(BINDLESSVK_NEON)
+	first = interleave_vertices_x4(filled_streams, count, vertices, bounds);
+#endif
+
+	interleave_vertex_range(filled_streams, first, count, vertices, bounds);
+}
+
+void interleave_vertices_scalar(
+    VertexStreams const &streams,
+    usize const count,
+    Model::Vertex *const vertices,
+    Model::Bounds &bounds
+)
+{
+	ZoneScoped;
+
+	auto const filled_streams = VertexStreams {
+		streams.position,
+		get_stream_or_zeros(streams.normal),
+		get_stream_or_zeros(streams.tangent),
+		get_stream_or_zeros(streams.uv),
+	};
+
+	interleave_vertex_range(filled_streams, 0u, count, vertices, bounds);
+}
+
+void rebase_indices(
+    void const *const indices,
+    usize const index_size,
+    usize const count,
+    u32 const base_vertex,
+    u32 *const rebased_indices
+)
+{
+	ZoneScoped;
+
+	visit_indices(indices, index_size, [&](auto const *const typed_indices) {
+		rebase_typed_indices(typed_indices, count, base_vertex, rebased_indices);
+	});
+}
+
+void rebase_indices_scalar(
+    void const *const indices,
+    usize const index_size,
+    usize const count,
+    u32 const base_vertex,
+    u32 *const rebased_indices
+)
+{
+	ZoneScoped;
+
+	visit_indices(indices, index_size, [&](auto const *const typed_indices) {
+		rebase_index_range(typed_indices, 0u, count, base_vertex, rebased_indices);
+	});
+}
+
+void rebase_indices(
+    void const *const indices,
+    usize const index_size,
+    usize const count,
+    u32 const base_vertex,
+    u16 *const rebased_indices
+)
+{
+	ZoneScoped;
+
+	visit_indices(indices, index_size, [&](auto const *const typed_indices) {
+		rebase_typed_indices(typed_indices, count, base_vertex, rebased_indices);
+	});
+}
+
+void rebase_indices_scalar(
+    void const *const indices,
+    usize const index_size,
+    usize const count,
+    u32 const base_vertex,
+    u16 *const rebased_indices
+)
+{
+	ZoneScoped;
+
+	visit_indices(indices, index_size, [&](auto const *const typed_indices) {
+		rebase_index_range(typed_indices, 0u, count, base_vertex, rebased_indices);
+	});
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -16,63 +16,244 @@ Model::~Model()
 		delete node;
 }
 
-auto Model::Vertex::get_attributes() -> arr<vk::VertexInputAttributeDescription, 4>
+auto static get_position_format(Assets::PositionEncoding const encoding) -> vk::Format
+{
+	switch (encoding)
+	{
+	case Assets::PositionEncoding::Float: return vk::Format::eR32G32B32Sfloat;
+	case Assets::PositionEncoding::Half: return vk::Format::eR16G16B16A16Sfloat;
+	case Assets::PositionEncoding::Unorm16: return vk::Format::eR16G16B16A16Unorm;
+
+	default: assert_fail("Invalid position encoding: {}", static_cast<u32>(encoding));
+	}
+
+	return {};
+}
+
+auto static get_direction_format(Assets::DirectionEncoding const encoding) -> vk::Format
+{
+	// Octahedral directions read as (x, y, 0) in the shader, which unfolds them
+	switch (encoding)
+	{
+	case Assets::DirectionEncoding::Float: return vk::Format::eR32G32B32Sfloat;
+	case Assets::DirectionEncoding::OctahedralSnorm16: return vk::Format::eR16G16Snorm;
+	case Assets::DirectionEncoding::OctahedralSnorm8: return vk::Format::eR8G8Snorm;
+
+	default: assert_fail("Invalid direction encoding: {}", static_cast<u32>(encoding));
+	}
+
+	return {};
+}
+
+auto static get_uv_format(Assets::UvEncoding const encoding) -> vk::Format
+{
+	switch (encoding)
+	{
+	case Assets::UvEncoding::Float: return vk::Format::eR32G32Sfloat;
+	case Assets::UvEncoding::Half: return vk::Format::eR16G16Sfloat;
+
+	default: assert_fail("Invalid uv encoding: {}", static_cast<u32>(encoding));
+	}
+
+	return {};
+}
+
+auto Model::Vertex::get_attributes(VertexEncoding const encoding /* = {} */)
+    -> arr<vk::VertexInputAttributeDescription, 4>
 {
 	ZoneScoped;
 
+	auto const layout = Assets::get_vertex_layout(encoding);
+
 	return arr<vk::VertexInputAttributeDescription, 4> {
-		vk::VertexInputAttributeDescription {
-		    0u,
-		    0u,
-		    vk::Format::eR32G32B32Sfloat,
-		    offsetof(Model::Vertex, position),
-		},
+		get_position_attributes(encoding)[0],
 		vk::VertexInputAttributeDescription {
 		    1u,
-		    0u,
-		    vk::Format::eR32G32B32Sfloat,
-		    offsetof(Model::Vertex, normal),
+		    attribute_binding,
+		    get_direction_format(encoding.direction),
+		    layout.normal_offset,
 		},
 		vk::VertexInputAttributeDescription {
 		    2u,
-		    0u,
-		    vk::Format::eR32G32B32Sfloat,
-		    offsetof(Model::Vertex, tangent),
+		    attribute_binding,
+		    get_direction_format(encoding.direction),
+		    layout.tangent_offset,
 		},
 		vk::VertexInputAttributeDescription {
 		    3u,
+		    attribute_binding,
+		    get_uv_format(encoding.uv),
+		    layout.uv_offset,
+		},
+	};
+}
+
+auto Model::Vertex::get_bindings(VertexEncoding const encoding /* = {} */)
+    -> arr<vk::VertexInputBindingDescription, 2>
+{
+	ZoneScoped;
+
+	return arr<vk::VertexInputBindingDescription, 2> {
+		get_position_bindings(encoding)[0],
+		vk::VertexInputBindingDescription {
+		    attribute_binding,
+		    Assets::get_vertex_layout(encoding).attribute_stride,
+		    vk::VertexInputRate::eVertex,
+		},
+	};
+}
+
+auto Model::Vertex::get_position_attributes(VertexEncoding const encoding /* = {} */)
+    -> arr<vk::VertexInputAttributeDescription, 1>
+{
+	ZoneScoped;
+
+	return arr<vk::VertexInputAttributeDescription, 1> {
+		vk::VertexInputAttributeDescription {
+		    0u,
+		    position_binding,
+		    get_position_format(encoding.position),
 		    0u,
-		    vk::Format::eR32G32Sfloat,
-		    offsetof(Model::Vertex, uv),
 		},
 	};
 }
 
-auto Model::Vertex::get_bindings() -> arr<vk::VertexInputBindingDescription, 1>
+auto Model::Vertex::get_position_bindings(VertexEncoding const encoding /* = {} */)
+    -> arr<vk::VertexInputBindingDescription, 1>
 {
 	ZoneScoped;
 
 	return arr<vk::VertexInputBindingDescription, 1> {
 		vk::VertexInputBindingDescription {
-		    0u,
-		    static_cast<u32>(sizeof(Model::Vertex)),
+		    position_binding,
+		    Assets::get_vertex_layout(encoding).position_stride,
 		    vk::VertexInputRate::eVertex,
 		},
 	};
 }
 
-auto Model::Vertex::get_vertex_input_state() -> vk::PipelineVertexInputStateCreateInfo
+struct VertexInputDescriptions
+{
+	arr<vk::VertexInputAttributeDescription, 4> attributes;
+	arr<vk::VertexInputBindingDescription, 2> bindings;
+
+	arr<vk::VertexInputAttributeDescription, 1> position_attributes;
+	arr<vk::VertexInputBindingDescription, 1> position_bindings;
+};
+
+auto static get_input_descriptions(Model::VertexEncoding const encoding)
+    -> VertexInputDescriptions const &
+{
+	ZoneScoped;
+
+	// Input states point into the descriptions, so each encoding's are kept around. Map nodes
+	// don't move, so the pointers survive rehashes
+	auto static descriptions = hash_map<u32, VertexInputDescriptions> {};
+	auto static descriptions_mutex = std::mutex {};
+
+	auto const key = static_cast<u32>(encoding.position)
+	                 | static_cast<u32>(encoding.direction) << 8u
+	                 | static_cast<u32>(encoding.uv) << 16u;
+
+	auto const lock = std::scoped_lock(descriptions_mutex);
+
+	auto const [it, is_new] = descriptions.try_emplace(key);
+	if (is_new)
+	{
+		it->second = {
+			Model::Vertex::get_attributes(encoding),
+			Model::Vertex::get_bindings(encoding),
+			Model::Vertex::get_position_attributes(encoding),
+			Model::Vertex::get_position_bindings(encoding),
+		};
+	}
+
+	return it->second;
+}
+
+auto Model::Vertex::get_vertex_input_state(VertexEncoding const encoding /* = {} */)
+    -> vk::PipelineVertexInputStateCreateInfo
+{
+	ZoneScoped;
+
+	auto const &descriptions = get_input_descriptions(encoding);
+
+	return vk::PipelineVertexInputStateCreateInfo {
+		{},
+		descriptions.bindings,
+		descriptions.attributes,
+	};
+}
+
+auto Model::Vertex::get_position_vertex_input_state(VertexEncoding const encoding /* = {} */)
+    -> vk::PipelineVertexInputStateCreateInfo
 {
 	ZoneScoped;
 
-	auto static const attributes = get_attributes();
-	auto static const bindings = get_bindings();
+	auto const &descriptions = get_input_descriptions(encoding);
 
 	return vk::PipelineVertexInputStateCreateInfo {
 		{},
-		bindings,
-		attributes,
+		descriptions.position_bindings,
+		descriptions.position_attributes,
 	};
 }
 
+auto Model::get_position_dequantization() const -> Assets::PositionDequantization
+{
+	ZoneScoped;
+
+	auto const &[min, max] = bounds;
+	return Assets::get_position_dequantization(
+	    vertex_encoding.position,
+	    Assets::MeshBounds {
+	        { min[0], min[1], min[2] },
+	        { max[0], max[1], max[2] },
+	    }
+	);
+}
+
+void Model::grab_vertex_fragments(
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
+    u32 const vertex_count
+)
+{
+	ZoneScoped;
+
+	auto const position_stride = static_cast<u32>(get_position_stride());
+	auto const attribute_stride = static_cast<u32>(get_attribute_stride());
+
+	// A draw's vertex offset applies to both bindings, so the streams have to start at the
+	// same vertex. Each search starts where the other buffer's run was found, until they meet
+	auto vertex_index = usize { 0 };
+	while (true)
+	{
+		auto const position_index = position_buffer->find_free_index(
+		    vertex_count,
+		    position_stride,
+		    vertex_index
+		);
+
+		vertex_index = attribute_buffer->find_free_index(
+		    vertex_count,
+		    attribute_stride,
+		    position_index
+		);
+
+		if (vertex_index == position_index)
+			break;
+	}
+
+	position_buffer_fragment = position_buffer->grab_fragment_at(
+	    vertex_index * position_stride,
+	    vertex_count * position_stride
+	);
+
+	attribute_buffer_fragment = attribute_buffer->grab_fragment_at(
+	    vertex_index * attribute_stride,
+	    vertex_count * attribute_stride
+	);
+}
+
 } // namespace BINDLESSVK_NAMESPACE
@@ -3,28 +3,33 @@
 
 #include "BindlessVk/Buffers/Buffer.hpp"
 #include "BindlessVk/Model/Loaders/GltfLoader.hpp"
+#include "BindlessVk/Model/Loaders/MeshAssetLoader.hpp"
 
 namespace BINDLESSVK_NAMESPACE {
 
 ModelLoader::ModelLoader(
     VkContext const *const vk_context,
-    MemoryAllocator const *const memory_allocator
+    MemoryAllocator const *const memory_allocator,
+    ResidencyManager *const residency_manager /* = {} */
 )
     : vk_context(vk_context)
     , texture_loader(vk_context, memory_allocator)
     , memory_allocator(memory_allocator)
+    , residency_manager(residency_manager)
 {
 	ZoneScoped;
 }
 
 auto ModelLoader::load_from_gltf_ascii(
     str_view const file_path,
-    FragmentedBuffer *const vertex_buffer,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
     FragmentedBuffer *const index_buffer,
     Buffer *const staging_vertex_buffer,
     Buffer *const staging_index_buffer,
     Buffer *const staging_image_buffer,
-    str_view const debug_name /* = default_debug_name */
+    str_view const debug_name /* = default_debug_name */,
+    Model::VertexEncoding const vertex_encoding /* = {} */
 ) const -> Model
 {
 	ZoneScoped;
@@ -33,7 +38,9 @@ auto ModelLoader::load_from_gltf_ascii(
 		vk_context,       // curse
 		memory_allocator, // you
 		&texture_loader,  // clang_format!
-		vertex_buffer,    // !!!!!!!!!!!!!
+		residency_manager,
+		position_buffer,  // !!!!!!!!!!!!!
+		attribute_buffer,
 		index_buffer,     // ----_____----
 		staging_vertex_buffer,
 		staging_index_buffer,
@@ -41,7 +48,92 @@ auto ModelLoader::load_from_gltf_ascii(
 
 	};
 
-	return std::move(loader.load_from_ascii(file_path, debug_name));
+	return std::move(loader.load_from_ascii(file_path, debug_name, vertex_encoding));
+}
+
+auto ModelLoader::load_from_gltf_binary(
+    str_view const file_path,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
+    FragmentedBuffer *const index_buffer,
+    Buffer *const staging_vertex_buffer,
+    Buffer *const staging_index_buffer,
+    Buffer *const staging_image_buffer,
+    str_view const debug_name /* = default_debug_name */,
+    Model::VertexEncoding const vertex_encoding /* = {} */
+) const -> Model
+{
+	ZoneScoped;
+
+	auto loader = GltfLoader {
+		vk_context,
+		memory_allocator,
+		&texture_loader,
+		residency_manager,
+		position_buffer,
+		attribute_buffer,
+		index_buffer,
+		staging_vertex_buffer,
+		staging_index_buffer,
+		staging_image_buffer,
+	};
+
+	return std::move(loader.load_from_binary(file_path, debug_name, vertex_encoding));
+}
+
+auto ModelLoader::load_from_asset(
+    str_view const file_path,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
+    FragmentedBuffer *const index_buffer,
+    Buffer *const staging_vertex_buffer,
+    Buffer *const staging_index_buffer,
+    Buffer *const staging_image_buffer,
+    str_view const debug_name /* = default_debug_name */
+) const -> Model
+{
+	ZoneScoped;
+
+	auto loader = MeshAssetLoader {
+		vk_context,
+		&texture_loader,
+		position_buffer,
+		attribute_buffer,
+		index_buffer,
+		staging_vertex_buffer,
+		staging_index_buffer,
+		staging_image_buffer,
+	};
+
+	return std::move(loader.load(file_path, debug_name));
+}
+
+auto ModelLoader::load_from_archive(
+    Assets::AssetArchive const *const archive,
+    str_view const name,
+    FragmentedBuffer *const position_buffer,
+    FragmentedBuffer *const attribute_buffer,
+    FragmentedBuffer *const index_buffer,
+    Buffer *const staging_vertex_buffer,
+    Buffer *const staging_index_buffer,
+    Buffer *const staging_image_buffer,
+    str_view const debug_name /* = default_debug_name */
+) const -> Model
+{
+	ZoneScoped;
+
+	auto loader = MeshAssetLoader {
+		vk_context,
+		&texture_loader,
+		position_buffer,
+		attribute_buffer,
+		index_buffer,
+		staging_vertex_buffer,
+		staging_index_buffer,
+		staging_image_buffer,
+	};
+
+	return std::move(loader.load(archive, name, debug_name));
 }
 
 } // namespace BINDLESSVK_NAMESPACE
@@ -0,0 +1,106 @@
+#include "BindlessVk/Shader/Loaders/PackLoader.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+PackLoader::PackLoader(VkContext const *const vk_context): device(vk_context->get_device())
+{
+	ZoneScoped;
+}
+
+auto PackLoader::load(Assets::ShaderPack const *const pack, str_view const name) -> Shader
+{
+	ZoneScoped;
+
+	this->pack = pack;
+	entry = pack->find(name);
+
+	assert_true(entry, "Shader {} was not found in the shader pack", name);
+
+	load_shader_stage();
+	load_descriptor_set_bindings();
+	load_push_constant_range();
+	load_specialization_constants();
+
+	create_vulkan_shader_module();
+
+	return shader;
+}
+
+void PackLoader::create_vulkan_shader_module()
+{
+	ZoneScoped;
+
+	// code is consumed straight from the mapped pack
+	shader.module = device->vk().createShaderModule(vk::ShaderModuleCreateInfo {
+	    {},
+	    entry->code_size,
+	    pack->get_code(entry),
+	});
+}
+
+void PackLoader::load_shader_stage()
+{
+	ZoneScoped;
+
+	shader.stage = static_cast<vk::ShaderStageFlagBits>(entry->stage);
+
+	assert_true(
+	    shader.stage == vk::ShaderStageFlagBits::eVertex
+	        || shader.stage == vk::ShaderStageFlagBits::eFragment
+	        || shader.stage == vk::ShaderStageFlagBits::eCompute,
+	    "Packed shader stage is invalid: {}",
+	    entry->stage
+	);
+}
+
+void PackLoader::load_descriptor_set_bindings()
+{
+	ZoneScoped;
+
+	auto const *const bindings = pack->get_bindings(entry);
+
+	for (u32 i = 0; i < entry->binding_count; ++i)
+	{
+		auto const &binding = bindings[i];
+
+		if (shader.descriptor_set_bindings.size() < binding.binding + 1u)
+			shader.descriptor_set_bindings.resize(binding.binding + 1u);
+
+		shader.descriptor_set_bindings[binding.binding] = vk::DescriptorSetLayoutBinding {
+			binding.binding,
+			static_cast<vk::DescriptorType>(binding.descriptor_type),
+			binding.descriptor_count,
+			shader.stage,
+		};
+	}
+}
+
+void PackLoader::load_push_constant_range()
+{
+	ZoneScoped;
+
+	if (!entry->push_constant_size)
+		return;
+
+	shader.push_constant_range = vk::PushConstantRange {
+		shader.stage,
+		entry->push_constant_offset,
+		entry->push_constant_size,
+	};
+}
+
+void PackLoader::load_specialization_constants()
+{
+	ZoneScoped;
+
+	auto const *const constants = pack->get_specialization_constants(entry);
+
+	shader.specialization_constants.reserve(entry->specialization_constant_count);
+	for (u32 i = 0; i < entry->specialization_constant_count; ++i)
+		shader.specialization_constants.push_back({
+		    str { pack->get_name(&constants[i]) },
+		    constants[i].constant_id,
+		});
+}
+
+} // namespace BINDLESSVK_NAMESPACE
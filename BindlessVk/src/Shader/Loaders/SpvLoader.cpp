@@ -25,7 +25,9 @@ void SpvLoader::load_code(str_view const path)
 {
 	ZoneScoped;
 
-	auto file_stream = std::ifstream(path.data(), std::ios::ate);
+	auto file_stream = std::ifstream(path.data(), std::ios::binary | std::ios::ate);
+	assert_true(file_stream.is_open(), "Failed to open spv file: {}", path);
+
 	usize const file_size = file_stream.tellg();
 	code.resize(file_size / sizeof(u32));
 
@@ -45,6 +47,8 @@ void SpvLoader::reflect_code()
 
 	reflect_shader_stage();
 	reflect_descriptor_sets();
+	reflect_specialization_constants();
+	reflect_push_constant_blocks();
 }
 
 void SpvLoader::create_vulkan_shader_module()
@@ -81,11 +85,74 @@ void SpvLoader::reflect_descriptor_sets()
 	// shader uses (set = 2) descriptor set, which is the per-shader set slot
 	// set = 1 -> per pass
 	// set = 0 -> per graph(frame)
-	if (descriptor_sets_reflection.size() >= 2)
+	// sets are enumerated by usage, not by their set number
+	for (auto const *const spv_set : descriptor_sets_reflection)
+		if (spv_set->set == 2)
+			shader.descriptor_set_bindings = reflect_descriptor_set_bindings(spv_set);
+}
+
+void SpvLoader::reflect_specialization_constants()
+{
+	ZoneScoped;
+
+	u32 constants_count = 0;
+	assert_false(
+	    spvReflectEnumerateSpecializationConstants(&reflection, &constants_count, nullptr),
+	    "spvReflectEnumerateSpecializationConstants failed"
+	);
+
+	vec<SpvReflectSpecializationConstant *> constants_reflection(constants_count);
+	assert_false(
+	    spvReflectEnumerateSpecializationConstants(
+	        &reflection,
+	        &constants_count,
+	        constants_reflection.data()
+	    ),
+	    "spvReflectEnumerateSpecializationConstants failed"
+	);
+
+	shader.specialization_constants.reserve(constants_count);
+	for (auto const *const spv_constant : constants_reflection)
+		shader.specialization_constants.push_back({
+		    spv_constant->name ? spv_constant->name : "",
+		    spv_constant->constant_id,
+		});
+}
+
+void SpvLoader::reflect_push_constant_blocks()
+{
+	ZoneScoped;
+
+	u32 blocks_count = 0;
+	assert_false(
+	    spvReflectEnumeratePushConstantBlocks(&reflection, &blocks_count, nullptr),
+	    "spvReflectEnumeratePushConstantBlocks failed"
+	);
+
+	vec<SpvReflectBlockVariable *> blocks_reflection(blocks_count);
+	assert_false(
+	    spvReflectEnumeratePushConstantBlocks(&reflection, &blocks_count, blocks_reflection.data()),
+	    "spvReflectEnumeratePushConstantBlocks failed"
+	);
+
+	// glsl allows a single push_constant block per entry point, merge them anyways
+	auto range_begin = std::numeric_limits<u32>::max();
+	auto range_end = u32 {};
+
+	for (auto const *const spv_block : blocks_reflection)
 	{
-		auto const *const spv_set = descriptor_sets_reflection[2];
-		shader.descriptor_set_bindings = reflect_descriptor_set_bindings(spv_set);
+		range_begin = std::min(range_begin, spv_block->offset);
+		range_end = std::max(range_end, spv_block->offset + spv_block->size);
 	}
+
+	if (blocks_reflection.empty())
+		return;
+
+	shader.push_constant_range = vk::PushConstantRange {
+		shader.stage,
+		range_begin,
+		range_end - range_begin,
+	};
 }
 
 auto SpvLoader::reflect_descriptor_set_bindings(SpvReflectDescriptorSet const *const spv_set)
@@ -14,15 +14,26 @@ ShaderPipeline::ShaderPipeline(
     str_view const debug_name /* = default_debug_name */
 )
     : device(vk_context->get_device())
+    , vk_context(vk_context)
     , surface(vk_context->get_surface())
     , layout_allocator(layout_allocator)
+    , type(type)
+    , configuration(configuration)
+    , graph_descriptor_set_layout(graph_descriptor_set_layout)
+    , pass_descriptor_set_layout(pass_descriptor_set_layout)
+    , specialization_values(configuration.specialization_values)
     , debug_name(debug_name)
 {
 	ZoneScoped;
 
 	assert_false(shaders.empty(), "No shaders provided to shader pipeline {}", debug_name);
 
+	this->shaders.reserve(shaders.size());
+	for (Shader const *const shader : shaders)
+		this->shaders.push_back(*shader);
+
 	create_descriptor_set_layout(shaders);
+	combine_push_constant_ranges(shaders);
 	create_pipeline_layout(graph_descriptor_set_layout, pass_descriptor_set_layout);
 
 	if (type == Type::eCompute)
@@ -45,6 +56,34 @@ ShaderPipeline::~ShaderPipeline()
 	device->vk().destroyPipeline(pipeline);
 }
 
+auto ShaderPipeline::recreate_with_shader(Shader const &shader) const -> ShaderPipeline
+{
+	ZoneScoped;
+
+	auto new_shaders = shaders;
+	auto new_shader_ptrs = vec<Shader *> {};
+	new_shader_ptrs.reserve(new_shaders.size());
+
+	for (auto &new_shader : new_shaders)
+	{
+		if (new_shader.stage == shader.stage)
+			new_shader = shader;
+
+		new_shader_ptrs.push_back(&new_shader);
+	}
+
+	return ShaderPipeline {
+		vk_context,
+		layout_allocator,
+		type,
+		new_shader_ptrs,
+		configuration,
+		graph_descriptor_set_layout,
+		pass_descriptor_set_layout,
+		debug_name,
+	};
+}
+
 void ShaderPipeline::create_descriptor_set_layout(vec<Shader *> const &shaders)
 {
 	ZoneScoped;
@@ -65,6 +104,33 @@ void ShaderPipeline::create_descriptor_set_layout(vec<Shader *> const &shaders)
 	device->set_object_name(descriptor_set_layout.vk(), "{}_descriptor_set_layout", debug_name);
 }
 
+void ShaderPipeline::combine_push_constant_ranges(vec<Shader *> const &shaders)
+{
+	ZoneScoped;
+
+	// A single range visible to every stage that uses push constants, this keeps the
+	// vkCmdPushConstants stage flags trivial and satisfies the one-range-per-stage rule
+	auto range_begin = std::numeric_limits<u32>::max();
+	auto range_end = u32 {};
+
+	for (Shader const *const shader : shaders)
+	{
+		auto const &range = shader->push_constant_range;
+		if (!range.size)
+			continue;
+
+		push_constant_range.stageFlags |= range.stageFlags;
+		range_begin = std::min(range_begin, range.offset);
+		range_end = std::max(range_end, range.offset + range.size);
+	}
+
+	if (!push_constant_range.stageFlags)
+		return;
+
+	push_constant_range.offset = range_begin;
+	push_constant_range.size = range_end - range_begin;
+}
+
 void ShaderPipeline::create_pipeline_layout(
     DescriptorSetLayoutWithHash graph_descriptor_set_layout,
     DescriptorSetLayoutWithHash pass_descriptor_set_layout
@@ -76,7 +142,9 @@ void ShaderPipeline::create_pipeline_layout(
 	    {},
 	    graph_descriptor_set_layout, // set = 0 -> per graph(frame)
 	    pass_descriptor_set_layout,  // set = 1 -> per pass
-	    this->descriptor_set_layout  // set = 2 -> per shader
+	    this->descriptor_set_layout, // set = 2 -> per shader
+	    push_constant_range.size ? span<vk::PushConstantRange const> { &push_constant_range, 1 }
+	                             : span<vk::PushConstantRange const> {}
 	);
 	device->set_object_name(pipeline_layout, "{}_pipeline_layout", debug_name);
 }
@@ -97,7 +165,11 @@ void ShaderPipeline::create_graphics_pipeline(
 		{},
 	};
 
-	auto const shader_stage_create_infos = create_shader_stage_create_infos(shaders);
+	auto stage_specializations = vec<StageSpecialization> {};
+	auto const shader_stage_create_infos = create_shader_stage_create_infos(
+	    shaders,
+	    stage_specializations
+	);
 
 	auto const color_blend_state = vk::PipelineColorBlendStateCreateInfo {
 		{},
@@ -149,7 +221,11 @@ void ShaderPipeline::create_compute_pipeline(vec<Shader *> const &shaders)
 {
 	ZoneScoped;
 
-	auto const shader_stage_create_infos = create_shader_stage_create_infos(shaders);
+	auto stage_specializations = vec<StageSpecialization> {};
+	auto const shader_stage_create_infos = create_shader_stage_create_infos(
+	    shaders,
+	    stage_specializations
+	);
 
 	auto const compute_pipeline_info = vk::ComputePipelineCreateInfo {
 		{}, //
@@ -192,23 +268,78 @@ auto ShaderPipeline::combine_descriptor_sets_bindings(vec<Shader *> const &shade
 	return combined_bindings;
 }
 
-auto ShaderPipeline::create_shader_stage_create_infos(vec<Shader *> const &shaders) const
-    -> vec<vk::PipelineShaderStageCreateInfo>
+auto ShaderPipeline::create_shader_stage_create_infos(
+    vec<Shader *> const &shaders,
+    vec<StageSpecialization> &stage_specializations
+) const -> vec<vk::PipelineShaderStageCreateInfo>
 {
 	ZoneScoped;
 
 	auto shader_stage_create_infos = vec<vk::PipelineShaderStageCreateInfo> {};
 	shader_stage_create_infos.resize(shaders.size());
 
+	// resized upfront, infos point into this vector
+	stage_specializations.resize(shaders.size());
+
 	for (u32 i = 0; auto const &shader : shaders)
+	{
+		auto &stage_specialization = stage_specializations[i];
+		create_stage_specialization(shader, stage_specialization);
+
 		shader_stage_create_infos[i++] = {
 			{},
 			shader->stage,
 			shader->module,
 			"main",
+			stage_specialization.map_entries.empty() ? nullptr : &stage_specialization.info,
 		};
+	}
 
 	return shader_stage_create_infos;
 }
 
+void ShaderPipeline::create_stage_specialization(
+    Shader const *const shader,
+    StageSpecialization &stage_specialization
+) const
+{
+	ZoneScoped;
+
+	for (auto const &specialization_value : specialization_values)
+	{
+		auto const &constants = shader->specialization_constants;
+		auto const is_used_by_shader = std::any_of(
+		    constants.begin(),
+		    constants.end(),
+		    [&](auto const &constant) {
+			    return constant.constant_id == specialization_value.constant_id;
+		    }
+		);
+
+		if (!is_used_by_shader)
+			continue;
+
+		auto const offset = static_cast<u32>(stage_specialization.data.size());
+		stage_specialization.data.resize(offset + specialization_value.size);
+		memcpy(
+		    stage_specialization.data.data() + offset,
+		    &specialization_value.data,
+		    specialization_value.size
+		);
+
+		stage_specialization.map_entries.emplace_back(
+		    specialization_value.constant_id,
+		    offset,
+		    specialization_value.size
+		);
+	}
+
+	stage_specialization.info = vk::SpecializationInfo {
+		static_cast<u32>(stage_specialization.map_entries.size()),
+		stage_specialization.map_entries.data(),
+		stage_specialization.data.size(),
+		stage_specialization.data.data(),
+	};
+}
+
 } // namespace BINDLESSVK_NAMESPACE
@@ -1,6 +1,7 @@
 #include "BindlessVk/Shader/ShaderLoader.hpp"
 
 
+#include "BindlessVk/Shader/Loaders/PackLoader.hpp"
 #include "BindlessVk/Shader/Loaders/SpvLoader.hpp"
 
 namespace BINDLESSVK_NAMESPACE {
@@ -18,4 +19,13 @@ auto ShaderLoader::load_from_spv(str_view const file_path) -> Shader
 	return loader.load(file_path);
 }
 
+auto ShaderLoader::load_from_pack(Assets::ShaderPack const *const pack, str_view const name)
+    -> Shader
+{
+	ZoneScoped;
+
+	PackLoader loader(vk_context);
+	return loader.load(pack, name);
+}
+
 } // namespace BINDLESSVK_NAMESPACE
@@ -0,0 +1,639 @@
+#include "BindlessVk/Texture/Loaders/AssetLoader.hpp"
+
+#include "BindlessVk/Texture/Loaders/BinaryLoader.hpp"
+
+#include <TextureCompression.hpp>
+
+namespace BINDLESSVK_NAMESPACE {
+
+AssetLoader::AssetLoader(
+    VkContext const *const vk_context,
+    MemoryAllocator const *const memory_allocator,
+    Buffer *const staging_buffer,
+    GpuDecompressor *const gpu_decompressor /* = {} */
+)
+    : vk_context(vk_context)
+    , device(vk_context->get_device())
+    , memory_allocator(memory_allocator)
+    , sampler_cache(vk_context->get_sampler_cache())
+    , staging_buffer(staging_buffer)
+    , uploader(vk_context, staging_buffer)
+    , gpu_decompressor(gpu_decompressor)
+{
+	ZoneScoped;
+
+	texture.device = vk_context->get_device();
+	texture.memory_allocator = memory_allocator;
+	texture.sampler_cache = sampler_cache;
+}
+
+Texture AssetLoader::load(
+    str_view const path,
+    Texture::Type const type,
+    vk::ImageLayout const final_layout,
+    str_view const debug_name
+)
+{
+	ZoneScoped;
+
+	// The json & blob are read straight from the mapping, without copying them to the heap
+	assert_true(
+	    Assets::map_binary_file(str(path).c_str(), mapped_file),
+	    "Failed to map asset file: \nname: {}\npath: {}",
+	    debug_name,
+	    path
+	);
+
+	return load(mapped_file, type, final_layout, debug_name);
+}
+
+Texture AssetLoader::load(
+    Assets::AssetView const &asset_view,
+    Texture::Type const type,
+    vk::ImageLayout const final_layout,
+    str_view const debug_name
+)
+{
+	ZoneScoped;
+
+	texture.debug_name = debug_name;
+	asset = asset_view;
+	read_texture_info();
+
+	if (texture_info.mip_levels == 1u && texture_info.format == Assets::TextureFormat::RGBA8)
+		return load_with_runtime_mipmaps(type, final_layout);
+
+	create_image();
+	create_image_view();
+	create_sampler();
+
+	upload_texture_data(final_layout);
+
+	return std::move(texture);
+}
+
+void AssetLoader::read_texture_info()
+{
+	ZoneScoped;
+
+	assert_true(
+	    asset.type == Assets::AssetFile::Type::Texture,
+	    "Asset file is not a texture: {}",
+	    texture.debug_name
+	);
+
+	texture_info = Assets::read_texture_info(asset.json);
+
+	assert_true(
+	    texture_info.mip_sizes.size() == texture_info.mip_levels,
+	    "Asset texture mip level count mismatch ({} != {})",
+	    texture_info.mip_sizes.size(),
+	    texture_info.mip_levels
+	);
+
+	texture.size = { texture_info.pixel_size[0], texture_info.pixel_size[1] };
+	texture.format = select_format();
+	texture.mip_levels = texture_info.mip_levels;
+	texture.current_layout = vk::ImageLayout::eUndefined;
+
+	calculate_level_offsets();
+}
+
+auto AssetLoader::select_format() -> vk::Format
+{
+	ZoneScoped;
+
+	auto const native_format = get_native_format(texture_info.format);
+
+	if (!Assets::is_block_compressed(texture_info.format))
+		return native_format;
+
+	auto const required_features = vk::FormatFeatureFlagBits::eSampledImage
+	                               | vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+
+	if (vk_context->get_gpu()->supports_format(native_format, required_features))
+		return native_format;
+
+	log_wrn(
+	    "Block-compressed format {} is not supported, transcoding {} on the cpu",
+	    static_cast<i32>(native_format),
+	    texture.debug_name
+	);
+
+	transcode = true;
+	return texture_info.format == Assets::TextureFormat::BC5 ? vk::Format::eR8G8B8A8Unorm :
+	                                                           vk::Format::eR8G8B8A8Srgb;
+}
+
+auto AssetLoader::get_native_format(Assets::TextureFormat const format) const -> vk::Format
+{
+	switch (format)
+	{
+	case Assets::TextureFormat::RGBA8: return vk::Format::eR8G8B8A8Srgb;
+	case Assets::TextureFormat::BC1: return vk::Format::eBc1RgbSrgbBlock;
+	case Assets::TextureFormat::BC5: return vk::Format::eBc5UnormBlock;
+	case Assets::TextureFormat::BC7: return vk::Format::eBc7SrgbBlock;
+
+	default: assert_fail("Unsupported asset texture format: {}", static_cast<u32>(format));
+	}
+
+	return vk::Format::eUndefined;
+}
+
+void AssetLoader::calculate_level_offsets()
+{
+	ZoneScoped;
+
+	auto const [width, height] = texture.size;
+	auto const staged_format = transcode ? Assets::TextureFormat::RGBA8 : texture_info.format;
+
+	level_offsets.clear();
+	texture.device_size = 0u;
+
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		level_offsets.push_back(texture.device_size);
+		texture.device_size += Assets::get_level_size(
+		    staged_format,
+		    std::max(width >> level, 1u),
+		    std::max(height >> level, 1u)
+		);
+	}
+}
+
+auto AssetLoader::load_with_runtime_mipmaps(
+    Texture::Type const type,
+    vk::ImageLayout const final_layout
+) -> Texture
+{
+	ZoneScoped;
+
+	log_wrn("Asset texture {} has no baked mips, generating them at runtime", texture.debug_name);
+
+	auto pixels = vec<u8>(texture_info.size);
+	assert_true(
+	    Assets::unpack_texture(
+	        &texture_info,
+	        asset.blob,
+	        asset.blob_size,
+	        pixels.data()
+	    ),
+	    "Failed to unpack texture {}",
+	    texture.debug_name
+	);
+
+	auto const [width, height] = texture.size;
+
+	BinaryLoader loader(vk_context, memory_allocator, staging_buffer);
+	return std::move(loader.load(
+	    pixels.data(),
+	    width,
+	    height,
+	    pixels.size(),
+	    type,
+	    final_layout,
+	    texture.debug_name
+	));
+}
+
+void AssetLoader::upload_texture_data(vk::ImageLayout const final_layout)
+{
+	ZoneScoped;
+
+	uploader.record([&](vk::CommandBuffer cmd) {
+		texture.transition_layout(
+		    cmd,
+		    0u,
+		    texture.mip_levels,
+		    1u,
+		    vk::ImageLayout::eTransferDstOptimal
+		);
+	});
+
+	if (transcode)
+		upload_transcoded_levels();
+
+	else if (can_decompress_on_gpu())
+		upload_gpu_decompressed_levels();
+
+	else if (texture.device_size <= uploader.get_capacity())
+		upload_packed_levels();
+
+	else if (can_unpack_ranges())
+		upload_level_ranges();
+
+	else
+		upload_unpacked_levels();
+
+	uploader.record([&](vk::CommandBuffer cmd) {
+		texture.transition_layout(cmd, 0u, texture.mip_levels, 1u, final_layout);
+	});
+
+	uploader.flush();
+	texture.descriptor_info.imageLayout = texture.current_layout;
+}
+
+auto AssetLoader::can_decompress_on_gpu() const -> bool
+{
+	ZoneScoped;
+
+	// LZ4HC blocks are plain LZ4 blocks
+	auto const is_lz4 = texture_info.compression_mode == Assets::CompressionMode::LZ4
+	                    || texture_info.compression_mode == Assets::CompressionMode::LZ4HC;
+
+	return gpu_decompressor && is_lz4 && !texture_info.chunks.empty()
+	       && gpu_decompressor->can_decompress(
+	           uploader,
+	           asset.blob_size,
+	           texture_info.chunks.size(),
+	           texture_info.size
+	       );
+}
+
+void AssetLoader::upload_gpu_decompressed_levels()
+{
+	ZoneScoped;
+
+	// Only the compressed blob goes through the staging buffer
+	gpu_decompressor->decompress(
+	    uploader,
+	    asset.blob,
+	    asset.blob_size,
+	    texture_info.chunks,
+	    texture_info.chunk_size,
+	    texture_info.size
+	);
+
+	gpu_decompressor->copy_to_image(uploader, texture, create_mip_buffer_copies(0u));
+
+	if (!gpu_decompressor->is_validating())
+		return;
+
+	auto expected = vec<u8>(texture_info.size);
+	assert_true(
+	    Assets::unpack_texture(
+	        &texture_info,
+	        asset.blob,
+	        asset.blob_size,
+	        expected.data()
+	    ),
+	    "Failed to unpack texture {}",
+	    texture.debug_name
+	);
+
+	assert_true(
+	    gpu_decompressor->validate(uploader, expected.data(), expected.size()),
+	    "Gpu decompression of texture {} doesn't match the cpu reference",
+	    texture.debug_name
+	);
+}
+
+void AssetLoader::upload_packed_levels()
+{
+	ZoneScoped;
+
+	// Decompress straight into the staging buffer, no intermediate copy
+	auto const [map, offset] = uploader.allocate(texture.device_size);
+	assert_true(
+	    Assets::unpack_texture(&texture_info, asset.blob, asset.blob_size, map),
+	    "Failed to unpack texture {}",
+	    texture.debug_name
+	);
+
+	uploader.copy_staged_to_image(texture, create_mip_buffer_copies(offset));
+}
+
+auto AssetLoader::can_unpack_ranges() const -> bool
+{
+	ZoneScoped;
+
+	return texture_info.compression_mode == Assets::CompressionMode::None
+	       || !texture_info.chunks.empty();
+}
+
+void AssetLoader::upload_level_ranges()
+{
+	ZoneScoped;
+
+	auto const [width, height] = texture.size;
+	auto const block_extent = Assets::is_block_compressed(texture_info.format) ? 4u : 1u;
+	auto const block = TexelBlock {
+		block_extent,
+		block_extent,
+		static_cast<u32>(Assets::get_block_size(texture_info.format)),
+	};
+
+	// Block rows are unpacked straight into the staging buffer, as many as fit at a time
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		auto const level_width = std::max(width >> level, 1u);
+		auto const level_height = std::max(height >> level, 1u);
+
+		auto const block_rows = (level_height + block.height - 1u) / block.height;
+		auto const row_size = static_cast<vk::DeviceSize>(
+		                          (level_width + block.width - 1u) / block.width
+		                      )
+		                      * block.size;
+
+		assert_true(
+		    row_size <= uploader.get_capacity(),
+		    "A block row of texture {} doesn't fit in the staging buffer ({} > {})",
+		    texture.debug_name,
+		    row_size,
+		    uploader.get_capacity()
+		);
+
+		auto const max_chunk_rows = static_cast<u32>(uploader.get_capacity() / row_size);
+
+		for (auto row = 0u; row < block_rows;)
+		{
+			auto const chunk_rows = std::min(max_chunk_rows, block_rows - row);
+			auto const chunk_size = chunk_rows * row_size;
+			auto const [map, offset] = uploader.allocate(chunk_size);
+
+			assert_true(
+			    Assets::unpack_texture_range(
+			        &texture_info,
+			        asset.blob,
+			        asset.blob_size,
+			        level_offsets[level] + row * row_size,
+			        chunk_size,
+			        map
+			    ),
+			    "Failed to unpack level {} of texture {}",
+			    level,
+			    texture.debug_name
+			);
+
+			auto const y = row * block.height;
+			uploader.copy_staged_to_image(
+			    texture,
+			    {
+			        vk::BufferImageCopy {
+			            offset,
+			            0u,
+			            0u,
+			            vk::ImageSubresourceLayers {
+			                vk::ImageAspectFlagBits::eColor,
+			                level,
+			                0u,
+			                1u,
+			            },
+			            vk::Offset3D { 0, static_cast<i32>(y), 0 },
+			            vk::Extent3D {
+			                level_width,
+			                std::min(chunk_rows * block.height, level_height - y),
+			                1u,
+			            },
+			        },
+			    }
+			);
+
+			row += chunk_rows;
+		}
+	}
+}
+
+void AssetLoader::upload_unpacked_levels()
+{
+	ZoneScoped;
+
+	auto data = vec<u8>(texture_info.size);
+	assert_true(
+	    Assets::unpack_texture(
+	        &texture_info,
+	        asset.blob,
+	        asset.blob_size,
+	        data.data()
+	    ),
+	    "Failed to unpack texture {}",
+	    texture.debug_name
+	);
+
+	auto const [width, height] = texture.size;
+	auto const block_extent = Assets::is_block_compressed(texture_info.format) ? 4u : 1u;
+	auto const block = TexelBlock {
+		block_extent,
+		block_extent,
+		static_cast<u32>(Assets::get_block_size(texture_info.format)),
+	};
+
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		uploader.copy_to_image(
+		    texture,
+		    level,
+		    0u,
+		    data.data() + level_offsets[level],
+		    std::max(width >> level, 1u),
+		    std::max(height >> level, 1u),
+		    block
+		);
+	}
+}
+
+void AssetLoader::upload_transcoded_levels()
+{
+	ZoneScoped;
+
+	// Chunked blobs are unpacked a level at a time, older ones as a whole
+	auto const is_rangeable = can_unpack_ranges();
+
+	auto blocks = vec<u8> {};
+	if (!is_rangeable)
+	{
+		blocks.resize(texture_info.size);
+		assert_true(
+		    Assets::unpack_texture(
+		        &texture_info,
+		        asset.blob,
+		        asset.blob_size,
+		        blocks.data()
+		    ),
+		    "Failed to unpack texture {}",
+		    texture.debug_name
+		);
+	}
+
+	auto const [width, height] = texture.size;
+	auto pixels = vec<u8> {};
+
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		auto const level_width = std::max(width >> level, 1u);
+		auto const level_height = std::max(height >> level, 1u);
+
+		pixels.resize(static_cast<usize>(level_width) * level_height * 4u);
+
+		auto const *level_blocks = blocks.data() + Assets::get_mip_offset(&texture_info, level);
+		if (is_rangeable)
+		{
+			blocks.resize(texture_info.mip_sizes[level]);
+			assert_true(
+			    Assets::unpack_texture_range(
+			        &texture_info,
+			        asset.blob,
+			        asset.blob_size,
+			        Assets::get_mip_offset(&texture_info, level),
+			        blocks.size(),
+			        blocks.data()
+			    ),
+			    "Failed to unpack level {} of texture {}",
+			    level,
+			    texture.debug_name
+			);
+
+			level_blocks = blocks.data();
+		}
+
+		assert_true(
+		    Assets::decompress_level(
+		        texture_info.format,
+		        level_blocks,
+		        level_width,
+		        level_height,
+		        pixels.data()
+		    ),
+		    "Failed to transcode level {} of texture {}",
+		    level,
+		    texture.debug_name
+		);
+
+		uploader.copy_to_image(
+		    texture,
+		    level,
+		    0u,
+		    pixels.data(),
+		    level_width,
+		    level_height,
+		    { 1u, 1u, 4u }
+		);
+	}
+}
+
+void AssetLoader::create_image()
+{
+	ZoneScoped;
+
+	auto const [width, height] = texture.size;
+
+	texture.image = Image {
+		memory_allocator,
+
+		vk::ImageCreateInfo {
+		    {},
+		    vk::ImageType::e2D,
+		    texture.format,
+		    vk::Extent3D {
+		        width,
+		        height,
+		        1u,
+		    },
+		    texture.mip_levels,
+		    1u,
+		    vk::SampleCountFlagBits::e1,
+		    vk::ImageTiling::eOptimal,
+		    vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc
+		        | vk::ImageUsageFlagBits::eSampled,
+		    vk::SharingMode::eExclusive,
+		    0u,
+		    nullptr,
+		    vk::ImageLayout::eUndefined,
+		},
+
+		vma::AllocationCreateInfo {
+		    {},
+		    vma::MemoryUsage::eGpuOnly,
+		    vk::MemoryPropertyFlagBits::eDeviceLocal,
+		},
+	};
+}
+
+void AssetLoader::create_image_view()
+{
+	ZoneScoped;
+
+	texture.image_view = device->vk().createImageView(vk::ImageViewCreateInfo {
+	    {},
+	    texture.image.vk(),
+	    vk::ImageViewType::e2D,
+	    texture.format,
+	    vk::ComponentMapping {
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	    },
+	    vk::ImageSubresourceRange {
+	        vk::ImageAspectFlagBits::eColor,
+	        0u,
+	        texture.mip_levels,
+	        0u,
+	        1u,
+	    },
+	});
+
+	texture.descriptor_info.imageView = texture.image_view;
+}
+
+void AssetLoader::create_sampler()
+{
+	ZoneScoped;
+
+	texture.sampler = sampler_cache->acquire(vk::SamplerCreateInfo {
+	    {},
+	    vk::Filter::eLinear,
+	    vk::Filter::eLinear,
+	    vk::SamplerMipmapMode::eLinear,
+	    vk::SamplerAddressMode::eRepeat,
+	    vk::SamplerAddressMode::eRepeat,
+	    vk::SamplerAddressMode::eRepeat,
+	    0.0f,
+	    VK_FALSE,
+	    {},
+	    VK_FALSE,
+	    vk::CompareOp::eAlways,
+	    0.0f,
+	    VK_LOD_CLAMP_NONE, // The image view clamps, lets textures share samplers
+	    vk::BorderColor::eIntOpaqueBlack,
+	    VK_FALSE,
+	});
+
+	texture.descriptor_info.sampler = texture.sampler;
+}
+
+auto AssetLoader::create_mip_buffer_copies(vk::DeviceSize const base_offset) const
+    -> vec<vk::BufferImageCopy>
+{
+	ZoneScoped;
+
+	auto const [width, height] = texture.size;
+
+	auto buffer_copies = vec<vk::BufferImageCopy> {};
+	buffer_copies.reserve(texture.mip_levels);
+
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		buffer_copies.emplace_back(vk::BufferImageCopy {
+		    base_offset + level_offsets[level],
+		    {},
+		    {},
+		    {
+		        vk::ImageAspectFlagBits::eColor,
+		        level,
+		        0u,
+		        1u,
+		    },
+		    {},
+		    {
+		        std::max(width >> level, 1u),
+		        std::max(height >> level, 1u),
+		        1u,
+		    },
+		});
+	}
+
+	return buffer_copies;
+}
+
+} // namespace BINDLESSVK_NAMESPACE
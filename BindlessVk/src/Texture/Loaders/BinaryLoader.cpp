@@ -11,12 +11,10 @@ BinaryLoader::BinaryLoader(
 )
     : device(vk_context->get_device())
     , memory_allocator(memory_allocator)
-    , staging_buffer(staging_buffer)
+    , sampler_cache(vk_context->get_sampler_cache())
+    , uploader(vk_context, staging_buffer)
 {
 	ZoneScoped;
-
-	texture.device = device;
-	texture.memory_allocator = memory_allocator;
 }
 
 Texture BinaryLoader::load(
@@ -31,23 +29,82 @@ Texture BinaryLoader::load(
 {
 	ZoneScoped;
 
-	texture.size = { width, height };
-	texture.format = vk::Format::eR8G8B8A8Srgb;
-	texture.mip_levels = std::floor(std::log2(std::max(width, height))) + 1;
-	texture.device_size = size;
-	texture.debug_name = debug_name;
+	auto const info = TextureLoader::BinaryTextureInfo {
+		pixels, width, height, size, debug_name,
+	};
+
+	return std::move(load_batch({ &info, 1 }, type, final_layout).front());
+}
+
+auto BinaryLoader::load_batch(
+    span<TextureLoader::BinaryTextureInfo const> const infos,
+    Texture::Type const type,
+    vk::ImageLayout const final_layout
+) -> vec<Texture>
+{
+	ZoneScoped;
+
+	begin_batch(infos.size());
+
+	for (u32 i = 0; i < infos.size(); ++i)
+		add_to_batch(i, infos[i]);
+
+	return end_batch();
+}
+
+void BinaryLoader::begin_batch(usize const count)
+{
+	ZoneScoped;
+
+	// Filled up-front, the recorded upload commands hold references into this vector
+	batch_textures.clear();
+	batch_textures.reserve(count);
+
+	for (usize i = 0; i < count; ++i)
+		batch_textures.emplace_back(Texture {});
+}
+
+void BinaryLoader::add_to_batch(u32 const index, TextureLoader::BinaryTextureInfo const &info)
+{
+	ZoneScoped;
+
+	auto &texture = batch_textures[index];
+
+	create_texture(info, texture);
+	upload_texture_data(info, texture);
+}
 
-	create_image();
-	create_image_view();
-	create_sampler();
+auto BinaryLoader::end_batch() -> vec<Texture>
+{
+	ZoneScoped;
 
-	stage_texture_data(pixels, size);
-	write_texture_data_to_gpu();
+	uploader.flush();
+	return std::move(batch_textures);
+}
+
+void BinaryLoader::create_texture(
+    TextureLoader::BinaryTextureInfo const &info,
+    Texture &texture
+)
+{
+	ZoneScoped;
+
+	texture.device = device;
+	texture.memory_allocator = memory_allocator;
+	texture.sampler_cache = sampler_cache;
+
+	texture.size = { info.width, info.height };
+	texture.format = vk::Format::eR8G8B8A8Srgb;
+	texture.mip_levels = std::floor(std::log2(std::max(info.width, info.height))) + 1;
+	texture.device_size = info.size;
+	texture.debug_name = info.debug_name;
 
-	return std::move(texture);
+	create_image(texture);
+	create_image_view(texture);
+	create_sampler(texture);
 }
 
-void BinaryLoader::create_image()
+void BinaryLoader::create_image(Texture &texture)
 {
 	ZoneScoped;
 
@@ -85,7 +142,7 @@ void BinaryLoader::create_image()
 	};
 }
 
-void BinaryLoader::create_image_view()
+void BinaryLoader::create_image_view(Texture &texture)
 {
 	ZoneScoped;
 
@@ -112,11 +169,11 @@ void BinaryLoader::create_image_view()
 	texture.descriptor_info.imageView = texture.image_view;
 }
 
-void BinaryLoader::create_sampler()
+void BinaryLoader::create_sampler(Texture &texture)
 {
 	ZoneScoped;
 
-	texture.sampler = device->vk().createSampler(vk::SamplerCreateInfo {
+	texture.sampler = sampler_cache->acquire(vk::SamplerCreateInfo {
 	    {},
 	    vk::Filter::eLinear,
 	    vk::Filter::eLinear,
@@ -130,7 +187,7 @@ void BinaryLoader::create_sampler()
 	    VK_FALSE,
 	    vk::CompareOp::eAlways,
 	    0.0f,
-	    static_cast<f32>(texture.mip_levels),
+	    VK_LOD_CLAMP_NONE, // The image view clamps, lets textures share samplers
 	    vk::BorderColor::eIntOpaqueBlack,
 	    VK_FALSE,
 	});
@@ -138,21 +195,21 @@ void BinaryLoader::create_sampler()
 	texture.descriptor_info.sampler = texture.sampler;
 }
 
-void BinaryLoader::stage_texture_data(u8 const *const pixels, vk::DeviceSize size)
-{
-	ZoneScoped;
-
-	memcpy(staging_buffer->map_block(0), pixels, size);
-	staging_buffer->unmap();
-}
-
-void BinaryLoader::write_texture_data_to_gpu()
+void BinaryLoader::upload_texture_data(
+    TextureLoader::BinaryTextureInfo const &info,
+    Texture &texture
+)
 {
 	ZoneScoped;
 
-	device->immediate_submit([&](vk::CommandBuffer cmd) {
-		auto const [width, height] = texture.size;
+	auto const [width, height] = texture.size;
+	assert_true(
+	    info.size >= static_cast<vk::DeviceSize>(width) * height * 4u,
+	    "Pixel-data of texture {} is smaller than its dimensions",
+	    info.debug_name
+	);
 
+	uploader.record([&texture](vk::CommandBuffer cmd) {
 		texture.transition_layout(
 		    cmd,
 		    0u,
@@ -160,28 +217,12 @@ void BinaryLoader::write_texture_data_to_gpu()
 		    1u,
 		    vk::ImageLayout::eTransferDstOptimal
 		);
+	});
 
+	uploader.copy_to_image(texture, 0u, 0u, info.pixels, width, height, { 1u, 1u, 4u });
 
-		cmd.copyBufferToImage(
-		    *staging_buffer->vk(),
-		    texture.image.vk(),
-		    vk::ImageLayout::eTransferDstOptimal,
-		    vk::BufferImageCopy {
-		        0u,
-		        0u,
-		        0u,
-		        vk::ImageSubresourceLayers {
-		            vk::ImageAspectFlagBits::eColor,
-		            0u,
-		            0u,
-		            1u,
-		        },
-		        vk::Offset3D { 0, 0, 0 },
-		        vk::Extent3D { width, height, 1u },
-		    }
-		);
-
-		create_mipmaps(cmd);
+	uploader.record([this, &texture](vk::CommandBuffer cmd) {
+		create_mipmaps(cmd, texture);
 
 		// @todo hacked
 		texture.current_layout = vk::ImageLayout::eTransferDstOptimal;
@@ -192,12 +233,12 @@ void BinaryLoader::write_texture_data_to_gpu()
 		    1u,
 		    vk::ImageLayout::eShaderReadOnlyOptimal
 		);
-	});
 
-	texture.descriptor_info.imageLayout = texture.current_layout;
+		texture.descriptor_info.imageLayout = texture.current_layout;
+	});
 }
 
-void BinaryLoader::create_mipmaps(vk::CommandBuffer cmd)
+void BinaryLoader::create_mipmaps(vk::CommandBuffer const cmd, Texture &texture)
 {
 	ZoneScoped;
 
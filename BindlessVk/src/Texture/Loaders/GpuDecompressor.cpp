@@ -0,0 +1,346 @@
+#include "BindlessVk/Texture/Loaders/GpuDecompressor.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+namespace {
+
+/** Has to match lz4_decompress.glsl's local_size_x */
+auto constexpr workgroup_size = u32 { 64 };
+
+} // namespace
+
+GpuDecompressor::GpuDecompressor(
+    VkContext const *const vk_context,
+    MemoryAllocator const *const memory_allocator,
+    LayoutAllocator *const layout_allocator,
+    Shader *const shader,
+    vk::DeviceSize const capacity
+)
+    : vk_context(vk_context)
+    , device(vk_context->get_device())
+    , memory_allocator(memory_allocator)
+{
+	ZoneScoped;
+
+	assert_true(
+	    shader->stage == vk::ShaderStageFlagBits::eCompute,
+	    "Gpu decompressor requires a compute shader"
+	);
+
+	auto const limits = vk_context->get_gpu()->vk().getProperties().limits;
+	storage_alignment = limits.minStorageBufferOffsetAlignment;
+
+	create_output_buffer(capacity);
+	create_descriptor_set(layout_allocator);
+	create_pipeline(layout_allocator, shader);
+}
+
+GpuDecompressor::~GpuDecompressor()
+{
+	ZoneScoped;
+
+	if (!device)
+		return;
+
+	device->vk().destroyDescriptorPool(descriptor_pool);
+}
+
+auto GpuDecompressor::can_decompress(
+    TextureUploader const &uploader,
+    usize const blob_size,
+    usize const chunk_count,
+    vk::DeviceSize const decompressed_size
+) const -> bool
+{
+	ZoneScoped;
+
+	// Mirrors decompress, which flushes first & stages the chunk table then the blob. Each is
+	// padded to whole words & the storage buffer alignment, the blob's allocation starts at the
+	// uploader's alignment after the chunk table's
+	auto const pad_storage = [this](vk::DeviceSize const size) {
+		return (size + 3u) / 4u * 4u + storage_alignment;
+	};
+
+	auto const uploader_alignment = uploader.get_alignment();
+	auto const chunks_size = pad_storage(chunk_count * sizeof(Assets::BlobChunk));
+	auto const staged_size = (chunks_size + uploader_alignment - 1u) / uploader_alignment
+	                             * uploader_alignment
+	                         + pad_storage(blob_size);
+
+	return device && staged_size <= uploader.get_capacity()
+	       && decompressed_size <= output_buffer.get_whole_size()
+	       && decompressed_size <= std::numeric_limits<u32>::max();
+}
+
+void GpuDecompressor::decompress(
+    TextureUploader &uploader,
+    u8 const *const blob,
+    usize const blob_size,
+    span<Assets::BlobChunk const> const chunks,
+    u32 const chunk_size,
+    vk::DeviceSize const decompressed_size
+)
+{
+	ZoneScoped;
+
+	assert_true(
+	    can_decompress(uploader, blob_size, chunks.size(), decompressed_size),
+	    "Blob doesn't fit in the gpu decompressor ({} -> {} bytes)",
+	    blob_size,
+	    decompressed_size
+	);
+
+	assert_false(chunk_size % 4u, "Chunk size ({}) has to be a multiple of 4", chunk_size);
+
+	// The descriptor set & output buffer may still be used by the recorded commands
+	uploader.flush();
+
+	auto const chunks_size = chunks.size_bytes();
+	auto const [chunks_map, chunks_offset] = allocate_storage(uploader, chunks_size);
+	memcpy(chunks_map, chunks.data(), chunks_size);
+
+	auto const [blob_map, blob_offset] = allocate_storage(uploader, blob_size);
+	memcpy(blob_map, blob, blob_size);
+
+	write_descriptor_set(
+	    *uploader.get_staging_buffer()->vk(),
+	    chunks_offset,
+	    chunks_size,
+	    blob_offset,
+	    blob_size,
+	    decompressed_size
+	);
+
+	auto const push_constants = PushConstants {
+		static_cast<u32>(chunks.size()),
+		chunk_size,
+		static_cast<u32>(decompressed_size),
+	};
+
+	uploader.record([this, push_constants](vk::CommandBuffer cmd) {
+		cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline.get_pipeline());
+		cmd.bindDescriptorSets(
+		    vk::PipelineBindPoint::eCompute,
+		    pipeline.get_pipeline_layout(),
+		    0u,
+		    descriptor_set,
+		    {}
+		);
+
+		pipeline.push_constants(cmd, push_constants);
+
+		cmd.dispatch((push_constants.chunk_count + workgroup_size - 1u) / workgroup_size, 1u, 1u);
+
+		cmd.pipelineBarrier(
+		    vk::PipelineStageFlagBits::eComputeShader,
+		    vk::PipelineStageFlagBits::eTransfer,
+		    {},
+		    vk::MemoryBarrier {
+		        vk::AccessFlagBits::eShaderWrite,
+		        vk::AccessFlagBits::eTransferRead,
+		    },
+		    {},
+		    {}
+		);
+	});
+}
+
+void GpuDecompressor::copy_to_image(
+    TextureUploader &uploader,
+    Texture &texture,
+    vec<vk::BufferImageCopy> &&regions
+) const
+{
+	ZoneScoped;
+
+	uploader.record([buffer = *output_buffer.vk(),
+	                 image = texture.image.vk(),
+	                 regions = std::move(regions)](vk::CommandBuffer cmd) {
+		cmd.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, regions);
+	});
+}
+
+void GpuDecompressor::copy_to_buffer(
+    TextureUploader &uploader,
+    vk::Buffer const buffer,
+    vec<vk::BufferCopy> &&regions
+) const
+{
+	ZoneScoped;
+
+	uploader.record([src_buffer = *output_buffer.vk(),
+	                 buffer,
+	                 regions = std::move(regions)](vk::CommandBuffer cmd) {
+		cmd.copyBuffer(src_buffer, buffer, regions);
+	});
+}
+
+auto GpuDecompressor::validate(TextureUploader &uploader, u8 const *const expected, usize const size)
+    -> bool
+{
+	ZoneScoped;
+
+	if (!readback_buffer.get_whole_size())
+	{
+		readback_buffer = Buffer {
+			vk_context,
+			memory_allocator,
+			vk::BufferUsageFlagBits::eTransferDst,
+			vma::AllocationCreateInfo {
+			    vma::AllocationCreateFlagBits::eHostAccessRandom,
+			    vma::MemoryUsage::eAutoPreferHost,
+			},
+			output_buffer.get_whole_size(),
+			1u,
+			"gpu_decompressor_readback",
+		};
+	}
+
+	copy_to_buffer(uploader, *readback_buffer.vk(), { vk::BufferCopy { 0u, 0u, size } });
+	uploader.flush();
+
+	auto const *const map = static_cast<u8 const *>(readback_buffer.map_block(0u));
+	auto const is_exact = !memcmp(map, expected, size);
+	readback_buffer.unmap();
+
+	return is_exact;
+}
+
+void GpuDecompressor::create_output_buffer(vk::DeviceSize const capacity)
+{
+	ZoneScoped;
+
+	output_buffer = Buffer {
+		vk_context,
+		memory_allocator,
+		vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc,
+		vma::AllocationCreateInfo {
+		    {},
+		    vma::MemoryUsage::eGpuOnly,
+		    vk::MemoryPropertyFlagBits::eDeviceLocal,
+		},
+		capacity,
+		1u,
+		"gpu_decompressor_output",
+	};
+}
+
+void GpuDecompressor::create_descriptor_set(LayoutAllocator *const layout_allocator)
+{
+	ZoneScoped;
+
+	auto const bindings = arr<vk::DescriptorSetLayoutBinding, 3> {
+		vk::DescriptorSetLayoutBinding {
+		    0u,
+		    vk::DescriptorType::eStorageBuffer,
+		    1u,
+		    vk::ShaderStageFlagBits::eCompute,
+		},
+		vk::DescriptorSetLayoutBinding {
+		    1u,
+		    vk::DescriptorType::eStorageBuffer,
+		    1u,
+		    vk::ShaderStageFlagBits::eCompute,
+		},
+		vk::DescriptorSetLayoutBinding {
+		    2u,
+		    vk::DescriptorType::eStorageBuffer,
+		    1u,
+		    vk::ShaderStageFlagBits::eCompute,
+		},
+	};
+
+	descriptor_set_layout = layout_allocator->goc_descriptor_set_layout({}, bindings, {});
+	device->set_object_name(descriptor_set_layout.vk(), "gpu_decompressor_descriptor_set_layout");
+
+	auto const pool_size = vk::DescriptorPoolSize {
+		vk::DescriptorType::eStorageBuffer,
+		static_cast<u32>(bindings.size()),
+	};
+
+	descriptor_pool = device->vk().createDescriptorPool({ {}, 1u, pool_size });
+	descriptor_set = device->vk().allocateDescriptorSets({
+	    descriptor_pool,
+	    descriptor_set_layout.vk(),
+	})[0];
+}
+
+void GpuDecompressor::create_pipeline(LayoutAllocator *const layout_allocator, Shader *const shader)
+{
+	ZoneScoped;
+
+	assert_true(
+	    shader->push_constant_range.size >= sizeof(PushConstants),
+	    "lz4_decompress push constant block is smaller than the decompressor's ({} < {})",
+	    shader->push_constant_range.size,
+	    sizeof(PushConstants)
+	);
+
+	// The storage buffers take the graph slot, set = 0, the push constant range is reflected
+	pipeline = ShaderPipeline {
+		vk_context,
+		layout_allocator,
+		ShaderPipeline::Type::eCompute,
+		{ shader },
+		ShaderPipeline::Configuration {},
+		descriptor_set_layout,
+		{},
+		"gpu_decompressor",
+	};
+}
+
+void GpuDecompressor::write_descriptor_set(
+    vk::Buffer const staging_buffer,
+    vk::DeviceSize const chunks_offset,
+    vk::DeviceSize const chunks_size,
+    vk::DeviceSize const blob_offset,
+    vk::DeviceSize const blob_size,
+    vk::DeviceSize const decompressed_size
+) const
+{
+	ZoneScoped;
+
+	// The shader reads & writes whole words
+	auto const round_up = [](vk::DeviceSize const size) {
+		return (size + 3u) / 4u * 4u;
+	};
+
+	auto const buffer_infos = arr<vk::DescriptorBufferInfo, 3> {
+		vk::DescriptorBufferInfo { staging_buffer, chunks_offset, chunks_size },
+		vk::DescriptorBufferInfo { staging_buffer, blob_offset, round_up(blob_size) },
+		vk::DescriptorBufferInfo { *output_buffer.vk(), 0u, round_up(decompressed_size) },
+	};
+
+	auto writes = arr<vk::WriteDescriptorSet, 3> {};
+	for (u32 binding = 0u; binding < writes.size(); ++binding)
+	{
+		writes[binding] = vk::WriteDescriptorSet {
+			descriptor_set,
+			binding,
+			0u,
+			1u,
+			vk::DescriptorType::eStorageBuffer,
+			{},
+			&buffer_infos[binding],
+		};
+	}
+
+	device->vk().updateDescriptorSets(writes, {});
+}
+
+auto GpuDecompressor::allocate_storage(TextureUploader &uploader, vk::DeviceSize const size) const
+    -> pair<u8 *, vk::DeviceSize>
+{
+	ZoneScoped;
+
+	// Padded to whole words & aligned to the storage buffer offset alignment
+	auto const padded_size = (size + 3u) / 4u * 4u;
+	auto const [map, offset] = uploader.allocate(padded_size + storage_alignment);
+
+	auto const aligned_offset = (offset + storage_alignment - 1u) / storage_alignment
+	                            * storage_alignment;
+
+	return { map + (aligned_offset - offset), aligned_offset };
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -2,9 +2,73 @@
 
 
 
-
 namespace BINDLESSVK_NAMESPACE {
 
+namespace {
+
+constexpr auto ktx1_identifier = arr<u8, 12> {
+	0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+constexpr auto ktx2_identifier = arr<u8, 12> {
+	0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A,
+};
+
+constexpr auto ktx1_endianness = u32 { 0x04030201 };
+constexpr auto gl_unsigned_byte = u32 { 0x1401 };
+constexpr auto gl_rgba = u32 { 0x1908 };
+constexpr auto gl_bgra = u32 { 0x80E1 };
+
+struct Ktx1Header
+{
+	arr<u8, 12> identifier;
+	u32 endianness;
+	u32 gl_type;
+	u32 gl_type_size;
+	u32 gl_format;
+	u32 gl_internal_format;
+	u32 gl_base_internal_format;
+	u32 pixel_width;
+	u32 pixel_height;
+	u32 pixel_depth;
+	u32 array_element_count;
+	u32 face_count;
+	u32 level_count;
+	u32 key_value_data_size;
+};
+
+struct Ktx2Header
+{
+	arr<u8, 12> identifier;
+	u32 vk_format;
+	u32 type_size;
+	u32 pixel_width;
+	u32 pixel_height;
+	u32 pixel_depth;
+	u32 layer_count;
+	u32 face_count;
+	u32 level_count;
+	u32 supercompression_scheme;
+	u32 dfd_offset;
+	u32 dfd_size;
+	u32 kvd_offset;
+	u32 kvd_size;
+	u64 sgd_offset;
+	u64 sgd_size;
+};
+
+struct Ktx2Level
+{
+	u64 offset;
+	u64 size;
+	u64 uncompressed_size;
+};
+
+static_assert(sizeof(Ktx1Header) == 64);
+static_assert(sizeof(Ktx2Header) == 80);
+
+} // namespace
+
 KtxLoader::KtxLoader(
     VkContext const *const vk_context,
     MemoryAllocator const *const memory_allocator,
@@ -12,12 +76,14 @@ KtxLoader::KtxLoader(
 )
     : device(vk_context->get_device())
     , memory_allocator(memory_allocator)
-    , staging_buffer(staging_buffer)
+    , sampler_cache(vk_context->get_sampler_cache())
+    , uploader(vk_context, staging_buffer)
 {
 	ZoneScoped;
 
 	texture.device = vk_context->get_device();
 	texture.memory_allocator = memory_allocator;
+	texture.sampler_cache = sampler_cache;
 }
 
 Texture KtxLoader::load(
@@ -30,20 +96,143 @@ Texture KtxLoader::load(
 	ZoneScoped;
 
 	texture.debug_name = debug_name;
-	load_ktx_texture(path);
+
+	if (!map_ktx_file(path))
+		load_ktx_texture(path);
 
 	create_image();
 	create_image_view();
 	create_sampler();
 
-	stage_texture_data();
-	write_texture_data_to_gpu(final_layout);
+	upload_texture_data(final_layout);
 
 	destroy_ktx_texture();
 
 	return std::move(texture);
 }
 
+auto KtxLoader::map_ktx_file(str_view const path) -> bool
+{
+	ZoneScoped;
+
+	if (!ktx_file.open(str(path).c_str()))
+		return false;
+
+	if (parse_ktx1_file() || parse_ktx2_file())
+	{
+		image_data = ktx_file.data();
+		return true;
+	}
+
+	log_dbg("Ktx file {} needs transcoding, loading it through libktx", path);
+
+	images.clear();
+	ktx_file.close();
+	return false;
+}
+
+auto KtxLoader::parse_ktx1_file() -> bool
+{
+	ZoneScoped;
+
+	auto header = Ktx1Header {};
+	if (ktx_file.size() < sizeof(Ktx1Header))
+		return false;
+
+	memcpy(&header, ktx_file.data(), sizeof(Ktx1Header));
+
+	// Only un-swapped, uncompressed 32-bit texels of non-array cubemaps can be copied as-is
+	if (header.identifier != ktx1_identifier || header.endianness != ktx1_endianness
+	    || header.gl_type != gl_unsigned_byte
+	    || (header.gl_format != gl_rgba && header.gl_format != gl_bgra) || header.pixel_depth
+	    || header.array_element_count || header.face_count != 6u)
+		return false;
+
+	texture.size = { header.pixel_width, header.pixel_height };
+	texture.format = vk::Format::eB8G8R8A8Srgb;
+	texture.mip_levels = std::max(header.level_count, 1u);
+	texture.device_size = 0u;
+	texture.current_layout = vk::ImageLayout::eUndefined;
+
+	auto offset = sizeof(Ktx1Header) + header.key_value_data_size;
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		auto image_size = u32 {};
+		if (offset + sizeof(u32) > ktx_file.size())
+			return false;
+
+		memcpy(&image_size, ktx_file.data() + offset, sizeof(u32));
+		offset += sizeof(u32);
+
+		auto const expected_size = std::max(header.pixel_width >> level, 1u)
+		                           * std::max(header.pixel_height >> level, 1u) * 4u;
+
+		if (image_size != expected_size || offset + image_size * 6u > ktx_file.size())
+			return false;
+
+		// 32-bit texels keep every face & level 4-byte aligned, so there's no padding
+		for (u32 face = 0u; face < 6u; ++face, offset += image_size)
+			images.push_back({ level, face, offset });
+
+		texture.device_size += image_size * 6u;
+	}
+
+	return true;
+}
+
+auto KtxLoader::parse_ktx2_file() -> bool
+{
+	ZoneScoped;
+
+	auto header = Ktx2Header {};
+	if (ktx_file.size() < sizeof(Ktx2Header))
+		return false;
+
+	memcpy(&header, ktx_file.data(), sizeof(Ktx2Header));
+
+	auto const format = static_cast<vk::Format>(header.vk_format);
+	auto const has_32bit_texels = format == vk::Format::eR8G8B8A8Unorm
+	                              || format == vk::Format::eR8G8B8A8Srgb
+	                              || format == vk::Format::eB8G8R8A8Unorm
+	                              || format == vk::Format::eB8G8R8A8Srgb;
+
+	if (header.identifier != ktx2_identifier || !has_32bit_texels
+	    || header.supercompression_scheme || header.pixel_depth || header.layer_count
+	    || header.face_count != 6u)
+		return false;
+
+	texture.size = { header.pixel_width, header.pixel_height };
+	texture.format = format;
+	texture.mip_levels = std::max(header.level_count, 1u);
+	texture.device_size = 0u;
+	texture.current_layout = vk::ImageLayout::eUndefined;
+
+	auto const level_index_size = texture.mip_levels * sizeof(Ktx2Level);
+	if (sizeof(Ktx2Header) + level_index_size > ktx_file.size())
+		return false;
+
+	auto const *const level_index = ktx_file.data() + sizeof(Ktx2Header);
+	for (u32 level = 0u; level < texture.mip_levels; ++level)
+	{
+		auto level_info = Ktx2Level {};
+		memcpy(&level_info, level_index + level * sizeof(Ktx2Level), sizeof(Ktx2Level));
+
+		auto const face_size = std::max(header.pixel_width >> level, 1u)
+		                       * std::max(header.pixel_height >> level, 1u) * 4ull;
+
+		if (level_info.size != face_size * 6u
+		    || level_info.offset + level_info.size > ktx_file.size())
+			return false;
+
+		for (u32 face = 0u; face < 6u; ++face)
+			images.push_back({ level, face, level_info.offset + face * face_size });
+
+		texture.device_size += level_info.size;
+	}
+
+	return true;
+}
+
 void KtxLoader::load_ktx_texture(str_view const path)
 {
 	ZoneScoped;
@@ -64,13 +253,32 @@ void KtxLoader::load_ktx_texture(str_view const path)
 	texture.mip_levels = ktx_texture->numLevels;
 	texture.device_size = ktxTexture_GetSize(ktx_texture);
 	texture.current_layout = vk::ImageLayout::eUndefined;
+
+	image_data = ktxTexture_GetData(ktx_texture);
+
+	for (u32 face = 0u; face < 6u; ++face)
+	{
+		for (u32 level = 0u; level < texture.mip_levels; ++level)
+		{
+			usize offset;
+			assert_false(
+			    ktxTexture_GetImageOffset(ktx_texture, level, 0u, face, &offset),
+			    "Failed to get ktx image offset"
+			);
+
+			images.push_back({ level, face, offset });
+		}
+	}
 }
 
 void KtxLoader::destroy_ktx_texture()
 {
 	ZoneScoped;
 
-	ktxTexture_Destroy(ktx_texture);
+	if (ktx_texture)
+		ktxTexture_Destroy(ktx_texture);
+
+	ktx_file.close();
 }
 
 void KtxLoader::create_image()
@@ -140,7 +348,7 @@ void KtxLoader::create_sampler()
 {
 	ZoneScoped;
 
-	texture.sampler = device->vk().createSampler(vk::SamplerCreateInfo {
+	texture.sampler = sampler_cache->acquire(vk::SamplerCreateInfo {
 	    {},
 	    vk::Filter::eLinear,
 	    vk::Filter::eLinear,
@@ -154,30 +362,18 @@ void KtxLoader::create_sampler()
 	    VK_FALSE,
 	    vk::CompareOp::eNever,
 	    0.0f,
-	    static_cast<float>(texture.mip_levels),
+	    VK_LOD_CLAMP_NONE, // The image view clamps, lets textures share samplers
 	    vk::BorderColor::eFloatOpaqueWhite,
 	    VK_FALSE,
 	});
 	texture.descriptor_info.sampler = texture.sampler;
 }
 
-void KtxLoader::stage_texture_data()
+void KtxLoader::upload_texture_data(vk::ImageLayout const final_layout)
 {
 	ZoneScoped;
 
-	auto const *const src = ktxTexture_GetData(ktx_texture);
-	auto *const dst = staging_buffer->map_block(0);
-	memcpy(dst, reinterpret_cast<void const *>(src), texture.device_size);
-	staging_buffer->unmap();
-}
-
-void KtxLoader::write_texture_data_to_gpu(vk::ImageLayout const final_layout)
-{
-	ZoneScoped;
-
-	auto const buffer_copies = create_texture_face_buffer_copies();
-
-	device->immediate_submit([&](vk::CommandBuffer &&cmd) {
+	uploader.record([&](vk::CommandBuffer cmd) {
 		texture.transition_layout(
 		    cmd,
 		    0u,
@@ -185,60 +381,30 @@ void KtxLoader::write_texture_data_to_gpu(vk::ImageLayout const final_layout)
 		    6u,
 		    vk::ImageLayout::eTransferDstOptimal
 		);
-
-		cmd.copyBufferToImage(
-		    *staging_buffer->vk(),
-		    texture.image.vk(),
-		    vk::ImageLayout::eTransferDstOptimal,
-		    static_cast<u32>(buffer_copies.size()),
-		    buffer_copies.data()
-		);
-
-		texture.transition_layout(cmd, 0u, texture.mip_levels, 6u, final_layout);
 	});
 
-	texture.descriptor_info.imageLayout = texture.current_layout;
-}
-
-vec<vk::BufferImageCopy> KtxLoader::create_texture_face_buffer_copies()
-{
-	ZoneScoped;
-
 	auto const [width, height] = texture.size;
 
-	auto buffer_copies = vec<vk::BufferImageCopy> {};
-
-	for (u32 face = 0u; face < 6u; ++face)
+	// Mapped ktx files are copied from the page cache straight into staging
+	for (auto const &image : images)
 	{
-		for (u32 level = 0u; level < texture.mip_levels; ++level)
-		{
-			usize offset;
-			assert_false(
-			    ktxTexture_GetImageOffset(ktx_texture, level, 0u, face, &offset),
-			    "Failed to get ktx image offset"
-			);
-
-			buffer_copies.emplace_back(vk::BufferImageCopy {
-			    offset,
-			    {},
-			    {},
-			    {
-			        vk::ImageAspectFlagBits::eColor,
-			        level,
-			        face,
-			        1u,
-			    },
-			    {},
-			    {
-			        width >> level,
-			        height >> level,
-			        1u,
-			    },
-			});
-		}
+		uploader.copy_to_image(
+		    texture,
+		    image.level,
+		    image.face,
+		    image_data + image.offset,
+		    std::max(width >> image.level, 1u),
+		    std::max(height >> image.level, 1u),
+		    { 1u, 1u, 4u }
+		);
 	}
 
-	return buffer_copies;
+	uploader.record([&](vk::CommandBuffer cmd) {
+		texture.transition_layout(cmd, 0u, texture.mip_levels, 6u, final_layout);
+	});
+
+	uploader.flush();
+	texture.descriptor_info.imageLayout = texture.current_layout;
 }
 
 } // namespace BINDLESSVK_NAMESPACE
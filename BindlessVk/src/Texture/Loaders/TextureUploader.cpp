@@ -0,0 +1,176 @@
+#include "BindlessVk/Texture/Loaders/TextureUploader.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+auto get_texel_block(vk::Format const format) -> TexelBlock
+{
+	switch (format)
+	{
+	case vk::Format::eR8G8B8A8Unorm:
+	case vk::Format::eR8G8B8A8Srgb:
+	case vk::Format::eB8G8R8A8Unorm:
+	case vk::Format::eB8G8R8A8Srgb: return { 1u, 1u, 4u };
+
+	case vk::Format::eBc1RgbUnormBlock:
+	case vk::Format::eBc1RgbSrgbBlock: return { 4u, 4u, 8u };
+
+	case vk::Format::eBc5UnormBlock:
+	case vk::Format::eBc7UnormBlock:
+	case vk::Format::eBc7SrgbBlock: return { 4u, 4u, 16u };
+
+	default: assert_fail("Unsupported texture format: {}", static_cast<i32>(format));
+	}
+
+	return {};
+}
+
+TextureUploader::TextureUploader(VkContext const *const vk_context, Buffer *const staging_buffer)
+    : device(vk_context->get_device())
+    , staging_buffer(staging_buffer)
+{
+	ZoneScoped;
+
+	auto const limits = vk_context->get_gpu()->vk().getProperties().limits;
+
+	// Buffer offsets of image copies need to be a multiple of the texel block size(at most 16)
+	alignment = std::max<vk::DeviceSize>(limits.optimalBufferCopyOffsetAlignment, 16u);
+}
+
+TextureUploader::~TextureUploader()
+{
+	ZoneScoped;
+
+	if (map)
+		staging_buffer->unmap();
+}
+
+void TextureUploader::record(fn<void(vk::CommandBuffer)> &&func)
+{
+	ZoneScoped;
+
+	commands.push_back(std::move(func));
+}
+
+auto TextureUploader::allocate(vk::DeviceSize const size) -> pair<u8 *, vk::DeviceSize>
+{
+	ZoneScoped;
+
+	assert_true(
+	    size <= get_capacity(),
+	    "Staging allocation doesn't fit in the staging buffer ({} > {})",
+	    size,
+	    get_capacity()
+	);
+
+	auto region_offset = align_offset(offset);
+	if (region_offset + size > get_capacity())
+	{
+		flush();
+		region_offset = 0u;
+	}
+
+	if (!map)
+		map = static_cast<u8 *>(staging_buffer->map_block(0));
+
+	offset = region_offset + size;
+	return { map + region_offset, region_offset };
+}
+
+void TextureUploader::copy_staged_to_image(Texture &texture, vec<vk::BufferImageCopy> &&regions)
+{
+	ZoneScoped;
+
+	record([buffer = *staging_buffer->vk(),
+	        image = texture.image.vk(),
+	        regions = std::move(regions)](vk::CommandBuffer cmd) {
+		cmd.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, regions);
+	});
+}
+
+void TextureUploader::copy_to_image(
+    Texture &texture,
+    u32 const mip_level,
+    u32 const layer,
+    u8 const *const data,
+    u32 const width,
+    u32 const height,
+    TexelBlock const block
+)
+{
+	ZoneScoped;
+
+	auto const blocks_per_row = (width + block.width - 1u) / block.width;
+	auto const block_rows = (height + block.height - 1u) / block.height;
+	auto const row_size = static_cast<vk::DeviceSize>(blocks_per_row) * block.size;
+
+	assert_true(
+	    row_size <= get_capacity(),
+	    "A single row of texture {} doesn't fit in the staging buffer",
+	    texture.debug_name
+	);
+
+	for (u32 row = 0u; row < block_rows;)
+	{
+		// Flush when not even a single row fits in the remaining space
+		if (align_offset(offset) + row_size > get_capacity())
+			flush();
+
+		auto const free_rows = (get_capacity() - align_offset(offset)) / row_size;
+		auto const chunk_rows = std::min<u32>(block_rows - row, static_cast<u32>(free_rows));
+		auto const chunk_size = chunk_rows * row_size;
+
+		auto const [chunk_map, chunk_offset] = allocate(chunk_size);
+		memcpy(chunk_map, data + row * row_size, chunk_size);
+
+		auto const y = row * block.height;
+		copy_staged_to_image(
+		    texture,
+		    {
+		        vk::BufferImageCopy {
+		            chunk_offset,
+		            0u,
+		            0u,
+		            vk::ImageSubresourceLayers {
+		                vk::ImageAspectFlagBits::eColor,
+		                mip_level,
+		                layer,
+		                1u,
+		            },
+		            vk::Offset3D { 0, static_cast<i32>(y), 0 },
+		            vk::Extent3D { width, std::min(chunk_rows * block.height, height - y), 1u },
+		        },
+		    }
+		);
+
+		row += chunk_rows;
+	}
+}
+
+void TextureUploader::flush()
+{
+	ZoneScoped;
+
+	if (map)
+	{
+		staging_buffer->unmap();
+		map = {};
+	}
+
+	if (!commands.empty())
+	{
+		device->immediate_submit([&](vk::CommandBuffer cmd) {
+			for (auto &command : commands)
+				command(cmd);
+		});
+	}
+
+	commands.clear();
+	offset = 0u;
+}
+
+auto TextureUploader::align_offset(vk::DeviceSize const unaligned_offset) const -> vk::DeviceSize
+{
+	return (unaligned_offset + alignment - 1u) / alignment * alignment;
+}
+
+} // namespace BINDLESSVK_NAMESPACE
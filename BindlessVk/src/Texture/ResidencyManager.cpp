@@ -0,0 +1,885 @@
+#include "BindlessVk/Texture/ResidencyManager.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+namespace {
+
+/** Levels at or below this extent never get paged out */
+auto constexpr tail_extent = u32 { 64 };
+
+/** Bounds the number of rebuilds caused by page-in requests per update */
+auto constexpr max_page_ins_per_update = usize { 4 };
+
+/** Descriptor index of streamed textures that haven't been registered yet */
+auto constexpr unassigned_descriptor_index = std::numeric_limits<u32>::max();
+
+} // namespace
+
+ResidencyManager::ResidencyManager(
+    VkContext const *const vk_context,
+    MemoryAllocator const *const memory_allocator,
+    vk::DeviceSize const budget
+)
+    : vk_context(vk_context)
+    , device(vk_context->get_device())
+    , memory_allocator(memory_allocator)
+    , budget(budget)
+    , streamer(std::make_unique<TextureStreamer>(std::thread::hardware_concurrency() / 2u))
+{
+	ZoneScoped;
+
+	command_pool = device->vk().createCommandPool(vk::CommandPoolCreateInfo {
+	    vk::CommandPoolCreateFlagBits::eTransient,
+	    vk_context->get_gpu()->get_graphics_queue_index(),
+	});
+}
+
+ResidencyManager::~ResidencyManager()
+{
+	ZoneScoped;
+
+	if (!device)
+		return;
+
+	// Submitted batches still use the images & buffers destroyed along with the manager
+	for (auto const &batch : submitted_batches)
+	{
+		assert_false(device->vk().waitForFences(
+		    batch.fence,
+		    true,
+		    std::numeric_limits<u64>::max()
+		));
+
+		device->vk().destroyFence(batch.fence);
+	}
+
+	device->vk().destroyCommandPool(command_pool);
+
+	for (auto const &retired : retired_images)
+		device->vk().destroyImageView(retired.image_view);
+}
+
+void ResidencyManager::register_texture(Texture *const texture, u32 const descriptor_index)
+{
+	ZoneScoped;
+
+	if (auto const it = descriptor_indices.find(descriptor_index); it != descriptor_indices.end())
+	{
+		assert_true(
+		    textures[it->second].texture == texture,
+		    "Descriptor index {} is already managed for texture {}",
+		    descriptor_index,
+		    textures[it->second].texture->get_name()
+		);
+
+		return;
+	}
+
+	// Streamed textures are managed before they're given a descriptor index
+	if (auto const texture_it = texture_indices.find(texture); texture_it != texture_indices.end())
+	{
+		auto &resident = textures[texture_it->second];
+		assert_true(
+		    resident.descriptor_index == unassigned_descriptor_index,
+		    "Texture {} is already managed with descriptor index {}",
+		    texture->get_name(),
+		    resident.descriptor_index
+		);
+
+		resident.descriptor_index = descriptor_index;
+		descriptor_indices[descriptor_index] = texture_it->second;
+
+		for (auto &writes : pending_writes)
+			writes.push_back(descriptor_index);
+
+		return;
+	}
+
+	add_texture(texture, descriptor_index, texture->size, texture->mip_levels);
+}
+
+void ResidencyManager::stream_texture(
+    Texture *const texture,
+    pair<u32, u32> const full_size,
+    TextureStreamer::LevelLoader &&load_levels
+)
+{
+	ZoneScoped;
+
+	assert_false(
+	    texture_indices.contains(texture),
+	    "Texture {} is already managed",
+	    texture->get_name()
+	);
+
+	auto const full_mip_levels = static_cast<u32>(
+	    std::bit_width(std::max(full_size.first, full_size.second))
+	);
+
+	assert_true(
+	    texture->mip_levels <= full_mip_levels,
+	    "Texture {} has more placeholder levels ({}) than its full chain ({})",
+	    texture->get_name(),
+	    texture->mip_levels,
+	    full_mip_levels
+	);
+
+	auto &resident = add_texture(texture, unassigned_descriptor_index, full_size, full_mip_levels);
+	resident.is_loading = true;
+	resident.is_placeholder = true;
+
+	streamer->push(textures.size() - 1u, std::move(load_levels));
+}
+
+auto ResidencyManager::add_texture(
+    Texture *const texture,
+    u32 const descriptor_index,
+    pair<u32, u32> const full_size,
+    u32 const full_mip_levels
+) -> ResidentTexture &
+{
+	ZoneScoped;
+
+	assert_true(
+	    texture->current_layout == vk::ImageLayout::eShaderReadOnlyOptimal,
+	    "Texture {} has to be in shader read only layout to be managed",
+	    texture->get_name()
+	);
+
+	auto const [width, height] = full_size;
+	auto const extent = std::max(width, height);
+
+	// Finest level that fits in tail_extent
+	auto const tail_mip = static_cast<u32>(
+	    std::max(std::bit_width(extent - 1u) - std::bit_width(tail_extent - 1u), 0)
+	);
+
+	// The texture's levels are the coarsest of the full chain
+	auto const resident_mip = full_mip_levels - texture->mip_levels;
+
+	auto &resident = textures.emplace_back(ResidentTexture {
+	    texture,
+	    descriptor_index,
+	    full_size,
+	    full_mip_levels,
+	    get_texel_block(texture->format),
+	    resident_mip,
+	    std::min(tail_mip, full_mip_levels - 1u),
+	    resident_mip,
+	    frame_counter,
+	    vec<vec<u8>>(full_mip_levels),
+	    false,
+	    false,
+	    false,
+	    false,
+	});
+
+	texture_indices[texture] = textures.size() - 1u;
+	if (descriptor_index != unassigned_descriptor_index)
+		descriptor_indices[descriptor_index] = textures.size() - 1u;
+
+	resident_size += calculate_chain_size(resident, resident_mip);
+	return resident;
+}
+
+void ResidencyManager::update(
+    u32 const frame_index,
+    span<Feedback> const feedback,
+    vk::DescriptorSet const descriptor_set,
+    u32 const binding
+)
+{
+	ZoneScoped;
+
+	++frame_counter;
+
+	destroy_retired_images();
+	retire_executed_batches();
+	receive_streamed_levels();
+	consume_feedback(feedback);
+	enforce_budget();
+	submit_recording_batch();
+
+	write_descriptors(frame_index, descriptor_set, binding);
+}
+
+void ResidencyManager::destroy_retired_images()
+{
+	ZoneScoped;
+
+	// Retired images are referenced by the frame sets until they're re-written, and then by the
+	// frames that were already recorded. The batch copying out of them was submitted ahead of
+	// those frames, so it has executed by then as well
+	std::erase_if(retired_images, [this](RetiredImage const &retired) {
+		if (frame_counter < retired.frame + 2u * max_frames_in_flight)
+			return false;
+
+		device->vk().destroyImageView(retired.image_view);
+		return true;
+	});
+}
+
+void ResidencyManager::retire_executed_batches()
+{
+	ZoneScoped;
+
+	// Fences are only polled, batches that are still executing are retired by a later update
+	std::erase_if(submitted_batches, [this](PagingBatch &batch) {
+		if (device->vk().getFenceStatus(batch.fence) != vk::Result::eSuccess)
+			return false;
+
+		for (auto &readback : batch.readbacks)
+			read_back_levels(readback);
+
+		for (auto const index : batch.paged_indices)
+			textures[index].is_paging = false;
+
+		device->vk().freeCommandBuffers(command_pool, batch.cmd);
+		device->vk().destroyFence(batch.fence);
+		return true;
+	});
+}
+
+void ResidencyManager::receive_streamed_levels()
+{
+	ZoneScoped;
+
+	for (auto &[index, levels] : streamer->pop_finished())
+	{
+		auto &resident = textures[index];
+
+		// The levels failed to load, eg. an image that doesn't decode. The texture stays on its
+		// placeholder & loading, so it's never paged in against levels it doesn't have
+		if (levels.empty())
+		{
+			log_wrn(
+			    "Failed to stream texture {}, keeping its placeholder",
+			    resident.texture->get_name()
+			);
+
+			continue;
+		}
+
+		assert_true(
+		    levels.size() == resident.full_mip_levels,
+		    "Streamed {} levels for texture {}, expected {}",
+		    levels.size(),
+		    resident.texture->get_name(),
+		    resident.full_mip_levels
+		);
+
+		for (u32 level = 0u; level < resident.full_mip_levels; ++level)
+		{
+			assert_true(
+			    levels[level].size() == calculate_level_size(resident, level),
+			    "Streamed level {} of texture {} has a mismatching size",
+			    level,
+			    resident.texture->get_name()
+			);
+
+			resident.paged_out_levels[level] = std::move(levels[level]);
+		}
+
+		resident.is_loading = false;
+		resident.is_streaming = true;
+	}
+}
+
+void ResidencyManager::consume_feedback(span<Feedback> const feedback)
+{
+	ZoneScoped;
+
+	for (auto &resident : textures)
+	{
+		if (resident.descriptor_index == unassigned_descriptor_index)
+			continue;
+
+		assert_true(
+		    resident.descriptor_index < feedback.size(),
+		    "Feedback buffer is too small for descriptor index {}",
+		    resident.descriptor_index
+		);
+
+		auto const value = feedback[resident.descriptor_index];
+		if (!value)
+			continue;
+
+		auto const full_width_log2 = static_cast<u32>(std::bit_width(resident.full_size.first)) - 1u;
+		auto const needed_width_log2 = value - 1u;
+
+		resident.requested_mip = std::min(
+		    needed_width_log2 < full_width_log2 ? full_width_log2 - needed_width_log2 : 0u,
+		    resident.tail_mip
+		);
+
+		resident.last_requested_frame = frame_counter;
+	}
+
+	std::ranges::fill(feedback, Feedback {});
+}
+
+void ResidencyManager::enforce_budget()
+{
+	ZoneScoped;
+
+	for (auto const [index, target_mip, is_refinement] : collect_page_in_requests())
+	{
+		auto &resident = textures[index];
+		auto const resident_chain_size = calculate_chain_size(resident, resident.resident_mip);
+
+		if (is_refinement)
+		{
+			if (resident_size + calculate_chain_size(resident, target_mip) - resident_chain_size
+			    <= budget)
+				page_texture(index, target_mip);
+			else
+				resident.is_streaming = false;
+
+			continue;
+		}
+
+		// Placeholders get replaced even if nothing finer fits
+		auto const last_mip = resident.is_placeholder ? resident.resident_mip + 1u :
+		                                                resident.resident_mip;
+
+		// Page in as much of the request as the budget allows
+		for (auto mip = target_mip; mip < last_mip; ++mip)
+		{
+			if (make_room(calculate_chain_size(resident, mip) - resident_chain_size, index))
+			{
+				page_texture(index, mip);
+				break;
+			}
+		}
+	}
+
+	// The budget may have been lowered
+	make_room(0u, textures.size());
+}
+
+auto ResidencyManager::collect_page_in_requests() const -> vec<PageInRequest>
+{
+	ZoneScoped;
+
+	auto requests = vec<PageInRequest> {};
+	for (usize i = 0u; i < textures.size(); ++i)
+	{
+		auto const &resident = textures[i];
+		if (resident.is_loading || resident.is_paging)
+			continue;
+
+		if (resident.is_placeholder)
+			requests.push_back({ i, std::min(resident.tail_mip, resident.resident_mip), false });
+
+		else if (resident.last_requested_frame == frame_counter
+		         && resident.requested_mip < resident.resident_mip)
+			requests.push_back({ i, resident.requested_mip, false });
+
+		// Streamed levels are brought in one by one, coarsest first
+		else if (resident.is_streaming && resident.resident_mip > 0u)
+			requests.push_back({ i, resident.resident_mip - 1u, true });
+	}
+
+	// Placeholders go first, then the textures missing the most detail
+	std::ranges::sort(requests, [this](PageInRequest const &lhs, PageInRequest const &rhs) {
+		auto const &lhs_resident = textures[lhs.index];
+		auto const &rhs_resident = textures[rhs.index];
+
+		if (lhs_resident.is_placeholder != rhs_resident.is_placeholder)
+			return lhs_resident.is_placeholder;
+
+		return lhs_resident.resident_mip - lhs.mip > rhs_resident.resident_mip - rhs.mip;
+	});
+
+	if (requests.size() > max_page_ins_per_update)
+		requests.resize(max_page_ins_per_update);
+
+	return requests;
+}
+
+auto ResidencyManager::make_room(vk::DeviceSize const size, usize const requester_index) -> bool
+{
+	ZoneScoped;
+
+	if (resident_size + size <= budget)
+		return true;
+
+	// Textures requested this frame only give up the levels finer than what they've requested
+	auto const get_floor_mip = [this](ResidentTexture const &resident) {
+		return resident.last_requested_frame == frame_counter ? resident.requested_mip :
+		                                                        resident.tail_mip;
+	};
+
+	// Textures paged by a batch that hasn't executed yet don't have their host levels back
+	auto candidates = vec<usize> {};
+	for (usize i = 0u; i < textures.size(); ++i)
+		if (i != requester_index && !textures[i].is_paging
+		    && textures[i].resident_mip < get_floor_mip(textures[i]))
+			candidates.push_back(i);
+
+	std::ranges::sort(candidates, [this](usize const lhs, usize const rhs) {
+		return textures[lhs].last_requested_frame < textures[rhs].last_requested_frame;
+	});
+
+	for (auto const index : candidates)
+	{
+		auto &resident = textures[index];
+		auto const floor_mip = get_floor_mip(resident);
+
+		auto mip = resident.resident_mip;
+		auto freed_size = vk::DeviceSize {};
+
+		while (mip < floor_mip && resident_size - freed_size + size > budget)
+			freed_size += calculate_level_size(resident, mip++);
+
+		page_texture(index, mip);
+
+		if (resident_size + size <= budget)
+			return true;
+	}
+
+	return false;
+}
+
+void ResidencyManager::page_texture(usize const index, u32 const mip)
+{
+	ZoneScoped;
+
+	auto &resident = textures[index];
+	if (mip == resident.resident_mip && !resident.is_placeholder)
+		return;
+
+	auto &batch = get_recording_batch();
+	auto const cmd = batch.cmd;
+
+	auto &texture = *resident.texture;
+	auto const old_mip = resident.resident_mip;
+	auto const old_level_count = resident.full_mip_levels - old_mip;
+	auto const new_level_count = resident.full_mip_levels - mip;
+
+	auto old_image = std::move(texture.image);
+	auto const old_image_view = texture.image_view;
+
+	texture.image = create_image(resident, mip);
+	texture.image_view = create_image_view(resident, texture.image.vk(), mip);
+
+	// Levels that are in both images are copied on the gpu, placeholder levels are replaced
+	auto image_copies = vec<vk::ImageCopy> {};
+	auto const first_copied_level = resident.is_placeholder ? resident.full_mip_levels :
+	                                                          std::max(mip, old_mip);
+
+	for (auto level = first_copied_level; level < resident.full_mip_levels; ++level)
+	{
+		image_copies.push_back(vk::ImageCopy {
+		    vk::ImageSubresourceLayers { vk::ImageAspectFlagBits::eColor, level - old_mip, 0u, 1u },
+		    vk::Offset3D { 0, 0, 0 },
+		    vk::ImageSubresourceLayers { vk::ImageAspectFlagBits::eColor, level - mip, 0u, 1u },
+		    vk::Offset3D { 0, 0, 0 },
+		    calculate_level_extent(resident, level),
+		});
+	}
+
+	// The old image is sampled by frames in flight, it's handed back in shader read only layout
+	cmd.pipelineBarrier(
+	    vk::PipelineStageFlagBits::eFragmentShader,
+	    vk::PipelineStageFlagBits::eTransfer,
+	    {},
+	    {},
+	    {},
+	    arr<vk::ImageMemoryBarrier, 2> {
+	        vk::ImageMemoryBarrier {
+	            vk::AccessFlagBits::eShaderRead,
+	            vk::AccessFlagBits::eTransferRead,
+	            vk::ImageLayout::eShaderReadOnlyOptimal,
+	            vk::ImageLayout::eTransferSrcOptimal,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            old_image.vk(),
+	            { vk::ImageAspectFlagBits::eColor, 0u, old_level_count, 0u, 1u },
+	        },
+	        vk::ImageMemoryBarrier {
+	            {},
+	            vk::AccessFlagBits::eTransferWrite,
+	            vk::ImageLayout::eUndefined,
+	            vk::ImageLayout::eTransferDstOptimal,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            texture.image.vk(),
+	            { vk::ImageAspectFlagBits::eColor, 0u, new_level_count, 0u, 1u },
+	        },
+	    }
+	);
+
+	// Levels that are paged out are read back to host memory once the batch has executed
+	if (mip > old_mip)
+	{
+		auto &readback = batch.readbacks.emplace_back(PendingReadback {
+		    index,
+		    old_mip,
+		    mip,
+		    create_readback_buffer(resident, old_mip, mip),
+		});
+
+		cmd.copyImageToBuffer(
+		    old_image.vk(),
+		    vk::ImageLayout::eTransferSrcOptimal,
+		    *readback.buffer.vk(),
+		    create_level_copies(resident, old_mip, mip)
+		);
+	}
+
+	if (!image_copies.empty())
+		cmd.copyImage(
+		    old_image.vk(),
+		    vk::ImageLayout::eTransferSrcOptimal,
+		    texture.image.vk(),
+		    vk::ImageLayout::eTransferDstOptimal,
+		    image_copies
+		);
+
+	// Levels that are paged in are staged right away, their host copies are no longer needed
+	if (mip < first_copied_level)
+	{
+		auto const &staging_buffer = batch.staging_buffers.emplace_back(
+		    create_staging_buffer(resident, mip, first_copied_level)
+		);
+
+		cmd.copyBufferToImage(
+		    *staging_buffer.vk(),
+		    texture.image.vk(),
+		    vk::ImageLayout::eTransferDstOptimal,
+		    create_level_copies(resident, mip, first_copied_level)
+		);
+
+		for (auto level = mip; level < first_copied_level; ++level)
+			resident.paged_out_levels[level] = {};
+	}
+
+	cmd.pipelineBarrier(
+	    vk::PipelineStageFlagBits::eTransfer,
+	    vk::PipelineStageFlagBits::eFragmentShader,
+	    {},
+	    {},
+	    {},
+	    arr<vk::ImageMemoryBarrier, 2> {
+	        vk::ImageMemoryBarrier {
+	            vk::AccessFlagBits::eTransferRead,
+	            vk::AccessFlagBits::eShaderRead,
+	            vk::ImageLayout::eTransferSrcOptimal,
+	            vk::ImageLayout::eShaderReadOnlyOptimal,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            old_image.vk(),
+	            { vk::ImageAspectFlagBits::eColor, 0u, old_level_count, 0u, 1u },
+	        },
+	        vk::ImageMemoryBarrier {
+	            vk::AccessFlagBits::eTransferWrite,
+	            vk::AccessFlagBits::eShaderRead,
+	            vk::ImageLayout::eTransferDstOptimal,
+	            vk::ImageLayout::eShaderReadOnlyOptimal,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            VK_QUEUE_FAMILY_IGNORED,
+	            texture.image.vk(),
+	            { vk::ImageAspectFlagBits::eColor, 0u, new_level_count, 0u, 1u },
+	        },
+	    }
+	);
+
+	batch.paged_indices.push_back(index);
+	resident.is_paging = true;
+
+	resident_size -= calculate_chain_size(resident, old_mip);
+	resident_size += calculate_chain_size(resident, mip);
+	resident.resident_mip = mip;
+	resident.is_placeholder = false;
+
+	if (mip > old_mip || mip == 0u)
+		resident.is_streaming = false;
+
+	auto const extent = calculate_level_extent(resident, mip);
+	texture.size = { extent.width, extent.height };
+	texture.mip_levels = new_level_count;
+	texture.device_size = calculate_chain_size(resident, mip);
+	texture.descriptor_info.imageView = texture.image_view;
+
+	retired_images.push_back({ frame_counter, std::move(old_image), old_image_view });
+
+	if (resident.descriptor_index == unassigned_descriptor_index)
+		return;
+
+	for (auto &writes : pending_writes)
+		writes.push_back(resident.descriptor_index);
+}
+
+auto ResidencyManager::get_recording_batch() -> PagingBatch &
+{
+	ZoneScoped;
+
+	if (recording_batch.cmd)
+		return recording_batch;
+
+	recording_batch.cmd = device->vk().allocateCommandBuffers(vk::CommandBufferAllocateInfo {
+	    command_pool,
+	    vk::CommandBufferLevel::ePrimary,
+	    1u,
+	})[0];
+
+	recording_batch.cmd.begin(vk::CommandBufferBeginInfo {
+	    vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+	});
+
+	return recording_batch;
+}
+
+void ResidencyManager::submit_recording_batch()
+{
+	ZoneScoped;
+
+	if (!recording_batch.cmd)
+		return;
+
+	recording_batch.cmd.end();
+	recording_batch.fence = device->vk().createFence(vk::FenceCreateInfo {});
+
+	// Submitted ahead of the frame, whose draws are ordered after the copies by their barriers
+	device->submit(recording_batch.cmd, recording_batch.fence);
+
+	submitted_batches.push_back(std::move(recording_batch));
+	recording_batch = {};
+}
+
+auto ResidencyManager::create_level_copies(
+    ResidentTexture const &resident,
+    u32 const first_level,
+    u32 const last_level
+) const -> vec<vk::BufferImageCopy>
+{
+	ZoneScoped;
+
+	// Levels are tightly packed, the image's first level is first_level
+	auto copies = vec<vk::BufferImageCopy> {};
+	auto offset = vk::DeviceSize {};
+
+	for (auto level = first_level; level < last_level; ++level)
+	{
+		copies.push_back(vk::BufferImageCopy {
+		    offset,
+		    0u,
+		    0u,
+		    vk::ImageSubresourceLayers {
+		        vk::ImageAspectFlagBits::eColor,
+		        level - first_level,
+		        0u,
+		        1u,
+		    },
+		    vk::Offset3D { 0, 0, 0 },
+		    calculate_level_extent(resident, level),
+		});
+
+		offset += calculate_level_size(resident, level);
+	}
+
+	return copies;
+}
+
+auto ResidencyManager::create_staging_buffer(
+    ResidentTexture const &resident,
+    u32 const first_level,
+    u32 const last_level
+) const -> Buffer
+{
+	ZoneScoped;
+
+	auto staging_buffer = Buffer {
+		vk_context,
+		memory_allocator,
+		vk::BufferUsageFlagBits::eTransferSrc,
+		vma::AllocationCreateInfo {
+		    vma::AllocationCreateFlagBits::eHostAccessSequentialWrite,
+		    vma::MemoryUsage::eAutoPreferHost,
+		},
+		calculate_chain_size(resident, first_level) - calculate_chain_size(resident, last_level),
+		1u,
+		resident.texture->debug_name,
+	};
+
+	auto *const map = static_cast<u8 *>(staging_buffer.map_block(0u));
+
+	auto offset = vk::DeviceSize {};
+	for (auto level = first_level; level < last_level; ++level)
+	{
+		auto const size = calculate_level_size(resident, level);
+
+		memcpy(map + offset, resident.paged_out_levels[level].data(), size);
+		offset += size;
+	}
+
+	staging_buffer.unmap();
+	return staging_buffer;
+}
+
+auto ResidencyManager::create_readback_buffer(
+    ResidentTexture const &resident,
+    u32 const first_level,
+    u32 const last_level
+) const -> Buffer
+{
+	ZoneScoped;
+
+	return Buffer {
+		vk_context,
+		memory_allocator,
+		vk::BufferUsageFlagBits::eTransferDst,
+		vma::AllocationCreateInfo {
+		    vma::AllocationCreateFlagBits::eHostAccessRandom,
+		    vma::MemoryUsage::eAutoPreferHost,
+		},
+		calculate_chain_size(resident, first_level) - calculate_chain_size(resident, last_level),
+		1u,
+		resident.texture->debug_name,
+	};
+}
+
+void ResidencyManager::read_back_levels(PendingReadback &readback)
+{
+	ZoneScoped;
+
+	auto &resident = textures[readback.index];
+	auto const *const map = static_cast<u8 const *>(readback.buffer.map_block(0u));
+
+	auto offset = vk::DeviceSize {};
+	for (auto level = readback.first_level; level < readback.last_level; ++level)
+	{
+		auto const size = calculate_level_size(resident, level);
+
+		resident.paged_out_levels[level].assign(map + offset, map + offset + size);
+		offset += size;
+	}
+
+	readback.buffer.unmap();
+}
+
+auto ResidencyManager::create_image(ResidentTexture const &resident, u32 const mip) const -> Image
+{
+	ZoneScoped;
+
+	return Image {
+		memory_allocator,
+
+		vk::ImageCreateInfo {
+		    {},
+		    vk::ImageType::e2D,
+		    resident.texture->format,
+		    calculate_level_extent(resident, mip),
+		    resident.full_mip_levels - mip,
+		    1u,
+		    vk::SampleCountFlagBits::e1,
+		    vk::ImageTiling::eOptimal,
+		    vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc
+		        | vk::ImageUsageFlagBits::eSampled,
+		    vk::SharingMode::eExclusive,
+		    0u,
+		    nullptr,
+		    vk::ImageLayout::eUndefined,
+		},
+
+		vma::AllocationCreateInfo {
+		    {},
+		    vma::MemoryUsage::eGpuOnly,
+		    vk::MemoryPropertyFlagBits::eDeviceLocal,
+		},
+	};
+}
+
+auto ResidencyManager::create_image_view(
+    ResidentTexture const &resident,
+    vk::Image const image,
+    u32 const mip
+) const -> vk::ImageView
+{
+	ZoneScoped;
+
+	return device->vk().createImageView(vk::ImageViewCreateInfo {
+	    {},
+	    image,
+	    vk::ImageViewType::e2D,
+	    resident.texture->format,
+	    vk::ComponentMapping {
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	        vk::ComponentSwizzle::eIdentity,
+	    },
+	    vk::ImageSubresourceRange {
+	        vk::ImageAspectFlagBits::eColor,
+	        0u,
+	        resident.full_mip_levels - mip,
+	        0u,
+	        1u,
+	    },
+	});
+}
+
+void ResidencyManager::write_descriptors(
+    u32 const frame_index,
+    vk::DescriptorSet const descriptor_set,
+    u32 const binding
+)
+{
+	ZoneScoped;
+
+	auto &descriptor_indices_to_write = pending_writes[frame_index];
+	if (descriptor_indices_to_write.empty())
+		return;
+
+	auto writes = vec<vk::WriteDescriptorSet> {};
+	writes.reserve(descriptor_indices_to_write.size());
+
+	for (auto const descriptor_index : descriptor_indices_to_write)
+	{
+		auto const *const texture = textures[descriptor_indices.at(descriptor_index)].texture;
+
+		writes.push_back({
+		    descriptor_set,
+		    binding,
+		    descriptor_index,
+		    1u,
+		    vk::DescriptorType::eCombinedImageSampler,
+		    texture->get_descriptor_info(),
+		});
+	}
+
+	device->vk().updateDescriptorSets(writes, {});
+	descriptor_indices_to_write.clear();
+}
+
+auto ResidencyManager::calculate_level_extent(ResidentTexture const &resident, u32 const level)
+    const -> vk::Extent3D
+{
+	auto const [width, height] = resident.full_size;
+	return { std::max(width >> level, 1u), std::max(height >> level, 1u), 1u };
+}
+
+auto ResidencyManager::calculate_level_size(ResidentTexture const &resident, u32 const level)
+    const -> vk::DeviceSize
+{
+	auto const extent = calculate_level_extent(resident, level);
+	auto const [block_width, block_height, block_size] = resident.block;
+
+	auto const blocks_per_row = (extent.width + block_width - 1u) / block_width;
+	auto const block_rows = (extent.height + block_height - 1u) / block_height;
+
+	return static_cast<vk::DeviceSize>(blocks_per_row) * block_rows * block_size;
+}
+
+auto ResidencyManager::calculate_chain_size(ResidentTexture const &resident, u32 const mip) const
+    -> vk::DeviceSize
+{
+	auto size = vk::DeviceSize {};
+	for (auto level = mip; level < resident.full_mip_levels; ++level)
+		size += calculate_level_size(resident, level);
+
+	return size;
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -12,7 +12,7 @@ Texture::~Texture()
 		return;
 
 	device->vk().destroyImageView(image_view);
-	device->vk().destroySampler(sampler);
+	sampler_cache->release(sampler);
 }
 
 void Texture::transition_layout(
@@ -1,6 +1,7 @@
 #include "BindlessVk/Texture/TextureLoader.hpp"
 
 
+#include "BindlessVk/Texture/Loaders/AssetLoader.hpp"
 #include "BindlessVk/Texture/Loaders/BinaryLoader.hpp"
 #include "BindlessVk/Texture/Loaders/KtxLoader.hpp"
 
@@ -48,6 +49,19 @@ auto TextureLoader::load_from_binary(
 	return std::move(loader.load(pixels, width, height, size, type, final_layout, debug_name));
 }
 
+auto TextureLoader::load_from_binaries(
+    span<BinaryTextureInfo const> const infos,
+    Texture::Type const type,
+    Buffer *const staging_buffer,
+    vk::ImageLayout const final_layout /* = vk::ImageLayout::eShaderReadOnlyOptimal */
+) const -> vec<Texture>
+{
+	ZoneScoped;
+
+	BinaryLoader loader(vk_context, memory_allocator, staging_buffer);
+	return loader.load_batch(infos, type, final_layout);
+}
+
 auto TextureLoader::load_from_ktx(
     str_view const uri,
     Texture::Type const type,
@@ -62,4 +76,41 @@ auto TextureLoader::load_from_ktx(
 	return std::move(loader.load(uri, type, layout, debug_name));
 }
 
+auto TextureLoader::load_from_asset(
+    str_view const uri,
+    Texture::Type const type,
+    Buffer *const staging_buffer,
+    vk::ImageLayout const layout, /* = vk::ImageLayout::eShaderReadOnlyOptimal */
+    str_view const debug_name     /* = default_debug_name */
+) const -> Texture
+{
+	ZoneScoped;
+
+	AssetLoader loader(vk_context, memory_allocator, staging_buffer, gpu_decompressor);
+	return std::move(loader.load(uri, type, layout, debug_name));
+}
+
+auto TextureLoader::load_from_archive(
+    Assets::AssetArchive const *const archive,
+    str_view const name,
+    Texture::Type const type,
+    Buffer *const staging_buffer,
+    vk::ImageLayout const layout, /* = vk::ImageLayout::eShaderReadOnlyOptimal */
+    str_view const debug_name     /* = default_debug_name */
+) const -> Texture
+{
+	ZoneScoped;
+
+	auto const *const entry = archive->find(name);
+	assert_true(
+	    entry,
+	    "Texture asset is not in the archive: \nname: {}\npath: {}",
+	    debug_name,
+	    name
+	);
+
+	AssetLoader loader(vk_context, memory_allocator, staging_buffer, gpu_decompressor);
+	return std::move(loader.load(archive->get_asset(entry), type, layout, debug_name));
+}
+
 } // namespace BINDLESSVK_NAMESPACE
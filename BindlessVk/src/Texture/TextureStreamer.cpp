@@ -0,0 +1,62 @@
+#include "BindlessVk/Texture/TextureStreamer.hpp"
+
+namespace BINDLESSVK_NAMESPACE {
+
+TextureStreamer::TextureStreamer(u32 const thread_count)
+{
+	ZoneScoped;
+
+	for (u32 i = 0u; i < std::max(thread_count, 1u); ++i)
+		threads.emplace_back([this](std::stop_token stop_token) { work(stop_token); });
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	ZoneScoped;
+
+	for (auto &thread : threads)
+		thread.request_stop();
+
+	condition.notify_all();
+}
+
+void TextureStreamer::push(usize const id, LevelLoader &&loader)
+{
+	ZoneScoped;
+
+	{
+		auto const lock = std::scoped_lock(mutex);
+		loaders.emplace(id, std::move(loader));
+	}
+
+	condition.notify_one();
+}
+
+auto TextureStreamer::pop_finished() -> vec<StreamedLevels>
+{
+	ZoneScoped;
+
+	auto const lock = std::scoped_lock(mutex);
+	return std::exchange(finished, {});
+}
+
+void TextureStreamer::work(std::stop_token const stop_token)
+{
+	while (true)
+	{
+		auto lock = std::unique_lock(mutex);
+		if (!condition.wait(lock, stop_token, [this]() { return !loaders.empty(); }))
+			return;
+
+		auto [id, loader] = std::move(loaders.front());
+		loaders.pop();
+		lock.unlock();
+
+		auto levels = loader();
+
+		lock.lock();
+		finished.push_back({ id, std::move(levels) });
+	}
+}
+
+} // namespace BINDLESSVK_NAMESPACE
@@ -1,13 +1,18 @@
 #include "Development/Development.hpp"
 
+#include <AssetArchive.hpp>
+#include <MeshAsset.hpp>
+#include <ShaderPackAsset.hpp>
 #include <optional>
 #include <span>
 
 DevelopmentExampleApplication::DevelopmentExampleApplication()
+    : Application(static_mesh_vertex_encoding)
 {
 	setup_rng();
 
 	load_shaders();
+	create_gpu_decompressor();
 	load_pipeline_configuration();
 	load_graphics_pipelines();
 	load_compute_pipelines();
@@ -19,6 +24,8 @@ DevelopmentExampleApplication::DevelopmentExampleApplication()
 
 	initialize_render_nodes();
 	create_render_graph();
+
+	shader_reloader.start(&vk_context, &shaders, &shader_pipelines, "Shaders/");
 }
 
 DevelopmentExampleApplication::~DevelopmentExampleApplication()
@@ -33,6 +40,8 @@ void DevelopmentExampleApplication::on_tick(f64 const delta_time)
 	Logger::show_imgui_window();
 
 	camera_controller.update();
+
+	shader_reloader.update();
 	renderer.render_graph(&render_graph);
 
 	if (renderer.is_swapchain_invalid())
@@ -50,14 +59,31 @@ void DevelopmentExampleApplication ::setup_rng()
 void DevelopmentExampleApplication::load_shaders()
 {
 	auto constexpr DIRECTORY = "Shaders/";
+	auto constexpr PACK_PATH = "Shaders/shaders.bvsp";
+
+	// The pack is trusted as is, shader.sh rebuilds (or removes) it whenever the modules change
+	auto pack = Assets::ShaderPack {};
+	if (pack.open(PACK_PATH))
+	{
+		auto const *const entries = pack.get_entries();
+
+		for (u32 i = 0; i < pack.get_shader_count(); ++i)
+		{
+			auto const name = str { pack.get_name(&entries[i]) };
+
+			shaders[hash_str(name)] = shader_loader.load_from_pack(&pack, name);
+			log_trc("Loaded shader {} from pack", name);
+		}
+	}
 
+	// Modules missing from the pack
 	for (auto const &shader_file : std::filesystem::directory_iterator(DIRECTORY))
 	{
 		str const path(shader_file.path().c_str());
 		str const extension(shader_file.path().extension().c_str());
 		str const name(shader_file.path().filename().replace_extension());
 
-		if (strcmp(extension.c_str(), ".spv"))
+		if (strcmp(extension.c_str(), ".spv") || shaders.contains(hash_str(name)))
 			continue;
 
 		shaders[hash_str(name)] = shader_loader.load_from_spv(path);
@@ -65,6 +91,26 @@ void DevelopmentExampleApplication::load_shaders()
 	}
 }
 
+void DevelopmentExampleApplication::create_gpu_decompressor()
+{
+	auto const shader_it = shaders.find(hash_str("lz4_decompress"));
+	if (shader_it == shaders.end())
+	{
+		log_wrn("lz4_decompress shader is missing, asset textures are decompressed on the cpu");
+		return;
+	}
+
+	gpu_decompressor = {
+		&vk_context,
+		&memory_allocator,
+		&layout_allocator,
+		&shader_it->second,
+		1024u * 1024u * 128u,
+	};
+
+	texture_loader.set_gpu_decompressor(&gpu_decompressor);
+}
+
 void DevelopmentExampleApplication::load_graphics_pipelines()
 {
 	auto const [bindings, flags] = BasicRendergraph::get_graphics_descriptor_set_bindings();
@@ -122,7 +168,7 @@ void DevelopmentExampleApplication::load_compute_pipelines()
 	        {
 	            &shaders[hash_str("cull")],
 	        },
-	        {},
+	        shader_effect_configurations[hash_str("cull")],
 	        graph_set_layout,
 	        {},
 	        "cull",
@@ -133,7 +179,7 @@ void DevelopmentExampleApplication::load_compute_pipelines()
 void DevelopmentExampleApplication::load_pipeline_configuration()
 {
 	shader_effect_configurations[hash_str("opaque_mesh")] = bvk::ShaderPipeline::Configuration {
-		bvk::Model::Vertex::get_vertex_input_state(),
+		bvk::Model::Vertex::get_vertex_input_state(static_mesh_vertex_encoding),
 		vk::PipelineInputAssemblyStateCreateInfo {
 		    {},
 		    vk::PrimitiveTopology::eTriangleList,
@@ -200,6 +246,16 @@ void DevelopmentExampleApplication::load_pipeline_configuration()
 		},
 	};
 
+	shader_effect_configurations[hash_str("opaque_mesh")].set_specialization_constant(
+	    BasicRendergraph::PointLight::max_count_constant_id,
+	    u32 { BasicRendergraph::PointLight::max_count }
+	);
+
+	shader_effect_configurations[hash_str("opaque_mesh")].set_specialization_constant(
+	    Forwardpass::octahedral_directions_constant_id,
+	    static_mesh_vertex_encoding.direction != Assets::DirectionEncoding::Float
+	);
+
 	shader_effect_configurations[hash_str("skybox")] = bvk::ShaderPipeline::Configuration {
 		bvk::Model::Vertex::get_vertex_input_state(),
 		vk::PipelineInputAssemblyStateCreateInfo {
@@ -267,6 +323,11 @@ void DevelopmentExampleApplication::load_pipeline_configuration()
 		    vk::DynamicState::eScissor,
 		},
 	};
+
+	shader_effect_configurations[hash_str("cull")].set_specialization_constant(
+	    Forwardpass::cull_workgroup_size_constant_id,
+	    Forwardpass::default_cull_workgroup_size
+	);
 }
 
 void DevelopmentExampleApplication::load_materials()
@@ -292,33 +353,91 @@ void DevelopmentExampleApplication::load_materials()
 
 void DevelopmentExampleApplication::load_models()
 {
+	auto constexpr ARCHIVE_PATH = "BakedAssets/assets.asset_archive";
+
+	// Baked with: AssetBaker ./Assets ./BakedAssets --vertices=compact
+	auto archive = Assets::AssetArchive {};
+	if (!archive.open(ARCHIVE_PATH))
+		log_wrn("Asset archive {} is missing, models are loaded from their sources", ARCHIVE_PATH);
+
+	models.emplace(hash_str("skybox"), load_model(&archive, "Cube/Cube.gltf", "skybox"));
+
+	// The skybox pipeline reads full precision positions, static meshes get their own cube
 	models.emplace(
-	    hash_str("skybox"),
-	    model_loader.load_from_gltf_ascii(
-	        "Assets/Cube/Cube.gltf",
-	        &vertex_buffer,
-	        &index_buffer,
-	        staging_pool.get_by_index(0u),
-	        staging_pool.get_by_index(1u),
-	        staging_pool.get_by_index(2u),
-	        "skybox"
-	    )
+	    hash_str("cube"),
+	    load_model(&archive, "Cube/Cube.gltf", "cube", static_mesh_vertex_encoding)
 	);
 
 	models.emplace(
 	    hash_str("flight_helmet"),
-	    model_loader.load_from_gltf_ascii(
-	        "Assets/FlightHelmet/FlightHelmet.gltf",
-	        &vertex_buffer,
-	        &index_buffer,
-	        staging_pool.get_by_index(0u),
-	        staging_pool.get_by_index(1u),
-	        staging_pool.get_by_index(2u),
-	        "flight_helmet"
+	    load_model(
+	        &archive,
+	        "FlightHelmet/FlightHelmet.gltf",
+	        "flight_helmet",
+	        static_mesh_vertex_encoding
 	    )
 	);
 }
 
+auto DevelopmentExampleApplication::load_model(
+    Assets::AssetArchive const *const archive,
+    str_view const source_path,
+    str_view const name,
+    bvk::Model::VertexEncoding const vertex_encoding /* = {} */
+) -> bvk::Model
+{
+	auto constexpr SOURCE_DIRECTORY = "Assets/";
+
+	auto const asset_name = std::filesystem::path(source_path)
+	                            .replace_extension(".asset_mesh")
+	                            .generic_string();
+
+	// Meshes are baked with a single encoding, the ones drawn with another are loaded from source
+	auto const *const entry = archive->is_open() ? archive->find(asset_name) : nullptr;
+	if (entry
+	    && Assets::read_mesh_info(archive->get_asset(entry).json).vertex_encoding
+	           == vertex_encoding)
+		return model_loader.load_from_archive(
+		    archive,
+		    asset_name,
+		    &position_buffer,
+		    &attribute_buffer,
+		    &index_buffer,
+		    staging_pool.get_by_index(0u),
+		    staging_pool.get_by_index(1u),
+		    staging_pool.get_by_index(2u),
+		    name
+		);
+
+	log_trc("Mesh {} isn't baked with the expected encoding, loading it from source", asset_name);
+
+	auto const path = str { SOURCE_DIRECTORY } + str { source_path };
+	if (std::filesystem::path(path).extension() == ".glb")
+		return model_loader.load_from_gltf_binary(
+		    path,
+		    &position_buffer,
+		    &attribute_buffer,
+		    &index_buffer,
+		    staging_pool.get_by_index(0u),
+		    staging_pool.get_by_index(1u),
+		    staging_pool.get_by_index(2u),
+		    name,
+		    vertex_encoding
+		);
+
+	return model_loader.load_from_gltf_ascii(
+	    path,
+	    &position_buffer,
+	    &attribute_buffer,
+	    &index_buffer,
+	    staging_pool.get_by_index(0u),
+	    staging_pool.get_by_index(1u),
+	    staging_pool.get_by_index(2u),
+	    name,
+	    vertex_encoding
+	);
+}
+
 void DevelopmentExampleApplication::load_entities()
 {
 	scene.reserve(64'000);
@@ -412,7 +531,7 @@ void DevelopmentExampleApplication::load_point_lights()
 		scene.emplace<StaticMeshComponent>(
 		    entity,
 		    &materials.at(hash_str("opaque_mesh")),
-		    &models.at(hash_str("skybox"))
+		    &models.at(hash_str("cube"))
 		);
 	}
 }
@@ -436,7 +555,7 @@ void DevelopmentExampleApplication::load_static_meshes()
 			scene.emplace<StaticMeshComponent>(
 			    entity,
 			    &materials.at(hash_str("opaque_mesh")),
-			    &models.at(hash_str("skybox"))
+			    &models.at(hash_str("cube"))
 			);
 		}
 	}
@@ -575,9 +694,11 @@ auto DevelopmentExampleApplication::create_render_graph_blueprint() -> bvk::Rend
 	auto const color_output_input_hash = hash_str("uipass_color_out");
 
 	graph_user_data.scene = &scene;
-	graph_user_data.vertex_buffer = &vertex_buffer;
+	graph_user_data.position_buffer = &position_buffer;
+	graph_user_data.attribute_buffer = &attribute_buffer;
 	graph_user_data.index_buffer = &index_buffer;
 	graph_user_data.memory_allocator = &memory_allocator;
+	graph_user_data.residency_manager = &residency_manager;
 
 	blueprint.set_derived_object(&render_graph)
 	    .set_user_data(std::make_any<BasicRendergraph::UserData *>(&graph_user_data))
@@ -698,6 +819,29 @@ auto DevelopmentExampleApplication::create_render_graph_blueprint() -> bvk::Rend
 	        },
 	    })
 
+	    .add_buffer_input({
+	        BasicRendergraph::TextureFeedbackDescriptor::name,
+	        BasicRendergraph::TextureFeedbackDescriptor::key,
+	        sizeof(BasicRendergraph::TextureFeedbackDescriptor),
+	        vk::BufferUsageFlagBits::eStorageBuffer,
+	        bvk::RenderNodeBlueprint::BufferInput::UpdateFrequency::ePerFrame,
+	        vma::AllocationCreateInfo {
+	            vma::AllocationCreateFlagBits::eHostAccessRandom,
+	            vma::MemoryUsage::eAutoPreferHost,
+	        },
+	        vec<bvk::RenderNodeBlueprint::DescriptorInfo> {
+	            {
+	                vk::PipelineBindPoint::eGraphics,
+	                {
+	                    BasicRendergraph::TextureFeedbackDescriptor::binding,
+	                    vk::DescriptorType::eStorageBuffer,
+	                    1,
+	                    vk::ShaderStageFlagBits::eFragment,
+	                },
+	            },
+	        },
+	    })
+
 	    .add_texture_input({
 	        BasicRendergraph::TexturesDescriptor::name,
 	        &textures.at(hash_str("default_texture")),
@@ -707,7 +851,7 @@ auto DevelopmentExampleApplication::create_render_graph_blueprint() -> bvk::Rend
 	                vk::DescriptorSetLayoutBinding {
 	                    BasicRendergraph::TexturesDescriptor::binding,
 	                    vk::DescriptorType::eCombinedImageSampler,
-	                    10'000,
+	                    BasicRendergraph::TexturesDescriptor::count,
 	                    vk::ShaderStageFlagBits::eFragment,
 	                },
 	            },
@@ -11,6 +11,7 @@
 #include "Framework/Core/Window.hpp"
 #include "Framework/Scene/CameraController.hpp"
 #include "Framework/Scene/Scene.hpp"
+#include "Framework/Utils/ShaderReloader.hpp"
 #include "Framework/Utils/Timer.hpp"
 #include "Rendergraphs/Graph.hpp"
 #include "Rendergraphs/Passes/Forward.hpp"
@@ -33,6 +34,10 @@ public:
 		assert_fail("Swapchain recreation not supported (yet)");
 	}
 
+private:
+	/** Every static mesh is drawn by the opaque_mesh pipeline, so they share an encoding */
+	auto static constexpr static_mesh_vertex_encoding = Assets::compact_vertex_encoding;
+
 private:
 	BasicRendergraph::UserData graph_user_data {};
 	Forwardpass::UserData fowardpass_user_data = {};
@@ -41,6 +46,8 @@ private:
 	Forwardpass forward_pass = {};
 	UserInterfacePass user_interface_pass = {};
 
+	ShaderReloader shader_reloader = {};
+
 	std::uniform_int_distribution<u32> dst_0_100;
 	std::uniform_int_distribution<u32> dst_0_max;
 
@@ -49,6 +56,7 @@ private:
 private:
 	void setup_rng();
 	void load_shaders();
+	void create_gpu_decompressor();
 
 	void load_graphics_pipelines();
 	void load_compute_pipelines();
@@ -59,6 +67,16 @@ private:
 
 	void load_models();
 
+	/** Loads @a source_path's baked mesh from @a archive, or the source itself if it isn't baked
+	 * with @a vertex_encoding. The source path is relative to the Assets directory
+	 */
+	auto load_model(
+	    Assets::AssetArchive const *archive,
+	    str_view source_path,
+	    str_view name,
+	    bvk::Model::VertexEncoding vertex_encoding = {}
+	) -> bvk::Model;
+
 	void load_entities();
 
 	void load_cameras();
@@ -9,6 +9,8 @@
 #include "BindlessVk/Shader/DescriptorSet.hpp"
 #include "BindlessVk/Shader/Shader.hpp"
 #include "BindlessVk/Shader/ShaderLoader.hpp"
+#include "BindlessVk/Texture/Loaders/GpuDecompressor.hpp"
+#include "BindlessVk/Texture/ResidencyManager.hpp"
 #include "BindlessVk/Texture/Texture.hpp"
 #include "Framework/Common/Common.hpp"
 #include "Framework/Core/Window.hpp"
@@ -21,7 +23,9 @@
 class Application
 {
 public:
-	Application();
+	/** @param vertex_encoding Encoding most models are loaded with, the vertex buffers are sized
+	 * to hold the same number of vertices in both of its streams */
+	Application(bvk::Model::VertexEncoding vertex_encoding = {});
 	virtual ~Application();
 
 	virtual void on_tick(double delta_time) = 0;
@@ -43,7 +47,8 @@ public:
 	bvk::LayoutAllocator layout_allocator = {};
 	bvk::DescriptorAllocator descriptor_allocator = {};
 
-	bvk::FragmentedBuffer vertex_buffer = {};
+	bvk::FragmentedBuffer position_buffer = {};
+	bvk::FragmentedBuffer attribute_buffer = {};
 	bvk::FragmentedBuffer index_buffer = {};
 
 	Scene scene = {};
@@ -58,6 +63,9 @@ public:
 	bvk::ModelLoader model_loader = {};
 	bvk::ShaderLoader shader_loader = {};
 
+	bvk::ResidencyManager residency_manager = {};
+	bvk::GpuDecompressor gpu_decompressor = {};
+
 	hash_map<u64, bvk::Model> models = {};
 	hash_map<u64, bvk::Texture> textures = {};
 	hash_map<u64, bvk::Shader> shaders = {};
@@ -75,7 +83,8 @@ private:
 	void create_descriptor_pool();
 	void create_user_interface();
 	void create_loaders();
-	void create_buffers();
+	void create_residency_manager();
+	void create_buffers(bvk::Model::VertexEncoding vertex_encoding);
 
 	void load_default_textures();
 
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "BindlessVk/Shader/Shader.hpp"
+#include "BindlessVk/Shader/ShaderLoader.hpp"
+#include "Framework/Common/Common.hpp"
+
+/** Watches glsl sources and spv files in a directory on a background thread.
+ * Changed sources are recompiled and changed modules reloaded on the background thread. update(),
+ * which is to be called at a frame boundary, rebuilds only the pipelines created with the old
+ * module and swaps them in; replaced pipelines and modules are destroyed once no frame in flight
+ * can use them.
+ *
+ * @note Pipelines are rebuilt on the calling thread of update(), as LayoutAllocator is not thread
+ * safe. Reloads that change a pipeline's set 2 layout are rejected, materials keep the descriptor
+ * sets they allocated from the old one
+ */
+class ShaderReloader
+{
+public:
+	ShaderReloader() = default;
+
+	ShaderReloader(ShaderReloader const &) = delete;
+	ShaderReloader &operator=(ShaderReloader const &) = delete;
+
+	~ShaderReloader();
+
+	/** Starts watching @a directory
+	 *
+	 * @param shaders Loaded shaders, keyed by hash_str of their file name without extension
+	 * @param pipelines Shader pipelines to rebuild when one of their shaders change
+	 */
+	void start(
+	    bvk::VkContext const *vk_context,
+	    hash_map<u64, bvk::Shader> *shaders,
+	    hash_map<u64, bvk::ShaderPipeline> *pipelines,
+	    str_view directory
+	);
+
+	void stop();
+
+	/** Swaps in the reloaded shaders & pipelines and destroys the retired ones
+	 * @note Call once per frame, before recording it
+	 */
+	void update();
+
+private:
+	struct Reload
+	{
+		u64 shader_key;
+		str name;
+		bvk::Shader shader;
+	};
+
+	struct Retired
+	{
+		u32 frames_left;
+		vk::ShaderModule module;
+		vec<bvk::ShaderPipeline> pipelines;
+	};
+
+private:
+	void watch_loop();
+
+	void recompile_changed_sources();
+	void reload_changed_modules();
+
+	void reload_module(std::filesystem::path const &spv_path);
+
+	auto compile_source(std::filesystem::path const &source_path) -> bool;
+
+	auto get_latest_write_time(std::filesystem::path const &source_path)
+	    -> std::filesystem::file_time_type;
+
+	auto has_changed(std::filesystem::path const &path, std::filesystem::file_time_type time)
+	    -> bool;
+
+	auto rebuild_pipelines(Reload const &reload) const -> vec<pair<u64, bvk::ShaderPipeline>>;
+
+	void swap_reload(Reload const &reload, vec<pair<u64, bvk::ShaderPipeline>> &&new_pipelines);
+	void destroy_retired_resources();
+
+private:
+	bvk::Device const *device = {};
+	bvk::ShaderLoader shader_loader = {};
+
+	hash_map<u64, bvk::Shader> *shaders = {};
+	hash_map<u64, bvk::ShaderPipeline> *pipelines = {};
+
+	std::filesystem::path directory = {};
+	hash_map<str, std::filesystem::file_time_type> write_times = {};
+
+	std::thread worker = {};
+	std::atomic<bool> should_stop = {};
+
+	// guards pending_reloads and the shaders map against the worker
+	std::mutex mutex = {};
+	vec<Reload> pending_reloads = {};
+
+	vec<Retired> retired = {};
+};
@@ -5,7 +5,7 @@
 #include <backends/imgui_impl_glfw.h>
 #include <imgui.h>
 
-Application::Application()
+Application::Application(bvk::Model::VertexEncoding const vertex_encoding /* = {} */)
 {
 	create_window();
 	create_vk_context();
@@ -19,9 +19,10 @@ Application::Application()
 	camera_controller = { &scene, &window };
 	staging_pool = { 3, 1024u * 1024u * 256u, &vk_context, &memory_allocator };
 
+	create_residency_manager();
 	create_loaders();
 	load_default_textures();
-	create_buffers();
+	create_buffers(vertex_encoding);
 }
 
 Application::~Application()
@@ -197,17 +198,38 @@ void Application::create_user_interface()
 void Application::create_loaders()
 {
 	texture_loader = { &vk_context, &memory_allocator };
-	model_loader = { &vk_context, &memory_allocator };
+	model_loader = { &vk_context, &memory_allocator, &residency_manager };
 	shader_loader = { &vk_context };
 }
 
-void Application::create_buffers()
+void Application::create_residency_manager()
 {
-	vertex_buffer = bvk::FragmentedBuffer {
+	residency_manager = {
+		&vk_context,
+		&memory_allocator,
+		1024u * 1024u * 512u,
+	};
+}
+
+void Application::create_buffers(bvk::Model::VertexEncoding const vertex_encoding)
+{
+	// Both streams of a model start at the same vertex, so they're sized for the same number of
+	// vertices, as many full precision ones as 1GiB holds
+	auto constexpr vertex_budget = usize { 1024 * 1024 * 1024 } / sizeof(bvk::Model::Vertex);
+	auto const layout = Assets::get_vertex_layout(vertex_encoding);
+
+	position_buffer = bvk::FragmentedBuffer {
+		&vk_context,
+		&memory_allocator,
+		bvk::FragmentedBuffer::Type::eVertex,
+		vertex_budget * layout.position_stride,
+	};
+
+	attribute_buffer = bvk::FragmentedBuffer {
 		&vk_context,
 		&memory_allocator,
 		bvk::FragmentedBuffer::Type::eVertex,
-		1024 * 1024 * 1024,
+		vertex_budget * layout.attribute_stride,
 	};
 
 
@@ -286,6 +308,7 @@ auto Application::get_required_physical_device_features() const -> vk::PhysicalD
 	physical_device_features.samplerAnisotropy = true;
 	physical_device_features.multiDrawIndirect = true;
 	physical_device_features.drawIndirectFirstInstance = true;
+	physical_device_features.fragmentStoresAndAtomics = true;
 
 	return physical_device_features;
 }
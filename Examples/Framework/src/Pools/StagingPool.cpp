@@ -13,7 +13,8 @@ StagingPool::StagingPool(
 		staging_buffers.push_back({
 		    vk_context,
 		    memory_allocator,
-		    vk::BufferUsageFlagBits::eTransferSrc,
+		    // Storage usage lets the gpu decompressor read compressed blobs in place
+		    vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eStorageBuffer,
 		    {
 		        vma::AllocationCreateFlagBits::eHostAccessRandom,
 		        vma::MemoryUsage::eAutoPreferHost,
@@ -0,0 +1,318 @@
+#include "Framework/Utils/ShaderReloader.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define FRAMEWORK_HAS_POSIX_SPAWN 1
+	#include <spawn.h>
+	#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
+ShaderReloader::~ShaderReloader()
+{
+	stop();
+}
+
+void ShaderReloader::start(
+    bvk::VkContext const *const vk_context,
+    hash_map<u64, bvk::Shader> *const shaders,
+    hash_map<u64, bvk::ShaderPipeline> *const pipelines,
+    str_view const directory
+)
+{
+	this->device = vk_context->get_device();
+	this->shader_loader = bvk::ShaderLoader { vk_context };
+	this->shaders = shaders;
+	this->pipelines = pipelines;
+	this->directory = directory;
+
+	// record the current write times, only changes made from now on trigger a reload
+	recompile_changed_sources();
+	reload_changed_modules();
+
+	should_stop = false;
+	worker = std::thread(&ShaderReloader::watch_loop, this);
+}
+
+void ShaderReloader::stop()
+{
+	if (!worker.joinable())
+		return;
+
+	should_stop = true;
+	worker.join();
+
+	device->vk().waitIdle();
+
+	for (auto &reload : pending_reloads)
+		device->vk().destroyShaderModule(reload.shader.module);
+
+	for (auto &retired_resources : retired)
+		device->vk().destroyShaderModule(retired_resources.module);
+
+	pending_reloads.clear();
+	retired.clear();
+}
+
+void ShaderReloader::update()
+{
+	auto lock = std::unique_lock(mutex, std::try_to_lock);
+
+	// the worker is busy loading a module, don't stall the frame; pick the results up next frame
+	if (lock.owns_lock())
+	{
+		for (auto const &reload : pending_reloads)
+		{
+			try
+			{
+				swap_reload(reload, rebuild_pipelines(reload));
+			}
+			catch (std::exception const &exception)
+			{
+				log_err("Failed to reload shader {}: {}", reload.name, exception.what());
+				device->vk().destroyShaderModule(reload.shader.module);
+			}
+		}
+
+		pending_reloads.clear();
+	}
+
+	destroy_retired_resources();
+}
+
+void ShaderReloader::watch_loop()
+{
+	while (!should_stop)
+	{
+		try
+		{
+			recompile_changed_sources();
+			reload_changed_modules();
+		}
+		catch (std::exception const &exception)
+		{
+			log_err("Shader hot reload failed: {}", exception.what());
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+	}
+}
+
+void ShaderReloader::recompile_changed_sources()
+{
+	for (auto const &file : std::filesystem::directory_iterator(directory))
+	{
+		auto const &source_path = file.path();
+		if (source_path.extension() != ".glsl")
+			continue;
+
+		// sources without a module are include files, their changes are tracked by includers
+		auto spv_path = source_path;
+		spv_path.replace_extension(".spv");
+		if (!std::filesystem::exists(spv_path))
+			continue;
+
+		if (has_changed(source_path, get_latest_write_time(source_path)))
+			compile_source(source_path);
+	}
+}
+
+void ShaderReloader::reload_changed_modules()
+{
+	for (auto const &file : std::filesystem::directory_iterator(directory))
+	{
+		auto const &spv_path = file.path();
+		if (spv_path.extension() != ".spv")
+			continue;
+
+		if (has_changed(spv_path, std::filesystem::last_write_time(spv_path)))
+		{
+			try
+			{
+				reload_module(spv_path);
+			}
+			catch (std::exception const &exception)
+			{
+				log_err("Failed to reload shader {}: {}", spv_path.string(), exception.what());
+			}
+		}
+	}
+}
+
+void ShaderReloader::reload_module(std::filesystem::path const &spv_path)
+{
+	auto const name = spv_path.stem().string();
+	auto const shader_key = hash_str(name);
+
+	{
+		auto const lock = std::scoped_lock(mutex);
+		if (!shaders->contains(shader_key))
+			return;
+	}
+
+	// Pipelines are rebuilt by update(), layouts can't be allocated on this thread
+	auto reload = Reload {
+		shader_key,
+		name,
+		shader_loader.load_from_spv(spv_path.string()),
+	};
+
+	auto const lock = std::scoped_lock(mutex);
+
+	log_inf("Reloaded shader {}", name);
+	pending_reloads.push_back(std::move(reload));
+}
+
+auto ShaderReloader::compile_source(std::filesystem::path const &source_path) -> bool
+{
+	auto spv_path = source_path;
+	spv_path.replace_extension(".spv");
+
+	auto const source = source_path.string();
+	auto const spv = spv_path.string();
+
+	log_inf("Compiling shader {}", source);
+
+	// same as shader.sh, the paths are passed as arguments rather than through a shell
+#if defined(FRAMEWORK_HAS_POSIX_SPAWN)
+	char const *const arguments[] = {
+		"glslc",
+		"--target-env=vulkan1.2",
+		source.c_str(),
+		"-o",
+		spv.c_str(),
+		nullptr,
+	};
+
+	auto pid = pid_t {};
+	auto status = int {};
+
+	auto const is_spawned = !posix_spawnp(
+	    &pid,
+	    "glslc",
+	    nullptr,
+	    nullptr,
+	    const_cast<char *const *>(arguments),
+	    environ
+	);
+
+	auto const succeeded = is_spawned && waitpid(pid, &status, 0) == pid && WIFEXITED(status)
+	                       && !WEXITSTATUS(status);
+#else
+	auto const command = std::format(
+	    "glslc --target-env=vulkan1.2 \"{}\" -o \"{}\"",
+	    source,
+	    spv
+	);
+
+	auto const succeeded = std::system(command.c_str()) == 0;
+#endif
+
+	if (!succeeded)
+		log_err("Failed to compile shader {}", source_path.string());
+
+	return succeeded;
+}
+
+auto ShaderReloader::get_latest_write_time(std::filesystem::path const &source_path)
+    -> std::filesystem::file_time_type
+{
+	auto latest_write_time = std::filesystem::last_write_time(source_path);
+
+	auto stream = std::ifstream(source_path);
+	auto line = str {};
+
+	auto const include_regex = std::regex(R"(^\s*#\s*include\s*\"([^\"]+)\")");
+	auto match = std::smatch {};
+
+	while (std::getline(stream, line))
+	{
+		if (!std::regex_search(line, match, include_regex))
+			continue;
+
+		auto const include_path = source_path.parent_path() / match[1].str();
+		if (std::filesystem::exists(include_path))
+			latest_write_time = std::max(latest_write_time, get_latest_write_time(include_path));
+	}
+
+	return latest_write_time;
+}
+
+auto ShaderReloader::has_changed(
+    std::filesystem::path const &path,
+    std::filesystem::file_time_type const time
+) -> bool
+{
+	auto const [it, inserted] = write_times.try_emplace(path.string(), time);
+
+	if (inserted || it->second >= time)
+		return false;
+
+	it->second = time;
+	return true;
+}
+
+auto ShaderReloader::rebuild_pipelines(Reload const &reload) const
+    -> vec<pair<u64, bvk::ShaderPipeline>>
+{
+	auto const old_module = shaders->at(reload.shader_key).module;
+	auto new_pipelines = vec<pair<u64, bvk::ShaderPipeline>> {};
+
+	for (auto const &[key, pipeline] : *pipelines)
+	{
+		if (!pipeline.uses_shader_module(old_module))
+			continue;
+
+		new_pipelines.emplace_back(key, pipeline.recreate_with_shader(reload.shader));
+		auto const &new_pipeline = new_pipelines.back().second;
+
+		// Materials keep the descriptor sets they allocated from the old layout
+		assert_true(
+		    new_pipeline.get_descriptor_set_layout().vk()
+		        == pipeline.get_descriptor_set_layout().vk(),
+		    "Shader {} changes the set 2 layout of pipeline {}, restart to apply it",
+		    reload.name,
+		    pipeline.get_name()
+		);
+	}
+
+	log_inf("Rebuilt {} pipeline(s) of shader {}", new_pipelines.size(), reload.name);
+	return new_pipelines;
+}
+
+void ShaderReloader::swap_reload(
+    Reload const &reload,
+    vec<pair<u64, bvk::ShaderPipeline>> &&new_pipelines
+)
+{
+	auto &shader = shaders->at(reload.shader_key);
+
+	auto retired_resources = Retired {
+		static_cast<u32>(bvk::max_frames_in_flight + 1),
+		shader.module,
+		{},
+	};
+
+	shader = reload.shader;
+
+	for (auto &[key, new_pipeline] : new_pipelines)
+	{
+		auto &pipeline = pipelines->at(key);
+
+		retired_resources.pipelines.push_back(std::move(pipeline));
+		pipeline = std::move(new_pipeline);
+	}
+
+	retired.push_back(std::move(retired_resources));
+}
+
+void ShaderReloader::destroy_retired_resources()
+{
+	for (auto &retired_resources : retired)
+		if (--retired_resources.frames_left == 0)
+			device->vk().destroyShaderModule(retired_resources.module);
+
+	std::erase_if(retired, [](auto const &retired_resources) {
+		return retired_resources.frames_left == 0;
+	});
+}
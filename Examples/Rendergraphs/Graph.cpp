@@ -18,8 +18,10 @@ void BasicRendergraph::on_setup(RenderNode *const parent)
 {
 	auto data = std::any_cast<UserData *>(user_data);
 	scene = data->scene;
-	vertex_buffer = data->vertex_buffer;
+	position_buffer = data->position_buffer;
+	attribute_buffer = data->attribute_buffer;
 	index_buffer = data->index_buffer;
+	residency_manager = data->residency_manager;
 
 	staging_buffer = bvk::Buffer {
 		vk_context,
@@ -42,12 +44,15 @@ void BasicRendergraph::setup_descriptors()
 	setup_descriptor_maps();
 	setup_primitives_descriptor();
 	setup_draw_indirects_descriptor();
+
+	register_resident_textures();
 }
 
 void BasicRendergraph::setup_descriptor_maps()
 {
 	staging_buffer_map = staging_buffer.map_block_zeroed(0);
 	setup_frame_descriptor_maps();
+	setup_texture_feedback_maps();
 }
 
 void BasicRendergraph::setup_frame_descriptor_maps()
@@ -59,6 +64,15 @@ void BasicRendergraph::setup_frame_descriptor_maps()
 		frame_descriptor_maps[i++] = static_cast<FrameDescriptor *>(map);
 }
 
+void BasicRendergraph::setup_texture_feedback_maps()
+{
+	auto maps = buffer_inputs[TextureFeedbackDescriptor::key].map_all_zeroed();
+
+	u32 i = 0;
+	for (auto map : maps)
+		texture_feedback_maps[i++] = static_cast<TextureFeedbackDescriptor *>(map);
+}
+
 void BasicRendergraph::setup_primitives_descriptor()
 {
 	auto &model_buffer = buffer_inputs[PrimitivesDescriptor::key];
@@ -95,6 +109,50 @@ void BasicRendergraph::setup_draw_indirects_descriptor()
 	memset(staging_buffer_map, {}, staging_buffer.get_whole_size());
 }
 
+void BasicRendergraph::register_resident_textures()
+{
+	auto const static_meshes = scene->view<StaticMeshComponent const>();
+
+	static_meshes.each([this](auto const &static_mesh) {
+		auto &textures = static_mesh.model->get_textures();
+		auto const base_index = get_texture_base_index(static_mesh.model);
+
+		for (auto const &material : static_mesh.model->get_material_parameters())
+		{
+			auto const indices = arr<i32, 3> {
+				material.albedo_index,
+				material.normal_index,
+				material.mr_index,
+			};
+
+			for (auto const index : indices)
+				if (index != -1)
+					residency_manager->register_texture(
+					    &textures[index],
+					    base_index + static_cast<u32>(index)
+					);
+		}
+	});
+}
+
+auto BasicRendergraph::get_texture_base_index(bvk::Model const *const model) -> u32
+{
+	auto const [it, is_new] = texture_base_indices.try_emplace(model, next_texture_base_index);
+	if (is_new)
+	{
+		next_texture_base_index += static_cast<u32>(model->get_textures().size());
+
+		assert_true(
+		    next_texture_base_index <= TexturesDescriptor::count,
+		    "Textures exceed max count: {} > {}",
+		    next_texture_base_index,
+		    TexturesDescriptor::count
+		);
+	}
+
+	return it->second;
+}
+
 void BasicRendergraph::stage_static_meshes(u32 buffer_index)
 {
 	auto i = u32 { 0 };
@@ -117,10 +175,20 @@ void BasicRendergraph::stage_indirect()
 
 		auto const vertex_offset = model->get_vertex_offset();
 		auto const index_offset = model->get_index_offset();
+		auto const index_type = model->get_index_type();
 
 		for (auto const *node : model->get_nodes())
 			for (auto const &primitive : node->mesh)
 			{
+				// The index buffer can only be bound with one type per indirect call
+				auto const is_new_range = indexed_draw_ranges.empty()
+				                          || indexed_draw_ranges.back().index_type != index_type;
+
+				if (is_new_range)
+					indexed_draw_ranges.push_back({ index_type, i, 0u });
+
+				++indexed_draw_ranges.back().draw_count;
+
 				map[i].cmd = vk::DrawIndexedIndirectCommand {
 					primitive.index_count, //
 					0,
@@ -145,6 +213,7 @@ void BasicRendergraph::on_frame_prepare(u32 const frame_index, u32 const image_i
 	this->frame_index = frame_index;
 
 	update_frame();
+	update_texture_residency();
 	update_descriptors();
 }
 
@@ -174,7 +243,8 @@ void BasicRendergraph::update_frame()
 
 void BasicRendergraph::bind_graphics_buffers(vk::CommandBuffer const cmd)
 {
-	vertex_buffer->bind(cmd);
+	position_buffer->bind(cmd, bvk::Model::Vertex::position_binding);
+	attribute_buffer->bind(cmd, bvk::Model::Vertex::attribute_binding);
 	index_buffer->bind(cmd);
 }
 
@@ -187,6 +257,26 @@ void BasicRendergraph::update_descriptors()
 	descriptor_writes.clear();
 }
 
+void BasicRendergraph::update_texture_residency()
+{
+	// The frame's fence has been waited on, so its feedback is complete
+	residency_manager->update(
+	    frame_index,
+	    texture_feedback_maps[frame_index]->feedback,
+	    graphics_descriptor_sets[frame_index].vk(),
+	    TexturesDescriptor::binding
+	);
+
+	auto budget_mib = static_cast<i32>(residency_manager->get_budget() / (1024u * 1024u));
+	if (ImGui::DragInt("texture budget (MiB)", &budget_mib, 8.0f, 16, 16 * 1024))
+		residency_manager->set_budget(static_cast<vk::DeviceSize>(budget_mib) * 1024u * 1024u);
+
+	ImGui::Text(
+	    "resident textures: %u MiB",
+	    static_cast<u32>(residency_manager->get_resident_size() / (1024u * 1024u))
+	);
+}
+
 void BasicRendergraph::update_cameras()
 {
 	auto const cameras = scene->view<TransformComponent const, CameraComponent const>();
@@ -292,14 +382,15 @@ void BasicRendergraph::update_point_light(
 void BasicRendergraph::update_primitive_textures(
     bvk::DescriptorSet const &descriptor_set,
     vec<bvk::Texture> const &textures,
-    bvk::Model::MaterialParameters material
+    bvk::Model::MaterialParameters material,
+    u32 const texture_base_index
 )
 {
 	if (material.albedo_index != -1)
 		descriptor_writes.push_back({
 		    descriptor_set.vk(),
 		    TexturesDescriptor::binding,
-		    static_cast<u32>(material.albedo_index),
+		    texture_base_index + static_cast<u32>(material.albedo_index),
 		    1,
 		    vk::DescriptorType::eCombinedImageSampler,
 		    textures[material.albedo_index].get_descriptor_info(),
@@ -309,7 +400,7 @@ void BasicRendergraph::update_primitive_textures(
 		descriptor_writes.push_back({
 		    descriptor_set.vk(),
 		    TexturesDescriptor::binding,
-		    static_cast<u32>(material.mr_index),
+		    texture_base_index + static_cast<u32>(material.mr_index),
 		    1,
 		    vk::DescriptorType::eCombinedImageSampler,
 		    textures[material.mr_index].get_descriptor_info(),
@@ -319,7 +410,7 @@ void BasicRendergraph::update_primitive_textures(
 		descriptor_writes.push_back({
 		    descriptor_set.vk(),
 		    TexturesDescriptor::binding,
-		    static_cast<u32>(material.normal_index),
+		    texture_base_index + static_cast<u32>(material.normal_index),
 		    1,
 		    vk::DescriptorType::eCombinedImageSampler,
 		    textures[material.normal_index].get_descriptor_info(),
@@ -329,20 +420,28 @@ void BasicRendergraph::update_primitive_textures(
 void BasicRendergraph::update_primitive_buffer(
     PrimitivesDescriptor &primitive,
     TransformComponent const &transform,
-    bvk::Model::MaterialParameters const &material
+    bvk::Model::MaterialParameters const &material,
+    Assets::PositionDequantization const &position_dequantization,
+    u32 const texture_base_index
 )
 {
 	primitive.transform = transform.get_transform();
 
+	auto const &[offset, scale] = position_dequantization;
+	primitive.position_offset = { offset[0], offset[1], offset[2], 0.0f };
+	primitive.position_scale = { scale[0], scale[1], scale[2], 0.0f };
+
 	primitive.x = transform.translation.x;
 	primitive.y = transform.translation.y;
 	primitive.z = transform.translation.z;
 
 	primitive.r = std::max(transform.scale.x, std::max(transform.scale.y, transform.scale.z));
 
-	primitive.albedo_index = material.albedo_index;
-	primitive.mr_index = material.mr_index;
-	primitive.normal_index = material.normal_index;
+	// Indices are relative to the model's textures, -1 stays as is for missing textures
+	auto const base_index = static_cast<i32>(texture_base_index);
+	primitive.albedo_index = material.albedo_index != -1 ? base_index + material.albedo_index : -1;
+	primitive.mr_index = material.mr_index != -1 ? base_index + material.mr_index : -1;
+	primitive.normal_index = material.normal_index != -1 ? base_index + material.normal_index : -1;
 }
 
 void BasicRendergraph::stage_static_mesh(
@@ -357,6 +456,8 @@ void BasicRendergraph::stage_static_mesh(
 
 	auto const &textures = static_mesh.model->get_textures();
 	auto const &materials = static_mesh.model->get_material_parameters();
+	auto const position_dequantization = static_mesh.model->get_position_dequantization();
+	auto const texture_base_index = get_texture_base_index(static_mesh.model);
 
 	for (auto const *const node : static_mesh.model->get_nodes())
 		for (auto const &primitive : node->mesh)
@@ -365,8 +466,14 @@ void BasicRendergraph::stage_static_mesh(
 
 			auto const &material = materials[primitive.material_index];
 
-			update_primitive_buffer(map[primitive_index++], transform, material);
-			update_primitive_textures(descriptor_set, textures, material);
+			update_primitive_buffer(
+			    map[primitive_index++],
+			    transform,
+			    material,
+			    position_dequantization,
+			    texture_base_index
+			);
+			update_primitive_textures(descriptor_set, textures, material, texture_base_index);
 		}
 }
 
@@ -393,7 +500,7 @@ auto BasicRendergraph::get_graphics_descriptor_set_bindings() -> pair<
 		    vk::DescriptorSetLayoutBinding {
 		        TexturesDescriptor::binding,
 		        vk::DescriptorType::eCombinedImageSampler,
-		        10'000,
+		        TexturesDescriptor::count,
 		        vk::ShaderStageFlagBits::eFragment,
 		    },
 
@@ -403,6 +510,13 @@ auto BasicRendergraph::get_graphics_descriptor_set_bindings() -> pair<
 		        1'000,
 		        vk::ShaderStageFlagBits::eFragment,
 		    },
+
+		    vk::DescriptorSetLayoutBinding {
+		        TextureFeedbackDescriptor::binding,
+		        vk::DescriptorType::eStorageBuffer,
+		        1,
+		        vk::ShaderStageFlagBits::eFragment,
+		    },
 		},
 
 		arr<vk::DescriptorBindingFlags, graphics_descriptor_set_bindings_count> {
@@ -410,6 +524,7 @@ auto BasicRendergraph::get_graphics_descriptor_set_bindings() -> pair<
 		    vk::DescriptorBindingFlagBits::ePartiallyBound,
 		    vk::DescriptorBindingFlagBits::ePartiallyBound,
 		    vk::DescriptorBindingFlagBits::ePartiallyBound,
+		    vk::DescriptorBindingFlagBits::ePartiallyBound,
 		},
 	};
 }
@@ -2,6 +2,7 @@
 
 #include "BindlessVk/Renderer/RenderNode.hpp"
 #include "BindlessVk/Renderer/Rendergraph.hpp"
+#include "BindlessVk/Texture/ResidencyManager.hpp"
 #include "Framework/Common/Common.hpp"
 #include "Framework/Scene/Components.hpp"
 #include "Framework/Scene/Scene.hpp"
@@ -13,9 +14,11 @@ public:
 	struct UserData
 	{
 		Scene *scene;
-		bvk::FragmentedBuffer *vertex_buffer;
+		bvk::FragmentedBuffer *position_buffer;
+		bvk::FragmentedBuffer *attribute_buffer;
 		bvk::FragmentedBuffer *index_buffer;
 		bvk::MemoryAllocator const *memory_allocator;
+		bvk::ResidencyManager *residency_manager;
 	};
 
 	struct DirectionalLight
@@ -41,6 +44,9 @@ public:
 		glm::vec4 specular;
 
 		auto static constexpr max_count = 32;
+
+		/** constant_id of max_point_light_count in the shaders */
+		auto static constexpr max_count_constant_id = u32 { 0 };
 	};
 
 	struct RenderScene
@@ -90,6 +96,10 @@ public:
 
 		glm::mat4 transform;
 
+		/** Takes the model's encoded positions back to model space, w is unused */
+		glm::vec4 position_offset;
+		glm::vec4 position_scale;
+
 		auto static constexpr name = str { "model_data" };
 		auto static constexpr key = hash_str(name);
 
@@ -109,10 +119,20 @@ public:
 		auto static constexpr binding = usize { 2 };
 	};
 
+	/** Consecutive indirect draws of models with the same index type, drawn by a single call */
+	struct IndexedDrawRange
+	{
+		vk::IndexType index_type;
+		u32 first_draw;
+		u32 draw_count;
+	};
+
 	struct TexturesDescriptor
 	{
 		auto static constexpr name = str { "textures" };
 		auto static constexpr binding = usize { 3 };
+
+		auto static constexpr count = u32 { 10'000 };
 	};
 
 	struct TextureCubesDescriptor
@@ -121,7 +141,18 @@ public:
 		auto static constexpr binding = usize { 4 };
 	};
 
-	auto static constexpr graphics_descriptor_set_bindings_count = usize { 4 };
+	/** Finest texel width (log2 + 1) sampled per bindless texture, read by the residency manager */
+	struct TextureFeedbackDescriptor
+	{
+		arr<bvk::ResidencyManager::Feedback, TexturesDescriptor::count> feedback;
+
+		auto static constexpr name = str { "texture_feedback" };
+		auto static constexpr key = hash_str(name);
+
+		auto static constexpr binding = usize { 5 };
+	};
+
+	auto static constexpr graphics_descriptor_set_bindings_count = usize { 5 };
 	auto static constexpr compute_descriptor_set_bindings_count = usize { 3 };
 
 public:
@@ -143,6 +174,18 @@ public:
 
 	void on_frame_graphics(vk::CommandBuffer cmd, u32 frame_index, u32 image_index) final;
 
+	/** Trivial const-ref accessor for indexed_draw_ranges */
+	auto &get_indexed_draw_ranges() const
+	{
+		return indexed_draw_ranges;
+	}
+
+	/** Trivial accessor for index_buffer */
+	auto get_index_buffer() const
+	{
+		return index_buffer;
+	}
+
 	auto static get_graphics_descriptor_set_bindings() -> pair<
 	    arr<vk::DescriptorSetLayoutBinding, graphics_descriptor_set_bindings_count>,
 	    arr<vk::DescriptorBindingFlags, graphics_descriptor_set_bindings_count>>;
@@ -180,6 +223,13 @@ private:
 	void setup_draw_indirects_descriptor();
 
 	void setup_frame_descriptor_maps();
+	void setup_texture_feedback_maps();
+
+	void register_resident_textures();
+
+	/** First bindless texture index of @a model's textures, they follow the textures of every
+	 * model registered before it */
+	auto get_texture_base_index(bvk::Model const *model) -> u32;
 
 	void update_frame();
 
@@ -191,6 +241,8 @@ private:
 
 	void update_descriptors();
 
+	void update_texture_residency();
+
 	void update_cameras();
 	void update_skyboxes();
 	void update_directional_lights();
@@ -220,19 +272,24 @@ private:
 	    PrimitivesDescriptor &primitive,
 
 	    TransformComponent const &transform,
-	    bvk::Model::MaterialParameters const &material
+	    bvk::Model::MaterialParameters const &material,
+	    Assets::PositionDequantization const &position_dequantization,
+	    u32 texture_base_index
 	);
 
 	void update_primitive_textures(
 	    bvk::DescriptorSet const &descriptor_set,
 	    vec<bvk::Texture> const &textures,
-	    bvk::Model::MaterialParameters material
+	    bvk::Model::MaterialParameters material,
+	    u32 texture_base_index
 	);
 
 private:
 	bvk::Device *device = {};
-	bvk::FragmentedBuffer *vertex_buffer = {};
+	bvk::FragmentedBuffer *position_buffer = {};
+	bvk::FragmentedBuffer *attribute_buffer = {};
 	bvk::FragmentedBuffer *index_buffer = {};
+	bvk::ResidencyManager *residency_manager = {};
 
 	bvk::Buffer staging_buffer = {};
 
@@ -241,10 +298,15 @@ private:
 
 	arr<FrameDescriptor *, bvk::max_frames_in_flight> frame_descriptor_maps;
 	arr<DrawIndirectDescriptor *, bvk::max_frames_in_flight> draw_indirect_descriptor_maps;
+	arr<TextureFeedbackDescriptor *, bvk::max_frames_in_flight> texture_feedback_maps;
 	PrimitivesDescriptor *primitive_descriptor_map;
 	void *staging_buffer_map;
 
 	usize primitive_count = {};
+	vec<IndexedDrawRange> indexed_draw_ranges = {};
+
+	hash_map<bvk::Model const *, u32> texture_base_indices = {};
+	u32 next_texture_base_index = {};
 
 	u32 frame_index = {};
 	Scene *scene = {};
@@ -24,10 +24,20 @@ void Forwardpass::on_setup(bvk::RenderNode *parent)
 	    BasicRendergraph::DrawIndirectDescriptor::key
 	);
 
+	// The graph is set up first, so its draws are already staged
+	auto const *const graph = static_cast<BasicRendergraph const *>(parent);
+	index_buffer = graph->get_index_buffer();
+	indexed_draw_ranges = &graph->get_indexed_draw_ranges();
+
 	cull_pipeline = data->cull_pipeline;
 	model_pipeline = data->model_pipeline;
 	skybox_pipeline = data->skybox_pipeline;
 
+	cull_workgroup_size = cull_pipeline->get_specialization_constant(
+	    cull_workgroup_size_constant_id,
+	    default_cull_workgroup_size
+	);
+
 	scene->view<StaticMeshComponent const>().each([this](StaticMeshComponent const &mesh) {
 		auto model = mesh.model;
 
@@ -51,7 +61,7 @@ void Forwardpass::on_frame_compute(vk::CommandBuffer cmd, u32 frame_index, u32 i
 
 	if (!freeze_cull)
 	{
-		u32 dispatch_x = 1 + (primitive_count / 64);
+		u32 dispatch_x = 1 + (primitive_count / cull_workgroup_size);
 		ImGui::Text("dispatches: %u", dispatch_x);
 
 		cmd.bindPipeline(vk::PipelineBindPoint::eCompute, cull_pipeline->get_pipeline());
@@ -83,12 +93,16 @@ void Forwardpass::render_static_meshes(u32 frame_index)
 
 	ImGui::Text("primitives: %u", primitive_count);
 
-	cmd.drawIndexedIndirect(
-	    *draw_indirect_buffer->vk(),
-	    0,
-	    primitive_count,
-	    sizeof(BasicRendergraph::DrawIndirectDescriptor)
-	);
+	for (auto const &range : *indexed_draw_ranges)
+	{
+		index_buffer->bind(cmd, range.index_type);
+		cmd.drawIndexedIndirect(
+		    *draw_indirect_buffer->vk(),
+		    range.first_draw * sizeof(BasicRendergraph::DrawIndirectDescriptor),
+		    range.draw_count,
+		    sizeof(BasicRendergraph::DrawIndirectDescriptor)
+		);
+	}
 }
 
 void Forwardpass::render_skyboxes()
@@ -155,6 +169,8 @@ void Forwardpass::draw_model(bvk::Model const *const model, u32 &primitive_index
 	auto const index_offset = model->get_index_offset();
 	auto const vertex_offset = model->get_vertex_offset();
 
+	index_buffer->bind(cmd, model->get_index_type());
+
 	for (auto const *node : model->get_nodes())
 		for (auto const &primitive : node->mesh)
 			cmd.drawIndexed(
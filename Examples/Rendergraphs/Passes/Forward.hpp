@@ -2,6 +2,7 @@
 
 #include "BindlessVk/Renderer/RenderNode.hpp"
 #include "Framework/Scene/Scene.hpp"
+#include "Rendergraphs/Graph.hpp"
 
 class Forwardpass: public bvk::RenderNode
 {
@@ -35,6 +36,16 @@ public:
 		u32 _pad2;
 	};
 
+	/** constant_id of the cull shader's workgroup size (local_size_x_id) */
+	auto static constexpr cull_workgroup_size_constant_id = u32 { 1 };
+
+	/** Workgroup size the cull shader was compiled with */
+	auto static constexpr default_cull_workgroup_size = u32 { 64 };
+
+	/** constant_id of the vertex shader's octahedral_directions, has to be set when static
+	 * meshes are encoded with octahedral normals & tangents */
+	auto static constexpr octahedral_directions_constant_id = u32 { 2 };
+
 public:
 	Forwardpass() = default;
 
@@ -91,6 +102,8 @@ private:
 	bvk::TracyContext tracy_compute;
 
 	bvk::Buffer const *draw_indirect_buffer = {};
+	bvk::FragmentedBuffer const *index_buffer = {};
+	vec<BasicRendergraph::IndexedDrawRange> const *indexed_draw_ranges = {};
 
 	vk::Pipeline current_pipeline = {};
 
@@ -103,6 +116,7 @@ private:
 	bvk::ShaderPipeline *skybox_pipeline = {};
 
 	u32 primitive_count = {};
+	u32 cull_workgroup_size = {};
 
 	bool freeze_cull = {};
 };
@@ -0,0 +1,226 @@
+#include <ShaderPackAsset.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <spirv_reflect.h>
+
+#define ASSERT(x, ...) \
+	if (!(x))            \
+	{                    \
+		log(__VA_ARGS__);  \
+		return -1;         \
+	}
+
+// set = 2 -> per shader, the only set that gets reflected into the pipeline
+constexpr uint32_t shader_descriptor_set_index = 2u;
+
+// matches the runtime array size BindlessVk's spv loader assumes
+constexpr uint32_t runtime_array_descriptor_count = 10'000u;
+
+template<typename... Args>
+void log(Args&&... args)
+{
+	(std::cout << ... << args);
+	std::cout << '\n';
+}
+
+bool load_code(const std::filesystem::path& path, std::vector<uint32_t>& code)
+{
+	std::ifstream instream(path, std::ios::binary | std::ios::ate);
+	if (!instream.is_open())
+		return false;
+
+	const size_t file_size = instream.tellg();
+	if (file_size % sizeof(uint32_t))
+		return false;
+
+	code.resize(file_size / sizeof(uint32_t));
+	instream.seekg(0ull);
+	instream.read((char*)code.data(), file_size);
+
+	return true;
+}
+
+bool reflect_bindings(
+  const SpvReflectShaderModule& reflection,
+  Assets::ShaderInfo& shader
+)
+{
+	uint32_t set_count = 0;
+	if (
+	  spvReflectEnumerateDescriptorSets(&reflection, &set_count, nullptr)
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	std::vector<SpvReflectDescriptorSet*> sets(set_count);
+	if (
+	  spvReflectEnumerateDescriptorSets(&reflection, &set_count, sets.data())
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	for (const SpvReflectDescriptorSet* set : sets)
+	{
+		if (set->set != shader_descriptor_set_index)
+			continue;
+
+		for (uint32_t i = 0; i < set->binding_count; ++i)
+		{
+			const SpvReflectDescriptorBinding* binding = set->bindings[i];
+
+			uint32_t descriptor_count = 1u;
+			for (uint32_t dim = 0; dim < binding->array.dims_count; ++dim)
+				descriptor_count *= binding->array.dims[dim];
+
+			if (descriptor_count == 0)
+				descriptor_count = runtime_array_descriptor_count;
+
+			shader.bindings.push_back({
+			  .binding          = binding->binding,
+			  .descriptor_type  = static_cast<uint32_t>(binding->descriptor_type),
+			  .descriptor_count = descriptor_count,
+			  ._0               = 0u,
+			});
+		}
+	}
+
+	return true;
+}
+
+bool reflect_push_constants(
+  const SpvReflectShaderModule& reflection,
+  Assets::ShaderInfo& shader
+)
+{
+	uint32_t block_count = 0;
+	if (
+	  spvReflectEnumeratePushConstantBlocks(&reflection, &block_count, nullptr)
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	std::vector<SpvReflectBlockVariable*> blocks(block_count);
+	if (
+	  spvReflectEnumeratePushConstantBlocks(
+	    &reflection,
+	    &block_count,
+	    blocks.data()
+	  )
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	if (blocks.empty())
+		return true;
+
+	uint32_t range_begin = UINT32_MAX;
+	uint32_t range_end   = 0u;
+	for (const SpvReflectBlockVariable* block : blocks)
+	{
+		range_begin = std::min(range_begin, block->offset);
+		range_end   = std::max(range_end, block->offset + block->size);
+	}
+
+	shader.push_constant_offset = range_begin;
+	shader.push_constant_size   = range_end - range_begin;
+
+	return true;
+}
+
+bool reflect_specialization_constants(
+  const SpvReflectShaderModule& reflection,
+  Assets::ShaderInfo& shader
+)
+{
+	uint32_t constant_count = 0;
+	if (
+	  spvReflectEnumerateSpecializationConstants(
+	    &reflection,
+	    &constant_count,
+	    nullptr
+	  )
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	std::vector<SpvReflectSpecializationConstant*> constants(constant_count);
+	if (
+	  spvReflectEnumerateSpecializationConstants(
+	    &reflection,
+	    &constant_count,
+	    constants.data()
+	  )
+	  != SPV_REFLECT_RESULT_SUCCESS
+	)
+		return false;
+
+	for (const SpvReflectSpecializationConstant* constant : constants)
+		shader.specialization_constants.push_back({
+		  .constant_id = constant->constant_id,
+		  .name        = constant->name ? constant->name : "",
+		});
+
+	return true;
+}
+
+bool pack_shader(const std::filesystem::path& path, Assets::ShaderInfo& shader)
+{
+	shader.name = path.filename().replace_extension().string();
+
+	if (!load_code(path, shader.code))
+		return false;
+
+	SpvReflectShaderModule reflection;
+	if (spvReflectCreateShaderModule(
+	      shader.code.size() * sizeof(uint32_t),
+	      shader.code.data(),
+	      &reflection
+	    )
+	    != SPV_REFLECT_RESULT_SUCCESS)
+		return false;
+
+	// vulkan's VkShaderStageFlagBits shares the values with spirv-reflect's
+	shader.stage = static_cast<uint32_t>(reflection.shader_stage);
+
+	// a failed reflection would silently write an entry with missing state
+	const bool is_reflected = reflect_bindings(reflection, shader)
+	                          && reflect_push_constants(reflection, shader)
+	                          && reflect_specialization_constants(reflection, shader);
+
+	spvReflectDestroyShaderModule(&reflection);
+
+	return is_reflected;
+}
+
+int main(int argc, char* argv[])
+{
+	std::ios_base::sync_with_stdio(false);
+
+	ASSERT(
+	  argc == 3,
+	  "Argc MUST be 3, 1: execution-path(implicit), 2: input-directory, 3: output-pack"
+	);
+
+	std::vector<Assets::ShaderInfo> shaders;
+
+	for (auto& p : std::filesystem::directory_iterator(argv[1]))
+	{
+		if (p.path().extension() != ".spv")
+			continue;
+
+		Assets::ShaderInfo shader {};
+		ASSERT(pack_shader(p.path(), shader), "Failed to pack shader -> ", p);
+
+		log("Packed a shader: ", p);
+		shaders.push_back(std::move(shader));
+	}
+
+	ASSERT(
+	  Assets::save_shader_pack(argv[2], std::move(shaders)),
+	  "Failed to save shader pack -> ",
+	  argv[2]
+	);
+
+	return 0;
+}
@@ -3,7 +3,8 @@
 
 #include "global_descriptors.glsl"
 
-layout(local_size_x = 64) in;
+// constant_id = 1 -> workgroup size, tunable per pipeline
+layout(local_size_x = 64, local_size_x_id = 1) in;
 
 bool is_visible(mat4 mat, vec3 origin, float radius)
 {
@@ -1,4 +1,8 @@
-#define max_point_light_count 32
+// capacity of the point lights array in u_frame, has to match the host side struct
+#define point_light_capacity 32
+
+// upper bound of point lights iterated by shaders, tunable per pipeline (<= point_light_capacity)
+layout(constant_id = 0) const uint max_point_light_count = point_light_capacity;
 
 struct Primitive
 {
@@ -13,6 +17,10 @@ struct Primitive
     int _0;
 
     mat4 model;
+
+    // takes the model's encoded positions back to model space, w is unused
+    vec4 position_offset;
+    vec4 position_scale;
 };
 
 struct IndirectCommand 
@@ -64,7 +72,7 @@ struct Scene
 {
     DirectionalLight directional_light;
 
-    PointLight[max_point_light_count] point_lights;
+    PointLight[point_light_capacity] point_lights;
     uint point_light_count;
 
     uint primitive_count;
@@ -90,3 +98,9 @@ layout(std430, set = 0, binding = 2) writeonly buffer SSBO_CommandBuffers
 
 layout(set = 0, binding = 3) uniform sampler2D s_textures[];
 layout(set = 0, binding = 4) uniform samplerCube s_texture_cubes[];
+
+// finest texel width (log2 + 1) sampled per bindless texture, consumed by the residency manager
+layout(std430, set = 0, binding = 5) buffer SSBO_TextureFeedback
+{
+    uint arr[];
+} ssbo_texture_feedback;
@@ -0,0 +1,128 @@
+#version 460
+#pragma shader_stage(compute)
+
+// Decompresses a chunked LZ4 blob (see AssetParser/ChunkedBlob.hpp), one invocation per chunk.
+// Chunks decompress to 4 byte aligned ranges, so every invocation owns the words it writes.
+layout(local_size_x = 64) in;
+
+layout(set = 0, binding = 0) readonly buffer SSBO_Chunks
+{
+    uvec2 arr[]; // x -> compressed offset, y -> compressed size
+} ssbo_chunks;
+
+layout(set = 0, binding = 1) readonly buffer SSBO_Compressed
+{
+    uint arr[];
+} ssbo_compressed;
+
+layout(set = 0, binding = 2) buffer SSBO_Decompressed
+{
+    uint arr[];
+} ssbo_decompressed;
+
+layout(push_constant) uniform PushConstants
+{
+    uint chunk_count;
+    uint chunk_size;
+    uint decompressed_size;
+} u_push;
+
+// Output bytes are gathered in a register and stored a word at a time
+uint pending_word;
+uint output_offset;
+
+uint read_compressed(uint offset)
+{
+    return (ssbo_compressed.arr[offset >> 2] >> ((offset & 3) * 8)) & 0xff;
+}
+
+uint read_decompressed(uint offset)
+{
+    const uint word = (offset >> 2) == (output_offset >> 2) ? pending_word
+                                                            : ssbo_decompressed.arr[offset >> 2];
+
+    return (word >> ((offset & 3) * 8)) & 0xff;
+}
+
+void write_decompressed(uint value)
+{
+    pending_word |= value << ((output_offset & 3) * 8);
+
+    if ((output_offset & 3) == 3)
+    {
+        ssbo_decompressed.arr[output_offset >> 2] = pending_word;
+        pending_word = 0;
+    }
+
+    ++output_offset;
+}
+
+void main()
+{
+    const uint chunk_index = gl_GlobalInvocationID.x;
+
+    if (chunk_index >= u_push.chunk_count)
+        return;
+
+    const uvec2 chunk = ssbo_chunks.arr[chunk_index];
+
+    uint input_offset = chunk.x;
+    const uint input_end = chunk.x + chunk.y;
+
+    const uint output_begin = chunk_index * u_push.chunk_size;
+    const uint output_end = min(output_begin + u_push.chunk_size, u_push.decompressed_size);
+
+    pending_word = 0;
+    output_offset = output_begin;
+
+    // Sequences of [token, literal length..., literals, match offset, match length...]
+    // Bounds are checked so malformed blobs can't run past their chunk
+    while (input_offset < input_end)
+    {
+        const uint token = read_compressed(input_offset++);
+
+        uint literal_length = token >> 4;
+        if (literal_length == 15)
+        {
+            uint value = 255;
+            while (value == 255 && input_offset < input_end)
+            {
+                value = read_compressed(input_offset++);
+                literal_length += value;
+            }
+        }
+
+        for (uint i = 0; i < literal_length && output_offset < output_end; ++i)
+            write_decompressed(read_compressed(input_offset++));
+
+        // The last sequence only has literals
+        if (input_offset + 2 > input_end)
+            break;
+
+        const uint match_offset = read_compressed(input_offset)
+                                  | (read_compressed(input_offset + 1) << 8);
+        input_offset += 2;
+
+        if (match_offset == 0 || match_offset > output_offset - output_begin)
+            break;
+
+        uint match_length = token & 15;
+        if (match_length == 15)
+        {
+            uint value = 255;
+            while (value == 255 && input_offset < input_end)
+            {
+                value = read_compressed(input_offset++);
+                match_length += value;
+            }
+        }
+
+        // Overlapping matches repeat the bytes they've just written, so copy byte by byte
+        match_length += 4;
+        for (uint i = 0; i < match_length && output_offset < output_end; ++i)
+            write_decompressed(read_decompressed(output_offset - match_offset));
+    }
+
+    if ((output_offset & 3) != 0)
+        ssbo_decompressed.arr[output_offset >> 2] = pending_word;
+}
@@ -16,6 +16,7 @@ layout(location = 0) out vec4 out_color;
 
 vec3 calc_directional_light(DirectionalLight light, vec3 albedo, vec3 normal, vec3 view_dir, int albedo_index);
 vec3 calc_point_light(PointLight light, vec3 albedo, vec3 normal, vec3 view_dir, int albedo_index);
+void write_texture_feedback(int texture_index, bool is_feedback_fragment);
 
 void main()
 {
@@ -24,14 +25,22 @@ void main()
     int albedo_index = primitive.albedo_index;
     int normal_index = primitive.normal_index;
 
-    vec3 normal = normalize(texture(s_textures[normal_index], in_uv).rgb * 2.0 - 1.0);
+    // one fragment per 8x8 tile writes feedback, plenty for residency and keeps the atomics cheap
+    bool is_feedback_fragment = ((uint(gl_FragCoord.x) | uint(gl_FragCoord.y)) & 7u) == 0u;
+    write_texture_feedback(albedo_index, is_feedback_fragment);
+    write_texture_feedback(normal_index, is_feedback_fragment);
+
+    // Only xy is read so two-channel (BC5) normal maps work, z is reconstructed
+    vec2 normal_xy = texture(s_textures[normal_index], in_uv).rg * 2.0 - 1.0;
+    vec3 normal = normalize(vec3(normal_xy, sqrt(max(1.0 - dot(normal_xy, normal_xy), 0.0))));
     vec3 albedo = texture(s_textures[albedo_index], in_uv).rgb;
 
     vec3 view_dir = normalize(in_tangent_view_position - in_tangent_fragment_position);
 
     vec3 result = calc_directional_light(u_frame.scene.directional_light, albedo, normal, view_dir, albedo_index);
 
-    for(uint i = 0; i < u_frame.scene.point_light_count; ++i)
+    const uint point_light_count = min(u_frame.scene.point_light_count, max_point_light_count);
+    for(uint i = 0; i < point_light_count; ++i)
         result += calc_point_light(u_frame.scene.point_lights[i], albedo, normal, view_dir, albedo_index);
 
     out_color = vec4(result , 1.0);
@@ -68,3 +77,16 @@ vec3 calc_point_light(PointLight light, vec3 albedo, vec3 normal, vec3 view_dir,
 
     return ambient + diffuse;
 }
+
+void write_texture_feedback(int texture_index, bool is_feedback_fragment)
+{
+    // queried outside of the branch, derivatives are undefined in non-uniform control flow
+    float lod = textureQueryLod(s_textures[texture_index], in_uv).y;
+    float width_log2 = log2(float(textureSize(s_textures[texture_index], 0).x));
+
+    // the resident image may lack the finest mips, so the needed width is what gets reported
+    uint needed_width_log2 = uint(clamp(round(width_log2 - lod), 0.0, 30.0));
+
+    if (is_feedback_fragment && texture_index != -1)
+        atomicMax(ssbo_texture_feedback.arr[texture_index], needed_width_log2 + 1u);
+}
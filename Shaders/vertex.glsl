@@ -3,6 +3,9 @@
 
 #include "global_descriptors.glsl"
 
+// constant_id = 2 -> normals & tangents are octahedral encoded, they come in as (x, y, 0)
+layout(constant_id = 2) const bool octahedral_directions = false;
+
 layout(location = 0) in vec3 in_position;
 layout(location = 1) in vec3 in_normal;
 layout(location = 2) in vec3 in_tangent;
@@ -15,6 +18,19 @@ layout(location = 3) out vec3 out_tangent_view_position;
 layout(location = 4) out vec3 out_tangent_fragment_position;
 layout(location = 5) out flat int out_instance_index;
 
+vec3 decode_direction(vec3 direction)
+{
+    if (!octahedral_directions)
+        return direction;
+
+    // unfolds the lower half of the octahedron from its corners
+    vec3 v = vec3(direction.xy, 1.0 - abs(direction.x) - abs(direction.y));
+    float t = max(-v.z, 0.0);
+    v.xy += vec2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+
+    return normalize(v);
+}
+
 void main() 
 {
     const Camera camera = u_frame.camera;
@@ -24,12 +40,14 @@ void main()
     Primitive primitive = ssbo_primitives.arr[gl_InstanceIndex];
     mat4 model = primitive.model;
 
-    out_fragment_position = vec3(model * vec4(in_position, 1.0));
+    vec3 position = primitive.position_offset.xyz + in_position * primitive.position_scale.xyz;
+
+    out_fragment_position = vec3(model * vec4(position, 1.0));
     out_uv = in_uv;
 
     mat3 normal_matrix = transpose(inverse(mat3(model)));
-    vec3 T = normalize(normal_matrix * in_tangent);
-    vec3 N = normalize(normal_matrix * in_normal);
+    vec3 T = normalize(normal_matrix * decode_direction(in_tangent));
+    vec3 N = normalize(normal_matrix * decode_direction(in_normal));
     T = normalize(T - dot(T, N) * N);
     vec3 B = cross(N, T);
     mat3 TBN = transpose(mat3(T, B, N));    
@@ -40,7 +58,7 @@ void main()
 
     out_instance_index = gl_InstanceIndex;
 
-    gl_Position = camera.proj * camera.view * model * vec4(in_position, 1.0);
+    gl_Position = camera.proj * camera.view * model * vec4(position, 1.0);
 }
 
 
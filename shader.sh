@@ -5,3 +5,11 @@ glslc --target-env=vulkan1.2 ./Shaders/skybox_vertex.glsl   -o ./Shaders/skybox_
 glslc --target-env=vulkan1.2 ./Shaders/skybox_fragment.glsl -o ./Shaders/skybox_fragment.spv
 
 glslc --target-env=vulkan1.2 ./Shaders/cull.glsl -o ./Shaders/cull.spv
+glslc --target-env=vulkan1.2 ./Shaders/lz4_decompress.glsl -o ./Shaders/lz4_decompress.spv
+
+# pack the compiled modules along with their reflection, see ShaderPacker/
+# the runtime trusts the pack, so one that can't be rebuilt is removed rather than left stale
+if [ ! -x ./build/ShaderPacker/ShaderPacker ] \
+    || ! ./build/ShaderPacker/ShaderPacker ./Shaders ./Shaders/shaders.bvsp; then
+    rm -f ./Shaders/shaders.bvsp
+fi